@@ -483,6 +483,65 @@ struct Type<nu::TextAttributes> {
   }
 };
 
+template<>
+struct Type<nu::Animation::Easing> {
+  static constexpr const char* name = "AnimationEasing";
+  static inline void Push(State* state, nu::Animation::Easing easing) {
+    switch (easing) {
+      case nu::Animation::Easing::Linear:
+        return lua::Push(state, "linear");
+      case nu::Animation::Easing::EaseIn:
+        return lua::Push(state, "ease-in");
+      case nu::Animation::Easing::EaseOut:
+        return lua::Push(state, "ease-out");
+      case nu::Animation::Easing::EaseInOut:
+        return lua::Push(state, "ease-in-out");
+    }
+    NOTREACHED();
+    return lua::Push(state, nullptr);
+  }
+  static inline bool To(State* state, int index,
+                        nu::Animation::Easing* out) {
+    std::string easing;
+    if (!lua::To(state, index, &easing))
+      return false;
+    if (easing == "linear") {
+      *out = nu::Animation::Easing::Linear;
+      return true;
+    } else if (easing == "ease-in") {
+      *out = nu::Animation::Easing::EaseIn;
+      return true;
+    } else if (easing == "ease-out") {
+      *out = nu::Animation::Easing::EaseOut;
+      return true;
+    } else if (easing == "ease-in-out") {
+      *out = nu::Animation::Easing::EaseInOut;
+      return true;
+    } else {
+      return false;
+    }
+  }
+};
+
+template<>
+struct Type<nu::Animation> {
+  static constexpr const char* name = "Animation";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "create", &CreateOnHeap<nu::Animation, nu::View*, int>,
+           "animatestyle", &nu::Animation::AnimateStyle,
+           "animatecolor", &nu::Animation::AnimateColor,
+           "seteasing", &nu::Animation::SetEasing,
+           "geteasing", &nu::Animation::GetEasing,
+           "start", &nu::Animation::Start,
+           "stop", &nu::Animation::Stop,
+           "isrunning", &nu::Animation::IsRunning,
+           "getview", &nu::Animation::GetView,
+           "getduration", &nu::Animation::GetDuration);
+    RawSetProperty(state, metatable, "onfinish", &nu::Animation::on_finish);
+  }
+};
+
 #if defined(OS_MAC)
 template<>
 struct Type<nu::App::ActivationPolicy> {
@@ -521,6 +580,20 @@ struct Type<nu::App::ActivationPolicy> {
 };
 #endif
 
+template<>
+struct Type<nu::App::FrameTimings> {
+  static constexpr const char* name = "AppFrameTimings";
+  static inline void Push(State* state, const nu::App::FrameTimings& value) {
+    lua::NewTable(state);
+    lua::RawSet(state, -1,
+                "count", value.count,
+                "average", value.average,
+                "max", value.max,
+                "buckets", value.buckets,
+                "histogram", value.histogram);
+  }
+};
+
 #if defined(OS_WIN)
 template<>
 struct Type<nu::App::ShortcutOptions> {
@@ -547,7 +620,11 @@ struct Type<nu::App> {
 #if defined(OS_LINUX) || defined(OS_WIN)
            "setid", &nu::App::SetID,
 #endif
-           "getid", &nu::App::GetID);
+           "getid", &nu::App::GetID,
+           "starttracing", &nu::App::StartTracing,
+           "stoptracing", &nu::App::StopTracing,
+           "istracing", &nu::App::IsTracing,
+           "getframetimings", &nu::App::GetFrameTimings);
 #if defined(OS_MAC)
     RawSet(state, metatable,
            "setapplicationmenu",
@@ -660,6 +737,7 @@ struct Type<nu::Browser> {
 #endif
            "executejavascript", &nu::Browser::ExecuteJavaScript,
            "getcookiesforurl", &nu::Browser::GetCookiesForURL,
+           "postmessagetopage", &nu::Browser::PostMessageToPage,
            "goback", &nu::Browser::GoBack,
            "cangoback", &nu::Browser::CanGoBack,
            "goforward", &nu::Browser::GoForward,
@@ -670,6 +748,7 @@ struct Type<nu::Browser> {
            "setbindingname", &nu::Browser::SetBindingName,
            "addbinding", &AddBinding,
            "addrawbinding", &nu::Browser::AddRawBinding,
+           "addasyncbinding", &AddAsyncBinding,
            "removebinding", &nu::Browser::RemoveBinding,
            "beginaddingbindings", &nu::Browser::BeginAddingBindings,
            "endaddingbindings", &nu::Browser::EndAddingBindings);
@@ -702,6 +781,28 @@ struct Type<nu::Browser> {
       lua_pcall(state, static_cast<int>(value.GetList().size()), 0, 0);
     });
   }
+  static void AddAsyncBinding(CallContext* context,
+                              nu::Browser* browser,
+                              const std::string& bname) {
+    State* state = context->state;
+    if (GetType(state, 3) != LuaType::Function) {
+      Push(state, "The arg 3 should be function");
+      context->has_error = true;
+      return;
+    }
+    auto ref = std::make_shared<Persistent>(state, 3);
+    // Like AddBinding, but the reply is passed as the first argument.
+    browser->AddRawAsyncBinding(bname, [state, ref](
+        nu::Browser* browser,
+        ::base::Value value,
+        nu::Browser::BindingReply reply) {
+      ref->Push();
+      Push(state, std::move(reply));
+      for (const auto& it : value.GetList())
+        Push(state, it);
+      lua_pcall(state, static_cast<int>(value.GetList().size()) + 1, 0, 0);
+    });
+  }
 };
 
 #if defined(OS_MAC)
@@ -1940,7 +2041,23 @@ struct Type<nu::MessageLoop> {
            "quit", &nu::MessageLoop::Quit,
            "posttask", &nu::MessageLoop::PostTask,
            "postdelayedtask", &nu::MessageLoop::PostDelayedTask,
-           "settimer", &nu::MessageLoop::SetTimer);
+           "settimer", &nu::MessageLoop::SetTimer,
+           "settimerwithtolerance", &nu::MessageLoop::SetTimerWithTolerance);
+  }
+};
+
+template<>
+struct Type<nu::ThreadPool> {
+  static constexpr const char* name = "ThreadPool";
+  static void BuildMetaTable(State* state, int index) {
+    RawSet(state, index,
+           "getsize", &GetSize,
+           "readfile", &nu::ThreadPool::ReadFile,
+           "decodeimage", &nu::ThreadPool::DecodeImage,
+           "sha1", &nu::ThreadPool::SHA1);
+  }
+  static int GetSize() {
+    return nu::ThreadPool::GetDefault()->GetSize();
   }
 };
 
@@ -2162,6 +2279,18 @@ struct Type<nu::ProtocolFileJob> {
   }
 };
 
+template<>
+struct Type<nu::ProtocolMappedJob> {
+  using Base = nu::ProtocolJob;
+  static constexpr const char* name = "ProtocolMappedJob";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "create", &CreateOnHeap<nu::ProtocolMappedJob,
+                                   const ::base::FilePath&,
+                                   const std::string&>);
+  }
+};
+
 template<>
 struct Type<nu::ProtocolStringJob> {
   using Base = nu::ProtocolJob;
@@ -2174,6 +2303,33 @@ struct Type<nu::ProtocolStringJob> {
   }
 };
 
+template<>
+struct Type<nu::Responder::EventCoalescing> {
+  static constexpr const char* name = "ResponderEventCoalescing";
+  static inline void Push(State* state,
+                          nu::Responder::EventCoalescing coalescing) {
+    if (coalescing == nu::Responder::EventCoalescing::Frame)
+      lua::Push(state, "frame");
+    else
+      lua::Push(state, "none");
+  }
+  static inline bool To(State* state, int index,
+                        nu::Responder::EventCoalescing* out) {
+    std::string coalescing;
+    if (!lua::To(state, index, &coalescing))
+      return false;
+    if (coalescing == "none") {
+      *out = nu::Responder::EventCoalescing::None;
+      return true;
+    } else if (coalescing == "frame") {
+      *out = nu::Responder::EventCoalescing::Frame;
+      return true;
+    } else {
+      return false;
+    }
+  }
+};
+
 template<>
 struct Type<nu::Responder> {
   static constexpr const char* name = "Responder";
@@ -2181,7 +2337,12 @@ struct Type<nu::Responder> {
     RawSet(state, metatable,
            "setcapture", &nu::Responder::SetCapture,
            "releasecapture", &nu::Responder::ReleaseCapture,
-           "hascapture", &nu::Responder::HasCapture);
+           "hascapture", &nu::Responder::HasCapture,
+           "seteventcoalescing", &nu::Responder::SetEventCoalescing,
+           "geteventcoalescing", &nu::Responder::GetEventCoalescing,
+           "setkeepcoalescedevents", &nu::Responder::SetKeepCoalescedEvents,
+           "iskeepcoalescedevents", &nu::Responder::IsKeepCoalescedEvents,
+           "getcoalescedevents", &nu::Responder::GetCoalescedEvents);
 #if defined(OS_LINUX) || defined(OS_MAC)
     RawSet(state, metatable, "getnative", &nu::Responder::GetNative);
 #endif
@@ -2376,7 +2537,11 @@ struct Type<nu::TableModel> {
            "getvalue", &GetValue,
            "notifyrowinsertion", &NotifyRowInsertion,
            "notifyrowdeletion", &NotifyRowDeletion,
-           "notifyvaluechange", &NotifyValueChange);
+           "notifyvaluechange", &NotifyValueChange,
+           "notifyrowsinserted", &NotifyRowsInserted,
+           "notifyrowsdeleted", &NotifyRowsDeleted,
+           "notifyrowschanged", &NotifyRowsChanged,
+           "notifyreset", &nu::TableModel::NotifyReset);
   }
   static void SetValue(nu::TableModel* model,
                        uint32_t column,
@@ -2398,6 +2563,18 @@ struct Type<nu::TableModel> {
                               uint32_t module, uint32_t row) {
     model->NotifyValueChange(module - 1, row - 1);
   }
+  static void NotifyRowsInserted(nu::TableModel* model,
+                                 uint32_t start, uint32_t count) {
+    model->NotifyRowsInserted(start - 1, count);
+  }
+  static void NotifyRowsDeleted(nu::TableModel* model,
+                                uint32_t start, uint32_t count) {
+    model->NotifyRowsDeleted(start - 1, count);
+  }
+  static void NotifyRowsChanged(nu::TableModel* model,
+                                uint32_t start, uint32_t count) {
+    model->NotifyRowsChanged(start - 1, count);
+  }
 };
 
 template<>
@@ -2424,11 +2601,199 @@ struct Type<nu::SimpleTableModel> {
     RawSet(state, metatable,
            "create", &CreateOnHeap<nu::SimpleTableModel, uint32_t>,
            "addrow", &nu::SimpleTableModel::AddRow,
-           "removerowat", &RemoveRowAt);
+           "removerowat", &RemoveRowAt,
+           "addrows", &nu::SimpleTableModel::AddRows,
+           "removerows", &RemoveRows,
+           "clear", &nu::SimpleTableModel::Clear);
   }
   static void RemoveRowAt(nu::SimpleTableModel* model, uint32_t row) {
     model->RemoveRowAt(row - 1);
   }
+  static void RemoveRows(nu::SimpleTableModel* model,
+                         uint32_t start, uint32_t count) {
+    model->RemoveRows(start - 1, count);
+  }
+};
+
+template<>
+struct Type<nu::ColumnarTableModel::ColumnType> {
+  static constexpr const char* name = "ColumnarTableModelColumnType";
+  static inline bool To(State* state, int index,
+                        nu::ColumnarTableModel::ColumnType* out) {
+    std::string type;
+    if (!lua::To(state, index, &type))
+      return false;
+    if (type == "bool") {
+      *out = nu::ColumnarTableModel::ColumnType::Bool;
+      return true;
+    } else if (type == "integer") {
+      *out = nu::ColumnarTableModel::ColumnType::Integer;
+      return true;
+    } else if (type == "double") {
+      *out = nu::ColumnarTableModel::ColumnType::Double;
+      return true;
+    } else if (type == "string") {
+      *out = nu::ColumnarTableModel::ColumnType::String;
+      return true;
+    } else {
+      return false;
+    }
+  }
+};
+
+template<>
+struct Type<nu::ColumnarTableModel> {
+  using Base = nu::TableModel;
+  static constexpr const char* name = "ColumnarTableModel";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "create", &Create,
+           "reserve", &nu::ColumnarTableModel::Reserve,
+           "addrow", &nu::ColumnarTableModel::AddRow,
+           "removerowat", &RemoveRowAt,
+           "addrows", &nu::ColumnarTableModel::AddRows,
+           "removerows", &RemoveRows,
+           "clear", &nu::ColumnarTableModel::Clear);
+  }
+  static nu::ColumnarTableModel* Create(
+      std::vector<nu::ColumnarTableModel::ColumnType> types) {
+    return new nu::ColumnarTableModel(std::move(types));
+  }
+  static void RemoveRowAt(nu::ColumnarTableModel* model, uint32_t row) {
+    model->RemoveRowAt(row - 1);
+  }
+  static void RemoveRows(nu::ColumnarTableModel* model,
+                         uint32_t start, uint32_t count) {
+    model->RemoveRows(start - 1, count);
+  }
+};
+
+template<>
+struct Type<nu::PagedTableModel> {
+  using Base = nu::TableModel;
+  static constexpr const char* name = "PagedTableModel";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "create", &Create,
+           "setrowcount", &nu::PagedTableModel::SetRowCount,
+           "setrows", &SetRows,
+           "isrowloaded", &IsRowLoaded,
+           "prefetch", &Prefetch,
+           "invalidaterows", &InvalidateRows,
+           "invalidateall", &nu::PagedTableModel::InvalidateAll,
+           "setplaceholder", &nu::PagedTableModel::SetPlaceholder,
+           "getplaceholder", &nu::PagedTableModel::GetPlaceholder,
+           "setprefetchblocks", &nu::PagedTableModel::SetPrefetchBlocks,
+           "getprefetchblocks", &nu::PagedTableModel::GetPrefetchBlocks,
+           "getblocksize", &nu::PagedTableModel::GetBlockSize);
+    RawSetProperty(state, metatable,
+                   "getrows", &nu::PagedTableModel::get_rows,
+                   "setvalue", &nu::PagedTableModel::set_value);
+  }
+  static nu::PagedTableModel* Create(uint32_t block_size,
+                                     uint32_t max_cached_blocks) {
+    return new nu::PagedTableModel(block_size, max_cached_blocks,
+                                   false /* index_starts_from_0 */);
+  }
+  static void SetRows(nu::PagedTableModel* model, uint32_t start,
+                      std::vector<nu::PagedTableModel::Row> rows) {
+    model->SetRows(start - 1, std::move(rows));
+  }
+  static bool IsRowLoaded(nu::PagedTableModel* model, uint32_t row) {
+    return model->IsRowLoaded(row - 1);
+  }
+  static void Prefetch(nu::PagedTableModel* model,
+                       uint32_t start, uint32_t count) {
+    model->Prefetch(start - 1, count);
+  }
+  static void InvalidateRows(nu::PagedTableModel* model,
+                             uint32_t start, uint32_t count) {
+    model->InvalidateRows(start - 1, count);
+  }
+};
+
+template<>
+struct Type<nu::SortFilterTableModel::SortKey> {
+  static constexpr const char* name = "SortFilterTableModelSortKey";
+  static inline bool To(State* state, int index,
+                        nu::SortFilterTableModel::SortKey* out) {
+    if (GetType(state, index) != LuaType::Table)
+      return false;
+    uint32_t column;
+    if (!RawGetAndPop(state, index, "column", &column) || column == 0)
+      return false;
+    out->column = column - 1;
+    return ReadOptions(state, index, "ascending", &out->ascending);
+  }
+};
+
+template<>
+struct Type<nu::SortFilterTableModel::Filter::Type> {
+  static constexpr const char* name = "SortFilterTableModelFilterType";
+  static inline bool To(State* state, int index,
+                        nu::SortFilterTableModel::Filter::Type* out) {
+    std::string type;
+    if (!lua::To(state, index, &type))
+      return false;
+    if (type == "equals") {
+      *out = nu::SortFilterTableModel::Filter::Type::Equals;
+      return true;
+    } else if (type == "contains") {
+      *out = nu::SortFilterTableModel::Filter::Type::Contains;
+      return true;
+    } else if (type == "range") {
+      *out = nu::SortFilterTableModel::Filter::Type::Range;
+      return true;
+    } else {
+      return false;
+    }
+  }
+};
+
+template<>
+struct Type<nu::SortFilterTableModel::Filter> {
+  static constexpr const char* name = "SortFilterTableModelFilter";
+  static inline bool To(State* state, int index,
+                        nu::SortFilterTableModel::Filter* out) {
+    if (GetType(state, index) != LuaType::Table)
+      return false;
+    uint32_t column;
+    if (!RawGetAndPop(state, index, "column", &column) || column == 0)
+      return false;
+    out->column = column - 1;
+    return ReadOptions(state, index,
+                       "type", &out->type,
+                       "value", &out->value,
+                       "min", &out->min,
+                       "max", &out->max,
+                       "ignorecase", &out->ignore_case);
+  }
+};
+
+template<>
+struct Type<nu::SortFilterTableModel> {
+  using Base = nu::TableModel;
+  static constexpr const char* name = "SortFilterTableModel";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "create", &CreateOnHeap<nu::SortFilterTableModel,
+                                   scoped_refptr<nu::TableModel>>,
+           "getsource", &nu::SortFilterTableModel::GetSource,
+           "setsortkeys", &nu::SortFilterTableModel::SetSortKeys,
+           "setfilters", &nu::SortFilterTableModel::SetFilters,
+           "addfilter", &nu::SortFilterTableModel::AddFilter,
+           "clearfilters", &nu::SortFilterTableModel::ClearFilters,
+           "maptosource", &MapToSource,
+           "mapfromsource", &MapFromSource);
+  }
+  static int MapToSource(nu::SortFilterTableModel* model, uint32_t row) {
+    int index = model->MapToSource(row - 1);
+    return index == -1 ? -1 : index + 1;
+  }
+  static int MapFromSource(nu::SortFilterTableModel* model, uint32_t row) {
+    int index = model->MapFromSource(row - 1);
+    return index == -1 ? -1 : index + 1;
+  }
 };
 
 template<>
@@ -2469,7 +2834,8 @@ struct Type<nu::Table::ColumnOptions> {
     return ReadOptions(state, index,
                        "type", &out->type,
                        "ondraw", &out->on_draw,
-                       "width", &out->width);
+                       "width", &out->width,
+                       "cachesize", &out->cache_size);
   }
 };
 
@@ -2784,6 +3150,21 @@ struct Type<nu::Vibrant> {
 };
 #endif
 
+template<>
+struct Type<nu::View::PerfCounters> {
+  static constexpr const char* name = "ViewPerfCounters";
+  static inline void Push(State* state,
+                          const nu::View::PerfCounters& counters) {
+    lua::NewTable(state);
+    lua::RawSet(state, -1,
+                "layoutcount", counters.layout_count,
+                "measurecount", counters.measure_count,
+                "setboundscount", counters.set_bounds_count,
+                "paintcount", counters.paint_count,
+                "painttime", counters.paint_time);
+  }
+};
+
 template<>
 struct Type<nu::View> {
   using Base = nu::Responder;
@@ -2823,6 +3204,11 @@ struct Type<nu::View> {
            "setbackgroundcolor", &nu::View::SetBackgroundColor,
            "setstyle", &SetStyle,
            "getcomputedlayout", &nu::View::GetComputedLayout,
+           "setperfcountersenabled", &nu::View::SetPerfCountersEnabled,
+           "isperfcountersenabled", &nu::View::IsPerfCountersEnabled,
+           "getperfcounters", &nu::View::GetPerfCounters,
+           "resetperfcounters", &nu::View::ResetPerfCounters,
+           "dumpperfcounters", &nu::View::DumpPerfCounters,
            "getminimumsize", &nu::View::GetMinimumSize,
 #if defined(OS_MAC)
            "setwantslayer", &nu::View::SetWantsLayer,
@@ -2970,6 +3356,7 @@ extern "C" int luaopen_yue_gui(lua::State* state) {
   lua_rawset(state, -3);
 
   // Classes.
+  BindType<nu::Animation>(state, "Animation");
   BindType<nu::App>(state, "App");
   BindType<nu::Appearance>(state, "Appearance");
   BindType<nu::AttributedText>(state, "AttributedText");
@@ -3008,6 +3395,7 @@ extern "C" int luaopen_yue_gui(lua::State* state) {
   BindType<nu::ProgressBar>(state, "ProgressBar");
   BindType<nu::ProtocolAsarJob>(state, "ProtocolAsarJob");
   BindType<nu::ProtocolFileJob>(state, "ProtocolFileJob");
+  BindType<nu::ProtocolMappedJob>(state, "ProtocolMappedJob");
   BindType<nu::ProtocolStringJob>(state, "ProtocolStringJob");
   BindType<nu::Responder>(state, "Responder");
   BindType<nu::Screen>(state, "Screen");
@@ -3018,8 +3406,12 @@ extern "C" int luaopen_yue_gui(lua::State* state) {
   BindType<nu::TableModel>(state, "TableModel");
   BindType<nu::AbstractTableModel>(state, "AbstractTableModel");
   BindType<nu::SimpleTableModel>(state, "SimpleTableModel");
+  BindType<nu::ColumnarTableModel>(state, "ColumnarTableModel");
+  BindType<nu::PagedTableModel>(state, "PagedTableModel");
+  BindType<nu::SortFilterTableModel>(state, "SortFilterTableModel");
   BindType<nu::Table>(state, "Table");
   BindType<nu::TextEdit>(state, "TextEdit");
+  BindType<nu::ThreadPool>(state, "ThreadPool");
 #if defined(OS_MAC)
   BindType<nu::Toolbar>(state, "Toolbar");
 #endif
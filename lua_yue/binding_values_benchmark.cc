@@ -0,0 +1,60 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <string>
+#include <utility>
+
+#include "lua_yue/binding_values.h"
+#include "nativeui/test/benchmark.h"
+
+namespace {
+
+// A dictionary with |size| entries of mixed types.
+base::Value CreateValue(int64_t size) {
+  base::Value::Dict dict;
+  for (int64_t i = 0; i < size; ++i) {
+    std::string key = "key" + std::to_string(i);
+    switch (i % 4) {
+      case 0:
+        dict.Set(key, static_cast<int>(i));
+        break;
+      case 1:
+        dict.Set(key, "string value");
+        break;
+      case 2:
+        dict.Set(key, i % 3 == 0);
+        break;
+      case 3: {
+        base::Value::List list;
+        list.Append(1.5);
+        list.Append("item");
+        dict.Set(key, std::move(list));
+        break;
+      }
+    }
+  }
+  return base::Value(std::move(dict));
+}
+
+void BM_LuaPushValue(nu::BenchmarkState* state) {
+  lua::ManagedState lua_state;
+  base::Value value = CreateValue(state->range(0));
+  while (state->KeepRunning()) {
+    lua::Push(lua_state, value);
+    lua::SetTop(lua_state, 0);
+  }
+}
+NU_BENCHMARK(BM_LuaPushValue)->Arg(10)->Arg(1000);
+
+void BM_LuaToValue(nu::BenchmarkState* state) {
+  lua::ManagedState lua_state;
+  lua::Push(lua_state, CreateValue(state->range(0)));
+  while (state->KeepRunning()) {
+    base::Value out;
+    lua::To(lua_state, 1, &out);
+  }
+}
+NU_BENCHMARK(BM_LuaToValue)->Arg(10)->Arg(1000);
+
+}  // namespace
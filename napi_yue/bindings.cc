@@ -588,6 +588,69 @@ struct Type<nu::TextAttributes> {
   }
 };
 
+template<>
+struct Type<nu::Animation::Easing> {
+  static constexpr const char* name = "AnimationEasing";
+  static napi_status ToNode(napi_env env,
+                            nu::Animation::Easing easing,
+                            napi_value* result) {
+    switch (easing) {
+      case nu::Animation::Easing::Linear:
+        return ConvertToNode(env, "linear", result);
+      case nu::Animation::Easing::EaseIn:
+        return ConvertToNode(env, "ease-in", result);
+      case nu::Animation::Easing::EaseOut:
+        return ConvertToNode(env, "ease-out", result);
+      case nu::Animation::Easing::EaseInOut:
+        return ConvertToNode(env, "ease-in-out", result);
+    }
+    NOTREACHED();
+    return napi_generic_failure;
+  }
+  static napi_status FromNode(napi_env env,
+                              napi_value value,
+                              nu::Animation::Easing* out) {
+    std::string easing;
+    napi_status s = ConvertFromNode(env, value, &easing);
+    if (s == napi_ok) {
+      if (easing == "linear")
+        *out = nu::Animation::Easing::Linear;
+      else if (easing == "ease-in")
+        *out = nu::Animation::Easing::EaseIn;
+      else if (easing == "ease-out")
+        *out = nu::Animation::Easing::EaseOut;
+      else if (easing == "ease-in-out")
+        *out = nu::Animation::Easing::EaseInOut;
+      else
+        return napi_invalid_arg;
+    }
+    return s;
+  }
+};
+
+template<>
+struct Type<nu::Animation> {
+  static constexpr const char* name = "Animation";
+  static void Define(napi_env env,
+                     napi_value constructor,
+                     napi_value prototype) {
+    Set(env, constructor,
+        "create", &CreateOnHeap<nu::Animation, nu::View*, int>);
+    Set(env, prototype,
+        "animateStyle", &nu::Animation::AnimateStyle,
+        "animateColor", &nu::Animation::AnimateColor,
+        "setEasing", &nu::Animation::SetEasing,
+        "getEasing", &nu::Animation::GetEasing,
+        "start", &nu::Animation::Start,
+        "stop", &nu::Animation::Stop,
+        "isRunning", &nu::Animation::IsRunning,
+        "getView", &nu::Animation::GetView,
+        "getDuration", &nu::Animation::GetDuration);
+    DefineProperties(env, prototype,
+                     Signal("onFinish", &nu::Animation::on_finish));
+  }
+};
+
 #if defined(OS_MAC)
 template<>
 struct Type<nu::App::ActivationPolicy> {
@@ -626,6 +689,23 @@ struct Type<nu::App::ActivationPolicy> {
 };
 #endif
 
+template<>
+struct Type<nu::App::FrameTimings> {
+  static constexpr const char* name = "AppFrameTimings";
+  static napi_status ToNode(napi_env env,
+                            const nu::App::FrameTimings& value,
+                            napi_value* result) {
+    *result = CreateObject(env);
+    Set(env, *result,
+        "count", value.count,
+        "average", value.average,
+        "max", value.max,
+        "buckets", value.buckets,
+        "histogram", value.histogram);
+    return napi_ok;
+  }
+};
+
 #if defined(OS_WIN)
 template<>
 struct Type<nu::App::ShortcutOptions> {
@@ -655,7 +735,11 @@ struct Type<nu::App> {
 #if defined(OS_LINUX) || defined(OS_WIN)
         "setID", &nu::App::SetID,
 #endif
-        "getID", &nu::App::GetID);
+        "getID", &nu::App::GetID,
+        "startTracing", &nu::App::StartTracing,
+        "stopTracing", &nu::App::StopTracing,
+        "isTracing", &nu::App::IsTracing,
+        "getFrameTimings", &nu::App::GetFrameTimings);
 #if defined(OS_MAC)
     Set(env, prototype,
         "setApplicationMenu",
@@ -769,6 +853,7 @@ struct Type<nu::Browser> {
 #endif
         "executeJavaScript", &nu::Browser::ExecuteJavaScript,
         "getCookiesForURL", &nu::Browser::GetCookiesForURL,
+        "postMessageToPage", &nu::Browser::PostMessageToPage,
         "goBack", &nu::Browser::GoBack,
         "canGoBack", &nu::Browser::CanGoBack,
         "goForward", &nu::Browser::GoForward,
@@ -778,6 +863,7 @@ struct Type<nu::Browser> {
         "isLoading", &nu::Browser::IsLoading,
         "setBindingName", &nu::Browser::SetBindingName,
         "addBinding", &AddBinding,
+        "addAsyncBinding", &AddAsyncBinding,
         "addRawBinding",
         WrapMethod(&nu::Browser::AddRawBinding, [](Arguments args) {
           AttachedTable(args).GetOrCreateMap("bindings").Set(args[0], args[1]);
@@ -830,6 +916,37 @@ struct Type<nu::Browser> {
       }
     });
   }
+  static void AddAsyncBinding(Arguments args,
+                              const std::string& bname,
+                              napi_value func) {
+    nu::Browser* browser;
+    if (!args.GetThis(&browser))
+      return;
+    AttachedTable(args).GetOrCreateMap("bindings").Set(args[0], args[1]);
+    Persistent ref(args.Env(), func, 0);
+    // Like AddBinding, but the reply is passed as the first argument.
+    browser->AddRawAsyncBinding(bname, [ref = std::move(ref)](
+        nu::Browser* browser,
+        base::Value value,
+        nu::Browser::BindingReply reply) {
+      HandleScope handle_scope(ref.Env());
+      napi_value func = ref.Value();
+      if (!func)
+        return;
+      std::vector<napi_value> args;
+      args.reserve(value.GetList().size() + 1);
+      args.push_back(ToNode(ref.Env(), std::move(reply)));
+      for (const auto& it : value.GetList())
+        args.push_back(ToNode(ref.Env(), it));
+      napi_status s = napi_make_callback(
+          ref.Env(), nullptr, func, func, args.size(), &args.front(), nullptr);
+      if (s == napi_pending_exception) {
+        napi_value fatal_exception;
+        napi_get_and_clear_last_exception(ref.Env(), &fatal_exception);
+        napi_fatal_exception(ref.Env(), fatal_exception);
+      }
+    });
+  }
 };
 
 #if defined(OS_MAC)
@@ -2161,7 +2278,8 @@ struct Type<nu::MessageLoop> {
         "quit", &nu::MessageLoop::Quit,
         "postTask", &nu::MessageLoop::PostTask,
         "postDelayedTask", &nu::MessageLoop::PostDelayedTask,
-        "setTimer", &nu::MessageLoop::SetTimer);
+        "setTimer", &nu::MessageLoop::SetTimer,
+        "setTimerWithTolerance", &nu::MessageLoop::SetTimerWithTolerance);
     // The "run" method should never be used in yode runtime.
     if (!is_yode) {
       Set(env, constructor, "run", &nu::MessageLoop::Run);
@@ -2169,6 +2287,23 @@ struct Type<nu::MessageLoop> {
   }
 };
 
+template<>
+struct Type<nu::ThreadPool> {
+  static constexpr const char* name = "ThreadPool";
+  static void Define(napi_env env,
+                     napi_value constructor,
+                     napi_value prototype) {
+    Set(env, constructor,
+        "getSize", &GetSize,
+        "readFile", &nu::ThreadPool::ReadFile,
+        "decodeImage", &nu::ThreadPool::DecodeImage,
+        "sha1", &nu::ThreadPool::SHA1);
+  }
+  static int GetSize() {
+    return nu::ThreadPool::GetDefault()->GetSize();
+  }
+};
+
 template<>
 struct Type<nu::Notification::Action> {
   static constexpr const char* name = "NotificationAction";
@@ -2396,6 +2531,20 @@ struct Type<nu::ProtocolFileJob> {
   }
 };
 
+template<>
+struct Type<nu::ProtocolMappedJob> {
+  using Base = nu::ProtocolJob;
+  static constexpr const char* name = "ProtocolMappedJob";
+  static void Define(napi_env env,
+                     napi_value constructor,
+                     napi_value prototype) {
+    Set(env, constructor,
+        "create", &CreateOnHeap<nu::ProtocolMappedJob,
+                                const base::FilePath&,
+                                const std::string&>);
+  }
+};
+
 template<>
 struct Type<nu::ProtocolStringJob> {
   using Base = nu::ProtocolJob;
@@ -2410,6 +2559,33 @@ struct Type<nu::ProtocolStringJob> {
   }
 };
 
+template<>
+struct Type<nu::Responder::EventCoalescing> {
+  static constexpr const char* name = "ResponderEventCoalescing";
+  static napi_status ToNode(napi_env env,
+                            nu::Responder::EventCoalescing coalescing,
+                            napi_value* result) {
+    if (coalescing == nu::Responder::EventCoalescing::Frame)
+      return ConvertToNode(env, "frame", result);
+    return ConvertToNode(env, "none", result);
+  }
+  static napi_status FromNode(napi_env env,
+                              napi_value value,
+                              nu::Responder::EventCoalescing* out) {
+    std::string coalescing;
+    napi_status s = ConvertFromNode(env, value, &coalescing);
+    if (s == napi_ok) {
+      if (coalescing == "none")
+        *out = nu::Responder::EventCoalescing::None;
+      else if (coalescing == "frame")
+        *out = nu::Responder::EventCoalescing::Frame;
+      else
+        return napi_invalid_arg;
+    }
+    return s;
+  }
+};
+
 template<>
 struct Type<nu::Responder> {
   static constexpr const char* name = "Responder";
@@ -2419,7 +2595,12 @@ struct Type<nu::Responder> {
     Set(env, prototype,
         "setCapture", &nu::Responder::SetCapture,
         "releaseCapture", &nu::Responder::ReleaseCapture,
-        "hasCapture", &nu::Responder::HasCapture);
+        "hasCapture", &nu::Responder::HasCapture,
+        "setEventCoalescing", &nu::Responder::SetEventCoalescing,
+        "getEventCoalescing", &nu::Responder::GetEventCoalescing,
+        "setKeepCoalescedEvents", &nu::Responder::SetKeepCoalescedEvents,
+        "isKeepCoalescedEvents", &nu::Responder::IsKeepCoalescedEvents,
+        "getCoalescedEvents", &nu::Responder::GetCoalescedEvents);
 #if defined(OS_LINUX) || defined(OS_MAC)
     Set(env, prototype, "getNative", &nu::Responder::GetNative);
 #endif
@@ -2637,7 +2818,11 @@ struct Type<nu::TableModel> {
         "getValue", &nu::TableModel::GetValue,
         "notifyRowInsertion", &nu::TableModel::NotifyRowInsertion,
         "notifyRowDeletion", &nu::TableModel::NotifyRowDeletion,
-        "notifyValueChange", &nu::TableModel::NotifyValueChange);
+        "notifyValueChange", &nu::TableModel::NotifyValueChange,
+        "notifyRowsInserted", &nu::TableModel::NotifyRowsInserted,
+        "notifyRowsDeleted", &nu::TableModel::NotifyRowsDeleted,
+        "notifyRowsChanged", &nu::TableModel::NotifyRowsChanged,
+        "notifyReset", &nu::TableModel::NotifyReset);
   }
 };
 
@@ -2670,10 +2855,164 @@ struct Type<nu::SimpleTableModel> {
     Set(env, prototype,
         "addRow", &nu::SimpleTableModel::AddRow,
         "removeRowAt", &nu::SimpleTableModel::RemoveRowAt,
+        "addRows", &nu::SimpleTableModel::AddRows,
+        "removeRows", &nu::SimpleTableModel::RemoveRows,
+        "clear", &nu::SimpleTableModel::Clear,
         "setValue", &nu::SimpleTableModel::SetValue);
   }
 };
 
+template<>
+struct Type<nu::ColumnarTableModel::ColumnType> {
+  static constexpr const char* name = "ColumnarTableModelColumnType";
+  static napi_status FromNode(napi_env env,
+                              napi_value value,
+                              nu::ColumnarTableModel::ColumnType* out) {
+    std::string type;
+    napi_status s = ConvertFromNode(env, value, &type);
+    if (s == napi_ok) {
+      if (type == "bool")
+        *out = nu::ColumnarTableModel::ColumnType::Bool;
+      else if (type == "integer")
+        *out = nu::ColumnarTableModel::ColumnType::Integer;
+      else if (type == "double")
+        *out = nu::ColumnarTableModel::ColumnType::Double;
+      else if (type == "string")
+        *out = nu::ColumnarTableModel::ColumnType::String;
+      else
+        return napi_invalid_arg;
+    }
+    return s;
+  }
+};
+
+template<>
+struct Type<nu::ColumnarTableModel> {
+  using Base = nu::TableModel;
+  static constexpr const char* name = "ColumnarTableModel";
+  static void Define(napi_env env,
+                     napi_value constructor,
+                     napi_value prototype) {
+    Set(env, constructor,
+        "create", &Create);
+    Set(env, prototype,
+        "reserve", &nu::ColumnarTableModel::Reserve,
+        "addRow", &nu::ColumnarTableModel::AddRow,
+        "removeRowAt", &nu::ColumnarTableModel::RemoveRowAt,
+        "addRows", &nu::ColumnarTableModel::AddRows,
+        "removeRows", &nu::ColumnarTableModel::RemoveRows,
+        "clear", &nu::ColumnarTableModel::Clear,
+        "setValue", &nu::ColumnarTableModel::SetValue);
+  }
+  static nu::ColumnarTableModel* Create(
+      std::vector<nu::ColumnarTableModel::ColumnType> types) {
+    return new nu::ColumnarTableModel(std::move(types));
+  }
+};
+
+template<>
+struct Type<nu::PagedTableModel> {
+  using Base = nu::TableModel;
+  static constexpr const char* name = "PagedTableModel";
+  static void Define(napi_env env,
+                     napi_value constructor,
+                     napi_value prototype) {
+    Set(env, constructor,
+        "create", &CreateOnHeap<nu::PagedTableModel, uint32_t, uint32_t>);
+    Set(env, prototype,
+        "setRowCount", &nu::PagedTableModel::SetRowCount,
+        "setRows", &nu::PagedTableModel::SetRows,
+        "isRowLoaded", &nu::PagedTableModel::IsRowLoaded,
+        "prefetch", &nu::PagedTableModel::Prefetch,
+        "invalidateRows", &nu::PagedTableModel::InvalidateRows,
+        "invalidateAll", &nu::PagedTableModel::InvalidateAll,
+        "setPlaceholder", &nu::PagedTableModel::SetPlaceholder,
+        "getPlaceholder", &nu::PagedTableModel::GetPlaceholder,
+        "setPrefetchBlocks", &nu::PagedTableModel::SetPrefetchBlocks,
+        "getPrefetchBlocks", &nu::PagedTableModel::GetPrefetchBlocks,
+        "getBlockSize", &nu::PagedTableModel::GetBlockSize);
+    DefineProperties(
+        env, prototype,
+        Delegate("getRows", &nu::PagedTableModel::get_rows),
+        Delegate("setValue", &nu::PagedTableModel::set_value));
+  }
+};
+
+template<>
+struct Type<nu::SortFilterTableModel::SortKey> {
+  static constexpr const char* name = "SortFilterTableModelSortKey";
+  static napi_status FromNode(napi_env env,
+                              napi_value value,
+                              nu::SortFilterTableModel::SortKey* out) {
+    if (!ReadOptions(env, value,
+                     "column", &out->column,
+                     "ascending", &out->ascending))
+      return napi_invalid_arg;
+    return napi_ok;
+  }
+};
+
+template<>
+struct Type<nu::SortFilterTableModel::Filter::Type> {
+  static constexpr const char* name = "SortFilterTableModelFilterType";
+  static napi_status FromNode(napi_env env,
+                              napi_value value,
+                              nu::SortFilterTableModel::Filter::Type* out) {
+    std::string type;
+    napi_status s = ConvertFromNode(env, value, &type);
+    if (s == napi_ok) {
+      if (type == "equals")
+        *out = nu::SortFilterTableModel::Filter::Type::Equals;
+      else if (type == "contains")
+        *out = nu::SortFilterTableModel::Filter::Type::Contains;
+      else if (type == "range")
+        *out = nu::SortFilterTableModel::Filter::Type::Range;
+      else
+        return napi_invalid_arg;
+    }
+    return s;
+  }
+};
+
+template<>
+struct Type<nu::SortFilterTableModel::Filter> {
+  static constexpr const char* name = "SortFilterTableModelFilter";
+  static napi_status FromNode(napi_env env,
+                              napi_value value,
+                              nu::SortFilterTableModel::Filter* out) {
+    if (!ReadOptions(env, value,
+                     "type", &out->type,
+                     "column", &out->column,
+                     "value", &out->value,
+                     "min", &out->min,
+                     "max", &out->max,
+                     "ignoreCase", &out->ignore_case))
+      return napi_invalid_arg;
+    return napi_ok;
+  }
+};
+
+template<>
+struct Type<nu::SortFilterTableModel> {
+  using Base = nu::TableModel;
+  static constexpr const char* name = "SortFilterTableModel";
+  static void Define(napi_env env,
+                     napi_value constructor,
+                     napi_value prototype) {
+    Set(env, constructor,
+        "create", &CreateOnHeap<nu::SortFilterTableModel,
+                                scoped_refptr<nu::TableModel>>);
+    Set(env, prototype,
+        "getSource", &nu::SortFilterTableModel::GetSource,
+        "setSortKeys", &nu::SortFilterTableModel::SetSortKeys,
+        "setFilters", &nu::SortFilterTableModel::SetFilters,
+        "addFilter", &nu::SortFilterTableModel::AddFilter,
+        "clearFilters", &nu::SortFilterTableModel::ClearFilters,
+        "mapToSource", &nu::SortFilterTableModel::MapToSource,
+        "mapFromSource", &nu::SortFilterTableModel::MapFromSource);
+  }
+};
+
 template<>
 struct Type<nu::Table::ColumnType> {
   static constexpr const char* name = "TableColumnType";
@@ -2709,7 +3048,8 @@ struct Type<nu::Table::ColumnOptions> {
                      "onDraw", &on_draw_val,
                      "type", &out->type,
                      "column", &out->column,
-                     "width", &out->width))
+                     "width", &out->width,
+                     "cacheSize", &out->cache_size))
       return napi_invalid_arg;
     if (on_draw_val)
       ConvertWeakFunctionFromNode(env, on_draw_val, &out->on_draw);
@@ -3055,6 +3395,23 @@ struct Type<nu::Vibrant> {
 };
 #endif
 
+template<>
+struct Type<nu::View::PerfCounters> {
+  static constexpr const char* name = "ViewPerfCounters";
+  static napi_status ToNode(napi_env env,
+                            const nu::View::PerfCounters& counters,
+                            napi_value* result) {
+    *result = CreateObject(env);
+    Set(env, *result,
+        "layoutCount", counters.layout_count,
+        "measureCount", counters.measure_count,
+        "setBoundsCount", counters.set_bounds_count,
+        "paintCount", counters.paint_count,
+        "paintTime", counters.paint_time);
+    return napi_ok;
+  }
+};
+
 template<>
 struct Type<nu::View> {
   using Base = nu::Responder;
@@ -3062,6 +3419,9 @@ struct Type<nu::View> {
   static void Define(napi_env env,
                      napi_value constructor,
                      napi_value prototype) {
+    Set(env, constructor,
+        "setPerfCountersEnabled", &nu::View::SetPerfCountersEnabled,
+        "isPerfCountersEnabled", &nu::View::IsPerfCountersEnabled);
     Set(env, prototype,
         "offsetFromView", &nu::View::OffsetFromView,
         "offsetFromWindow", &nu::View::OffsetFromWindow,
@@ -3096,6 +3456,9 @@ struct Type<nu::View> {
         "setBackgroundColor", &nu::View::SetBackgroundColor,
         "setStyle", &SetStyle,
         "getComputedLayout", &nu::View::GetComputedLayout,
+        "getPerfCounters", &nu::View::GetPerfCounters,
+        "resetPerfCounters", &nu::View::ResetPerfCounters,
+        "dumpPerfCounters", &nu::View::DumpPerfCounters,
         "getMinimumSize", &nu::View::GetMinimumSize,
 #if defined(OS_MAC)
         "setWantsLayer", &nu::View::SetWantsLayer,
@@ -3314,6 +3677,7 @@ napi_value Initialize(napi_env env, napi_value exports) {
 
   ki::Set(env, exports,
           // Classes.
+          "Animation",          ki::Class<nu::Animation>(),
           "App",                ki::Class<nu::App>(),
           "Appearance",         ki::Class<nu::Appearance>(),
           "AttributedText",     ki::Class<nu::AttributedText>(),
@@ -3350,6 +3714,7 @@ napi_value Initialize(napi_env env, napi_value exports) {
           "ProgressBar",        ki::Class<nu::ProgressBar>(),
           "ProtocolAsarJob",    ki::Class<nu::ProtocolAsarJob>(),
           "ProtocolFileJob",    ki::Class<nu::ProtocolFileJob>(),
+          "ProtocolMappedJob",  ki::Class<nu::ProtocolMappedJob>(),
           "ProtocolStringJob",  ki::Class<nu::ProtocolStringJob>(),
           "Responder",          ki::Class<nu::Responder>(),
           "Screen",             ki::Class<nu::Screen>(),
@@ -3360,8 +3725,12 @@ napi_value Initialize(napi_env env, napi_value exports) {
           "TableModel",         ki::Class<nu::TableModel>(),
           "AbstractTableModel", ki::Class<nu::AbstractTableModel>(),
           "SimpleTableModel",   ki::Class<nu::SimpleTableModel>(),
+          "ColumnarTableModel", ki::Class<nu::ColumnarTableModel>(),
+          "PagedTableModel",    ki::Class<nu::PagedTableModel>(),
+          "SortFilterTableModel", ki::Class<nu::SortFilterTableModel>(),
           "Table",              ki::Class<nu::Table>(),
           "TextEdit",           ki::Class<nu::TextEdit>(),
+          "ThreadPool",         ki::Class<nu::ThreadPool>(),
 #if defined(OS_MAC)
           "Toolbar",            ki::Class<nu::Toolbar>(),
 #endif
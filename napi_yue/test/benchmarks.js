@@ -0,0 +1,66 @@
+// Measure the cost of converting values between JavaScript and C++.
+//
+// Usage: node napi_yue/test/benchmarks.js out/Release [result.json]
+
+const path = require('path')
+const fs = require('fs')
+
+const modulePath = path.resolve(__dirname, '..', '..', process.argv[2], 'gui.node')
+const gui = require(modulePath)
+
+const minTime = 0.5
+
+function run(name, func) {
+  let iterations = 1
+  while (true) {
+    const start = process.hrtime.bigint()
+    func(iterations)
+    const elapsed = Number(process.hrtime.bigint() - start)
+    if (elapsed >= minTime * 1e9 || iterations >= 1e9) {
+      const realTime = elapsed / iterations
+      console.log(`${name.padEnd(48)} ${realTime.toFixed(0).padStart(14)} ${String(iterations).padStart(12)}`)
+      return {name, run_name: name, run_type: 'iteration', iterations, real_time: realTime, cpu_time: realTime, time_unit: 'ns'}
+    }
+    const multiplier = Math.min(Math.max(minTime * 1.4e9 / elapsed, 2), 100)
+    iterations = Math.floor(iterations * multiplier)
+  }
+}
+
+const benchmarks = {
+  BM_JsTableModelAddRow(iterations) {
+    const model = gui.SimpleTableModel.create(3)
+    for (let i = 0; i < iterations; ++i)
+      model.addRow(['row', i, true])
+  },
+
+  BM_JsTableModelGetValue(iterations) {
+    const model = gui.SimpleTableModel.create(1)
+    model.addRow([{key: 'value', list: [1, 2, 3]}])
+    for (let i = 0; i < iterations; ++i)
+      model.getValue(0, 0)
+  },
+
+  BM_JsViewSetStyle(iterations) {
+    const view = gui.Container.create()
+    for (let i = 0; i < iterations; ++i)
+      view.setStyle({width: i % 100, height: 10, marginLeft: 5})
+  },
+
+  BM_JsSignalConnect(iterations) {
+    const view = gui.Container.create()
+    const callback = () => {}
+    for (let i = 0; i < iterations; ++i)
+      view.onSizeChanged.disconnect(view.onSizeChanged.connect(callback))
+  },
+}
+
+const results = []
+console.log(`${'Benchmark'.padEnd(48)} ${'Time(ns)'.padStart(14)} ${'Iterations'.padStart(12)}`)
+for (const name in benchmarks)
+  results.push(run(name, benchmarks[name]))
+
+if (process.argv[3]) {
+  const context = {executable: process.execPath, num_cpus: require('os').cpus().length}
+  fs.writeFileSync(process.argv[3], JSON.stringify({context, benchmarks: results}, null, 2))
+}
+process.exit(0)
@@ -0,0 +1,248 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/animator.h"
+
+#include <algorithm>
+#include <functional>
+#include <set>
+#include <utility>
+
+#include "base/auto_reset.h"
+#include "base/logging.h"
+#include "base/strings/string_util.h"
+#include "nativeui/state.h"
+#include "nativeui/view.h"
+
+namespace nu {
+
+namespace {
+
+// Used when the platform does not provide a frame clock.
+const int kFrameIntervalMs = 16;
+
+double Ease(Animation::Easing easing, double t) {
+  switch (easing) {
+    case Animation::Easing::Linear:
+      return t;
+    case Animation::Easing::EaseIn:
+      return t * t;
+    case Animation::Easing::EaseOut:
+      return 1 - (1 - t) * (1 - t);
+    case Animation::Easing::EaseInOut:
+      return t < 0.5 ? 2 * t * t : 1 - 2 * (1 - t) * (1 - t);
+  }
+  return t;
+}
+
+unsigned Interpolate(unsigned from, unsigned to, double t) {
+  return static_cast<unsigned>(from + (static_cast<double>(to) - from) * t +
+                               0.5);
+}
+
+// The root view whose layout contains |view|.
+View* GetLayoutRoot(View* view) {
+  while (view->GetParent() && view->GetParent()->IsContainer())
+    view = view->GetParent();
+  return view;
+}
+
+}  // namespace
+
+Animation::Animation(View* view, int duration)
+    : view_(view), duration_(std::max(duration, 0)) {}
+
+Animation::~Animation() {}
+
+void Animation::AnimateStyle(const std::string& name, float from, float to) {
+  styles_.push_back({name, from, to});
+}
+
+void Animation::AnimateColor(const std::string& name, Color from, Color to) {
+  std::string key = base::ToLowerASCII(name);
+  base::RemoveChars(key, "-", &key);
+  if (key == "color") {
+    colors_.push_back({false, from, to});
+  } else if (key == "backgroundcolor") {
+    colors_.push_back({true, from, to});
+  } else {
+    LOG(ERROR) << "Unsupported color property: " << name;
+  }
+}
+
+void Animation::SetEasing(Easing easing) {
+  easing_ = easing;
+}
+
+void Animation::Start() {
+  // The start time is set by the first frame.
+  start_time_ = base::TimeTicks();
+  if (is_running_)
+    return;
+  is_running_ = true;
+  Animator::GetCurrent()->Add(this);
+}
+
+void Animation::Stop() {
+  if (!is_running_)
+    return;
+  is_running_ = false;
+  Animator::GetCurrent()->Remove(this);
+}
+
+bool Animation::Step(base::TimeTicks now) {
+  if (start_time_.is_null())
+    start_time_ = now;
+  double progress = 1;
+  if (duration_ > 0) {
+    progress = (now - start_time_).InMillisecondsF() / duration_;
+    progress = std::clamp(progress, 0.0, 1.0);
+  }
+  double t = Ease(easing_, progress);
+  for (const StyleProperty& style : styles_)
+    view_->SetStyleProperty(style.name,
+                            static_cast<float>(style.from +
+                                               (style.to - style.from) * t));
+  for (const ColorProperty& color : colors_) {
+    Color value(Interpolate(color.from.a(), color.to.a(), t),
+                Interpolate(color.from.r(), color.to.r(), t),
+                Interpolate(color.from.g(), color.to.g(), t),
+                Interpolate(color.from.b(), color.to.b(), t));
+    if (color.is_background)
+      view_->SetBackgroundColor(value);
+    else
+      view_->SetColor(value);
+  }
+  return progress >= 1;
+}
+
+Animator::Animator() {}
+
+Animator::~Animator() {
+  StopTicking();
+  for (auto& animation : animations_)
+    animation->is_running_ = false;
+}
+
+// static
+Animator* Animator::GetCurrent() {
+  return State::GetCurrent()->GetAnimator();
+}
+
+void Animator::Add(Animation* animation) {
+  animations_.push_back(animation);
+  if (is_ticking_ && !uses_frame_clock_)
+    UseFrameClockIfAvailable();
+  StartTicking();
+}
+
+void Animator::Remove(Animation* animation) {
+  auto it = std::find(animations_.begin(), animations_.end(), animation);
+  if (it == animations_.end())
+    return;
+  // Removing in the middle of a tick is handled by Tick.
+  if (is_in_tick_)
+    it->reset();
+  else
+    animations_.erase(it);
+  if (animations_.empty())
+    StopTicking();
+}
+
+void Animator::Tick(base::TimeTicks now) {
+  std::vector<scoped_refptr<Animation>> finished;
+  std::set<View*> layout_roots;
+  {
+    base::AutoReset<bool> auto_reset(&is_in_tick_, true);
+    // Animations added by handlers are appended and will run next frame.
+    size_t count = animations_.size();
+    for (size_t i = 0; i < count; ++i) {
+      scoped_refptr<Animation> animation = animations_[i];
+      if (!animation)  // stopped
+        continue;
+      if (animation->HasStyleProperties())
+        layout_roots.insert(GetLayoutRoot(animation->GetView()));
+      if (animation->Step(now)) {
+        animation->is_running_ = false;
+        animations_[i] = nullptr;
+        finished.push_back(std::move(animation));
+      }
+    }
+    animations_.erase(
+        std::remove(animations_.begin(), animations_.end(), nullptr),
+        animations_.end());
+  }
+
+  // Do one layout for each affected window, instead of one for each change.
+  for (View* root : layout_roots)
+    root->Layout();
+
+  if (animations_.empty())
+    StopTicking();
+
+  for (auto& animation : finished)
+    animation->on_finish.Emit(animation.get());
+}
+
+void Animator::StartTicking() {
+  if (is_ticking_)
+    return;
+  is_ticking_ = true;
+  uses_frame_clock_ = PlatformStartTicking();
+  if (!uses_frame_clock_)
+    timer_ = MessageLoop::SetTimeout(kFrameIntervalMs,
+                                     std::bind(&Animator::OnTimer, this));
+}
+
+void Animator::StopTicking() {
+  if (!is_ticking_)
+    return;
+  is_ticking_ = false;
+  if (uses_frame_clock_)
+    PlatformStopTicking();
+  uses_frame_clock_ = false;
+  if (timer_) {
+    MessageLoop::ClearTimeout(timer_);
+    timer_ = 0;
+  }
+}
+
+void Animator::RestartTicking() {
+  StopTicking();
+  if (!animations_.empty())
+    StartTicking();
+}
+
+void Animator::UseFrameClockIfAvailable() {
+  if (!PlatformStartTicking())
+    return;
+  uses_frame_clock_ = true;
+  if (timer_) {
+    MessageLoop::ClearTimeout(timer_);
+    timer_ = 0;
+  }
+}
+
+void Animator::OnTimer() {
+  timer_ = 0;
+  Tick(base::TimeTicks::Now());
+  // Views might have been shown since last frame.
+  if (is_ticking_ && !uses_frame_clock_)
+    UseFrameClockIfAvailable();
+  // Ticking might have been restarted by handlers.
+  if (is_ticking_ && !uses_frame_clock_ && !timer_)
+    timer_ = MessageLoop::SetTimeout(kFrameIntervalMs,
+                                     std::bind(&Animator::OnTimer, this));
+}
+
+#if !defined(OS_LINUX)
+bool Animator::PlatformStartTicking() {
+  return false;
+}
+
+void Animator::PlatformStopTicking() {
+}
+#endif
+
+}  // namespace nu
@@ -0,0 +1,154 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_ANIMATOR_H_
+#define NATIVEUI_ANIMATOR_H_
+
+#include <string>
+#include <vector>
+
+#include "base/memory/ref_counted.h"
+#include "base/time/time.h"
+#include "nativeui/gfx/color.h"
+#include "nativeui/message_loop.h"
+#include "nativeui/signal.h"
+#include "nativeui/types.h"
+
+namespace nu {
+
+class Animator;
+class View;
+
+// Animates style properties of a view.
+class NATIVEUI_EXPORT Animation : public base::RefCounted<Animation> {
+ public:
+  enum class Easing {
+    Linear,
+    EaseIn,
+    EaseOut,
+    EaseInOut,
+  };
+
+  // Create an animation of |view| that lasts |duration| milliseconds.
+  Animation(View* view, int duration);
+
+  Animation& operator=(const Animation&) = delete;
+  Animation(const Animation&) = delete;
+
+  // Animate a numeric style property, like "width" and "margin-left".
+  void AnimateStyle(const std::string& name, float from, float to);
+  // Animate "color" or "background-color".
+  void AnimateColor(const std::string& name, Color from, Color to);
+
+  void SetEasing(Easing easing);
+  Easing GetEasing() const { return easing_; }
+
+  // Play the animation from beginning.
+  void Start();
+  // Stop at current state, the on_finish event is not emitted.
+  void Stop();
+  bool IsRunning() const { return is_running_; }
+
+  View* GetView() const { return view_.get(); }
+  int GetDuration() const { return duration_; }
+
+  // Events.
+  Signal<void(Animation*)> on_finish;
+
+ protected:
+  virtual ~Animation();
+
+ private:
+  friend class base::RefCounted<Animation>;
+  friend class Animator;
+
+  struct StyleProperty {
+    std::string name;
+    float from;
+    float to;
+  };
+
+  struct ColorProperty {
+    bool is_background;
+    Color from;
+    Color to;
+  };
+
+  // Apply the values at |now| without doing layout, returns true when the
+  // animation has finished.
+  bool Step(base::TimeTicks now);
+
+  bool HasStyleProperties() const { return !styles_.empty(); }
+
+  scoped_refptr<View> view_;
+  int duration_;
+  Easing easing_ = Easing::Linear;
+  std::vector<StyleProperty> styles_;
+  std::vector<ColorProperty> colors_;
+
+  bool is_running_ = false;
+  base::TimeTicks start_time_;
+};
+
+// Ticks all running animations with the frame clock.
+//
+// Values of all animations are applied in each frame before doing a single
+// layout for each affected window.
+class NATIVEUI_EXPORT Animator {
+ public:
+  ~Animator();
+
+  static Animator* GetCurrent();
+
+  Animator& operator=(const Animator&) = delete;
+  Animator(const Animator&) = delete;
+
+  // Internal: Add or remove a running animation.
+  void Add(Animation* animation);
+  void Remove(Animation* animation);
+
+  // Internal: Advance all animations to |now|.
+  void Tick(base::TimeTicks now);
+
+  size_t GetRunningCount() const { return animations_.size(); }
+
+ private:
+  friend class State;
+
+  Animator();
+
+  void StartTicking();
+  void StopTicking();
+  void OnTimer();
+
+  // Stop and start ticking again to choose a new clock.
+  void RestartTicking();
+
+  // Switch from the fallback timer to the frame clock when possible.
+  void UseFrameClockIfAvailable();
+
+  // Use the frame clock of native views when available, returns false if the
+  // platform does not support it.
+  bool PlatformStartTicking();
+  void PlatformStopTicking();
+
+#if defined(OS_LINUX)
+  static void OnTickCallbackDestroyed(void* data);
+  static void OnTickWidgetHidden(NativeView widget, void* data);
+
+  NativeView tick_widget_ = nullptr;
+  unsigned int tick_id_ = 0;
+#endif
+
+  bool is_ticking_ = false;
+  bool uses_frame_clock_ = false;
+  bool is_in_tick_ = false;
+  MessageLoop::TimerId timer_ = 0;
+
+  std::vector<scoped_refptr<Animation>> animations_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_ANIMATOR_H_
@@ -0,0 +1,82 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class AnimatorTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    window_ = new nu::Window(nu::Window::Options());
+    container_ = new nu::Container;
+    window_->SetContentView(container_.get());
+    window_->SetContentSize(nu::SizeF(400, 400));
+    container_->SetStyle("flex-direction", "row");
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::Window> window_;
+  scoped_refptr<nu::Container> container_;
+};
+
+TEST_F(AnimatorTest, Finish) {
+  scoped_refptr<nu::Container> view(new nu::Container);
+  container_->AddChildView(view.get());
+  scoped_refptr<nu::Animation> animation(new nu::Animation(view.get(), 50));
+  animation->AnimateStyle("width", 0, 100);
+  animation->AnimateColor("background-color", nu::Color(0, 0, 0),
+                          nu::Color(255, 255, 255));
+  int finished = 0;
+  animation->on_finish.Connect([&finished](nu::Animation*) {
+    ++finished;
+    nu::MessageLoop::Quit();
+  });
+  animation->Start();
+  EXPECT_TRUE(animation->IsRunning());
+  EXPECT_EQ(nu::Animator::GetCurrent()->GetRunningCount(), 1u);
+  nu::MessageLoop::Run();
+  EXPECT_EQ(finished, 1);
+  EXPECT_FALSE(animation->IsRunning());
+  EXPECT_EQ(nu::Animator::GetCurrent()->GetRunningCount(), 0u);
+  EXPECT_EQ(view->GetBounds().width(), 100);
+}
+
+TEST_F(AnimatorTest, Stop) {
+  scoped_refptr<nu::Container> view(new nu::Container);
+  container_->AddChildView(view.get());
+  scoped_refptr<nu::Animation> animation(new nu::Animation(view.get(), 50));
+  animation->AnimateStyle("width", 0, 100);
+  bool finished = false;
+  animation->on_finish.Connect([&finished](nu::Animation*) {
+    finished = true;
+  });
+  animation->Start();
+  animation->Stop();
+  EXPECT_FALSE(animation->IsRunning());
+  EXPECT_EQ(nu::Animator::GetCurrent()->GetRunningCount(), 0u);
+  nu::MessageLoop::PostDelayedTask(100, []() { nu::MessageLoop::Quit(); });
+  nu::MessageLoop::Run();
+  EXPECT_FALSE(finished);
+}
+
+TEST_F(AnimatorTest, MultipleAnimations) {
+  scoped_refptr<nu::Container> view1(new nu::Container);
+  scoped_refptr<nu::Container> view2(new nu::Container);
+  container_->AddChildView(view1.get());
+  container_->AddChildView(view2.get());
+  scoped_refptr<nu::Animation> animation1(new nu::Animation(view1.get(), 30));
+  animation1->AnimateStyle("width", 0, 100);
+  scoped_refptr<nu::Animation> animation2(new nu::Animation(view2.get(), 60));
+  animation2->SetEasing(nu::Animation::Easing::EaseInOut);
+  animation2->AnimateStyle("width", 0, 50);
+  animation2->on_finish.Connect([](nu::Animation*) {
+    nu::MessageLoop::Quit();
+  });
+  animation1->Start();
+  animation2->Start();
+  nu::MessageLoop::Run();
+  EXPECT_EQ(view1->GetBounds(), nu::RectF(0, 0, 100, 400));
+  EXPECT_EQ(view2->GetBounds(), nu::RectF(100, 0, 50, 400));
+}
@@ -4,12 +4,14 @@
 
 #include "nativeui/app.h"
 
+#include <iterator>
 #include <utility>
 
 #include "base/base_paths.h"
 #include "base/path_service.h"
 #include "nativeui/menu_bar.h"
 #include "nativeui/state.h"
+#include "nativeui/util/trace_event.h"
 
 namespace nu {
 
@@ -44,4 +46,30 @@ std::string App::GetName() const {
   return *cached_name_;
 }
 
+void App::StartTracing() {
+  TraceLog::GetInstance()->Start();
+}
+
+std::string App::StopTracing() {
+  return TraceLog::GetInstance()->Stop();
+}
+
+bool App::IsTracing() const {
+  return TraceLog::IsEnabled();
+}
+
+App::FrameTimings App::GetFrameTimings() const {
+  TraceLog::FrameStats stats = TraceLog::GetInstance()->GetFrameStats();
+  FrameTimings timings;
+  timings.count = stats.count;
+  if (stats.count > 0)
+    timings.average = stats.total.InMillisecondsF() / stats.count;
+  timings.max = stats.max.InMillisecondsF();
+  for (int bound : TraceLog::kFrameBuckets)
+    timings.buckets.push_back(bound);
+  timings.histogram.assign(std::begin(stats.histogram),
+                           std::end(stats.histogram));
+  return timings;
+}
+
 }  // namespace nu
@@ -7,6 +7,7 @@
 
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "base/memory/weak_ptr.h"
 #include "nativeui/clipboard.h"
@@ -66,6 +67,24 @@ class NATIVEUI_EXPORT App {
   base::FilePath GetStartMenuShortcutPath() const;
 #endif
 
+  // Tracing of layout, text measurement, painting and callbacks.
+  struct FrameTimings {
+    int count = 0;
+    float average = 0;
+    float max = 0;
+    // Upper bounds of histogram buckets in milliseconds, the last bucket has
+    // no upper bound.
+    std::vector<float> buckets;
+    std::vector<int> histogram;
+  };
+  void StartTracing();
+  // Stop tracing and return events in the Chrome trace event format.
+  std::string StopTracing();
+  bool IsTracing() const;
+  // Return durations of painting frames since tracing started, which are not
+  // the intervals between frames.
+  FrameTimings GetFrameTimings() const;
+
   base::WeakPtr<App> GetWeakPtr() { return weak_factory_.GetWeakPtr(); }
 
  protected:
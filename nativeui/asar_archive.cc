@@ -4,48 +4,105 @@
 
 #include "nativeui/asar_archive.h"
 
+#include <string.h>
+
+#include <algorithm>
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include "base/json/json_reader.h"
+#include "base/logging.h"
+#include "base/no_destructor.h"
 #include "base/pickle.h"
-#include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_split.h"
-#include "base/strings/utf_string_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/synchronization/lock.h"
 
 namespace nu {
 
 namespace {
 
+// The old asar extension name.
+const base::FilePath::CharType kOldAsarExt[] = FILE_PATH_LITERAL(".asar");
+
 // The version of asar format we supports.
 const uint8_t kSupportedAsarVersion = 2;
 
-const base::Value* FindPathInValue(const base::Value& value,
-                                   const std::vector<base::StringPiece>& path) {
-  const base::Value* cur = &value;
-  for (const base::StringPiece& component : path) {
-    if (!cur->is_dict() || (cur = cur->GetDict().Find(component)) == nullptr)
-      return nullptr;
-  }
-  return cur;
+// Links pointing to links are followed at most this many times.
+const int kMaxLinkDepth = 32;
+
+// Archives opened in current process, keyed by file path.
+struct ArchiveCache {
+  base::Lock lock;
+  std::map<base::FilePath, scoped_refptr<AsarArchive>> archives;
+};
+
+ArchiveCache* GetArchiveCache() {
+  static base::NoDestructor<ArchiveCache> cache;
+  return cache.get();
+}
+
+// Convert file path to the key of index.
+// /path\to//image.jpg => path/to/image.jpg
+std::string NormalizePath(base::StringPiece path) {
+  std::vector<base::StringPiece> components = base::SplitStringPiece(
+      path, "/\\", base::KEEP_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+  return base::JoinString(components, "/");
 }
 
 }  // namespace
 
-AsarArchive::AsarArchive(base::File file, bool extended_format)
-    : file_(std::move(file)) {
-  if (!file_.IsValid())
+// static
+scoped_refptr<AsarArchive> AsarArchive::Open(const base::FilePath& path,
+                                             base::File* file,
+                                             bool extended_format) {
+  base::File::Info info;
+  if (!file->IsValid() || !file->GetInfo(&info))
+    return nullptr;
+
+  ArchiveCache* cache = GetArchiveCache();
+  {
+    base::AutoLock auto_lock(cache->lock);
+    auto it = cache->archives.find(path);
+    if (it != cache->archives.end() &&
+        it->second->last_modified() == info.last_modified &&
+        it->second->length() == info.size)
+      return it->second;
+  }
+
+  // Parse the archive without holding the lock, when multiple threads are
+  // opening the same archive the last one wins.
+  auto archive = base::MakeRefCounted<AsarArchive>(file->Duplicate(),
+                                                   extended_format);
+  if (!archive->IsValid())
+    return nullptr;
+  base::AutoLock auto_lock(cache->lock);
+  cache->archives[path] = archive;
+  return archive;
+}
+
+// static
+bool AsarArchive::IsExtendedFormat(const base::FilePath& path) {
+  return !path.MatchesExtension(kOldAsarExt);
+}
+
+AsarArchive::AsarArchive(base::File file, bool extended_format) {
+  base::File::Info info;
+  if (!file.IsValid() || !file.GetInfo(&info))
     return;
+  last_modified_ = info.last_modified;
+  length_ = info.size;
 
   // If it is an extended type of asar, search from the end of file.
-  if (extended_format && !ReadExtendedMeta())
+  if (extended_format && !ReadExtendedMeta(&file))
     return;
 
   // Read size.
   char size_buf[8];
-  if (file_.ReadAtCurrentPos(size_buf, 8) != 8)
+  if (file.Read(content_offset_, size_buf, 8) != 8)
     return;
   uint32_t size;
   if (!base::PickleIterator(base::Pickle(size_buf, 8)).ReadUInt32(&size))
@@ -53,87 +110,203 @@ AsarArchive::AsarArchive(base::File file, bool extended_format)
 
   // Read header.
   std::vector<char> header_buf(size);
-  if (file_.ReadAtCurrentPos(header_buf.data(), size) != static_cast<int>(size))
+  if (file.Read(content_offset_ + 8, header_buf.data(), size) !=
+          static_cast<int>(size))
     return;
   std::string header;
   if (!base::PickleIterator(
           base::Pickle(header_buf.data(), size)).ReadString(&header))
     return;
 
-  // Parse header.
+  // Parse header, the JSON is only kept until the index is built.
   std::optional<base::Value> value = base::JSONReader::Read(header);
   if (!value || !value->is_dict())
     return;
   content_offset_ += 8 + size;
-  header_ = std::move(*value);
+  BuildIndex(value->GetDict());
+  is_valid_ = true;
+
+  // Failing to map is not fatal, for example when there is not enough address
+  // space for a large archive in 32bit process.
+  if (!mapped_file_.Initialize(std::move(file)))
+    LOG(WARNING) << "Failed to map asar archive into memory";
 }
 
 AsarArchive::~AsarArchive() {
 }
 
 bool AsarArchive::IsValid() const {
-  return file_.IsValid() && header_.is_dict();
+  return is_valid_;
 }
 
-bool AsarArchive::GetFileInfo(const std::string& path, FileInfo* info) {
-  if (!header_.is_dict())
-    return false;
-
-  // Convert file path to value search path.
-  // path/to/image.jpg => { files, path, files, to, files, image.jpg }
-  std::vector<base::StringPiece> components = base::SplitStringPiece(
-      path, "/\\", base::KEEP_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
-  std::vector<base::StringPiece> key;
-  key.reserve(components.size() * 2);
-  const char* filesKey = "files";
-  for (const base::StringPiece& c : components) {
-    key.push_back(filesKey);
-    key.push_back(c);
+bool AsarArchive::GetFileInfo(const std::string& path, FileInfo* info) const {
+  // Paths passed in are usually normalized already.
+  auto it = index_.find(path);
+  if (it == index_.end()) {
+    std::string normalized = NormalizePath(path);
+    if (normalized == path)
+      return false;
+    it = index_.find(normalized);
+    if (it == index_.end())
+      return false;
   }
+  *info = it->second;
+  return true;
+}
 
-  // Search for the node representing path.
-  const base::Value* node = FindPathInValue(header_, key);
-  if (!node)
-    return false;
-
-  // Read file information.
-  const base::Value* link = node->GetDict().Find("link");
-  if (link && link->is_string())
-    return GetFileInfo(link->GetString(), info);
+base::span<const uint8_t> AsarArchive::GetFileData(
+    const FileInfo& info) const {
+  if (!mapped_file_.IsValid() || info.offset > mapped_file_.length() ||
+      info.size > mapped_file_.length() - info.offset)
+    return base::span<const uint8_t>();
+  return base::span<const uint8_t>(mapped_file_.data() + info.offset,
+                                   info.size);
+}
 
-  const base::Value* size = node->GetDict().Find("size");
-  if (!size || !size->is_int())
+// static
+bool AsarArchive::VerifyBlock(const FileInfo& info,
+                              size_t index,
+                              base::span<const uint8_t> data) {
+  const Integrity* integrity = info.integrity;
+  if (!integrity)
+    return true;
+  if (integrity->block_size == 0 || index >= integrity->blocks.size())
     return false;
-  info->size = size->GetInt();
-
-  const base::Value* offset = node->GetDict().Find("offset");
-  if (!offset || !offset->is_string() ||
-      !base::StringToUint64(offset->GetString(), &info->offset))
+  // All blocks are full except for the last one.
+  uint64_t start = static_cast<uint64_t>(index) * integrity->block_size;
+  if (start > info.size ||
+      data.size() != std::min<uint64_t>(integrity->block_size,
+                                        info.size - start))
     return false;
-
-  info->offset += content_offset_;
-  return true;
+  uint8_t hash[SHA256_LENGTH];
+  SHA256::Hash(data.data(), data.size(), hash);
+  return memcmp(hash, integrity->blocks[index].data(), SHA256_LENGTH) == 0;
 }
 
-bool AsarArchive::ReadExtendedMeta() {
+bool AsarArchive::ReadExtendedMeta(base::File* file) {
   // Read last 13 bytes, which are | size(8) | version(1) | magic(4) |.
-  char magic[5] = { 0 };
-  if (file_.Seek(base::File::FROM_END, -4) == -1 ||
-      file_.ReadAtCurrentPos(magic, 4) != 4 ||
-      base::StringPiece(magic) != "ASAR")
+  if (length_ < 13)
     return false;
-  uint8_t version;
-  if (file_.Seek(base::File::FROM_END, -5) == -1 ||
-      file_.ReadAtCurrentPos(reinterpret_cast<char*>(&version), 1) != 1 ||
-      version != kSupportedAsarVersion)
+  char meta[13];
+  if (file->Read(length_ - 13, meta, 13) != 13 ||
+      base::StringPiece(meta + 9, 4) != "ASAR")
+    return false;
+  uint8_t version = static_cast<uint8_t>(meta[8]);
+  if (version != kSupportedAsarVersion)
     return false;
   double size;
-  if (file_.Seek(base::File::FROM_END, -13) == -1 ||
-      file_.ReadAtCurrentPos(reinterpret_cast<char*>(&size), 8) != 8)
+  memcpy(&size, meta, 8);
+  if (!(size >= 0 && size <= length_))
     return false;
-  content_offset_ = file_.GetLength() - static_cast<uint64_t>(size);
-  file_.Seek(base::File::FROM_BEGIN, content_offset_);
+  content_offset_ = length_ - static_cast<uint64_t>(size);
   return true;
 }
 
+void AsarArchive::BuildIndex(const base::Value::Dict& header) {
+  std::string prefix;
+  std::unordered_map<std::string, std::string> links;
+  AddDirectory(header, &prefix, &links);
+
+  // Resolve links to the files they eventually point to.
+  for (const auto& [path, link] : links) {
+    std::string target = NormalizePath(link);
+    for (int depth = 0; depth < kMaxLinkDepth; ++depth) {
+      auto it = index_.find(target);
+      if (it != index_.end()) {
+        index_[path] = it->second;
+        break;
+      }
+      auto next = links.find(target);
+      if (next == links.end())
+        break;
+      target = NormalizePath(next->second);
+    }
+  }
+}
+
+const AsarArchive::Integrity* AsarArchive::AddIntegrity(
+    const base::Value::Dict& dict,
+    uint32_t size) {
+  // Malformed integrity info is still recorded so the file fails to serve.
+  Integrity& integrity = integrities_.emplace_back();
+  const std::string* algorithm = dict.FindString("algorithm");
+  std::optional<int> block_size = dict.FindInt("blockSize");
+  const base::Value::List* blocks = dict.FindList("blocks");
+  if (!algorithm || *algorithm != "SHA256" || !block_size ||
+      *block_size <= 0 || !blocks)
+    return &integrity;
+  // Empty files are allowed to have one hash of empty block.
+  size_t count = (static_cast<uint64_t>(size) + *block_size - 1) / *block_size;
+  if (blocks->size() != count && !(size == 0 && blocks->size() == 1))
+    return &integrity;
+  integrity.blocks.resize(blocks->size());
+  for (size_t i = 0; i < blocks->size(); ++i) {
+    const std::string* hash = (*blocks)[i].GetIfString();
+    if (!hash || !base::HexStringToSpan(*hash, integrity.blocks[i])) {
+      integrity.blocks.clear();
+      return &integrity;
+    }
+  }
+  integrity.block_size = *block_size;
+  return &integrity;
+}
+
+// static
+bool AsarArchive::ReadCompression(const base::Value::Dict& node,
+                                  FileInfo* info) {
+  const std::string* compression = node.FindString("compression");
+  if (!compression)
+    return true;
+  if (*compression != "deflate")
+    return false;
+  info->compressed = true;
+  std::optional<double> size = node.FindDouble("uncompressedSize");
+  if (size && *size >= 0)
+    info->uncompressed_size = static_cast<int64_t>(*size);
+  return true;
+}
+
+void AsarArchive::AddDirectory(
+    const base::Value::Dict& dir,
+    std::string* prefix,
+    std::unordered_map<std::string, std::string>* links) {
+  const base::Value::Dict* files = dir.FindDict("files");
+  if (!files)
+    return;
+  size_t prefix_size = prefix->size();
+  for (const auto [name, value] : *files) {
+    // Names that can not be reached by paths are ignored.
+    if (name.empty() || name.find_first_of("/\\") != std::string::npos ||
+        !value.is_dict())
+      continue;
+    if (!prefix->empty())
+      prefix->push_back('/');
+    prefix->append(name);
+
+    const base::Value::Dict& node = value.GetDict();
+    if (node.Find("files")) {
+      AddDirectory(node, prefix, links);
+    } else if (const std::string* link = node.FindString("link")) {
+      (*links)[*prefix] = *link;
+    } else {
+      // Unpacked files have no offset and are not served from archive.
+      std::optional<int> size = node.FindInt("size");
+      const std::string* offset = node.FindString("offset");
+      FileInfo info;
+      if (size && *size >= 0 && offset &&
+          base::StringToUint64(*offset, &info.offset)) {
+        info.size = *size;
+        info.offset += content_offset_;
+        if (const base::Value::Dict* integrity = node.FindDict("integrity"))
+          info.integrity = AddIntegrity(*integrity, info.size);
+        if (ReadCompression(node, &info))
+          index_[*prefix] = info;
+        else
+          LOG(WARNING) << "Unsupported compression of " << *prefix;
+      }
+    }
+    prefix->resize(prefix_size);
+  }
+}
+
 }  // namespace nu
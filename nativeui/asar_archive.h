@@ -5,33 +5,110 @@
 #ifndef NATIVEUI_ASAR_ARCHIVE_H_
 #define NATIVEUI_ASAR_ARCHIVE_H_
 
+#include <array>
+#include <deque>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
+#include "base/containers/span.h"
 #include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/memory/ref_counted.h"
+#include "base/time/time.h"
 #include "base/values.h"
 #include "nativeui/nativeui_export.h"
+#include "nativeui/util/sha256.h"
 
 namespace nu {
 
-class NATIVEUI_EXPORT AsarArchive {
+// The header of asar archive is compiled into a flat index when opened, so
+// looking up files does not need to walk the JSON. The archive is also mapped
+// into memory so contents of files can be read without system calls.
+//
+// Files can be stored with per-entry compression by adding
+// |"compression": "deflate"| and |"uncompressedSize"| to the entry, the
+// |"size"| and |"integrity"| then describe the compressed data.
+class NATIVEUI_EXPORT AsarArchive
+    : public base::RefCountedThreadSafe<AsarArchive> {
  public:
+  // SHA-256 hashes of fixed-size blocks of a file.
+  struct Integrity {
+    // A block size of 0 means the integrity info is malformed, and the file
+    // must not be served.
+    uint32_t block_size = 0;
+    std::vector<std::array<uint8_t, SHA256_LENGTH>> blocks;
+  };
+
   struct FileInfo {
+    // Size of the data stored in archive.
     uint32_t size = 0;
     uint64_t offset = 0;
+    // Whether the file is compressed with raw deflate, encrypted files are
+    // compressed before encrypting so they are decompressed after decrypting.
+    bool compressed = false;
+    // Size of the file after decompressing, -1 if unknown.
+    int64_t uncompressed_size = -1;
+    // Owned by the archive, null if the file has no integrity info.
+    const Integrity* integrity = nullptr;
   };
 
+  // Return the archive at |path| from a process-wide cache, the archive is
+  // parsed again if the file has been modified. The |file| must be opened from
+  // |path|, and null is returned if it is not a valid archive.
+  static scoped_refptr<AsarArchive> Open(const base::FilePath& path,
+                                         base::File* file,
+                                         bool extended_format);
+
+  // Whether |path| uses the extended format with meta at the end of file.
+  static bool IsExtendedFormat(const base::FilePath& path);
+
   AsarArchive(base::File file, bool extended_format);
-  virtual ~AsarArchive();
 
   bool IsValid() const;
-  bool GetFileInfo(const std::string& path, FileInfo* info);
+  bool GetFileInfo(const std::string& path, FileInfo* info) const;
+
+  // Return the content of file as a view into the mapping, which is valid as
+  // long as the archive is alive. An empty span is returned when the archive
+  // could not be mapped.
+  base::span<const uint8_t> GetFileData(const FileInfo& info) const;
+  bool IsMapped() const { return mapped_file_.IsValid(); }
+
+  // Check the |index|th block of file against its hash, which always passes
+  // for files without integrity info.
+  static bool VerifyBlock(const FileInfo& info,
+                          size_t index,
+                          base::span<const uint8_t> data);
+
+  base::Time last_modified() const { return last_modified_; }
+  int64_t length() const { return length_; }
+
+ protected:
+  friend class base::RefCountedThreadSafe<AsarArchive>;
+
+  virtual ~AsarArchive();
 
  private:
-  bool ReadExtendedMeta();
+  bool ReadExtendedMeta(base::File* file);
+  void BuildIndex(const base::Value::Dict& header);
+  const Integrity* AddIntegrity(const base::Value::Dict& dict, uint32_t size);
+  // Returns false if the file uses an unsupported compression.
+  static bool ReadCompression(const base::Value::Dict& node, FileInfo* info);
+  void AddDirectory(const base::Value::Dict& dir,
+                    std::string* prefix,
+                    std::unordered_map<std::string, std::string>* links);
 
-  base::File file_;
-  base::Value header_;
+  bool is_valid_ = false;
+  base::Time last_modified_;
+  int64_t length_ = 0;
   uint64_t content_offset_ = 0;
+
+  // Maps normalized paths like "path/to/file" to file information.
+  std::unordered_map<std::string, FileInfo> index_;
+  std::deque<Integrity> integrities_;
+
+  base::MemoryMappedFile mapped_file_;
 };
 
 }  // namespace nu
@@ -0,0 +1,199 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/stringprintf.h"
+#include "nativeui/asar_archive.h"
+#include "nativeui/protocol_asar_job.h"
+#include "nativeui/protocol_mapped_job.h"
+#include "nativeui/test/asar_util.h"
+#include "nativeui/test/benchmark.h"
+#include "nativeui/util/aes.h"
+
+namespace {
+
+// Write an archive with |count| files spread in nested dirs.
+base::FilePath WriteArchive(const base::ScopedTempDir& temp_dir,
+                            int64_t count,
+                            const std::string& content,
+                            std::vector<std::string>* paths) {
+  std::map<std::string, std::string> files;
+  for (int64_t i = 0; i < count; ++i) {
+    std::string path = base::StringPrintf("dir%d/sub%d/file%d.js",
+                                          static_cast<int>(i % 10),
+                                          static_cast<int>(i % 7),
+                                          static_cast<int>(i));
+    files[path] = content;
+    paths->push_back(path);
+  }
+  // Pad the header like a real app with many dependencies.
+  for (int i = 0; i < 20000; ++i)
+    files[base::StringPrintf("node_modules/pkg%d/index.js", i)] = "";
+  base::FilePath path = temp_dir.GetPath().AppendASCII("app.asar");
+  CHECK(nu::WriteAsarArchive(path, files));
+  return path;
+}
+
+// Look up files in an archive with |range| files.
+void BM_AsarArchiveGetFileInfo(nu::BenchmarkState* state) {
+  base::ScopedTempDir temp_dir;
+  CHECK(temp_dir.CreateUniqueTempDir());
+  std::vector<std::string> paths;
+  base::FilePath path = WriteArchive(temp_dir, state->range(0), "content",
+                                     &paths);
+  auto archive = base::MakeRefCounted<nu::AsarArchive>(
+      base::File(path, base::File::FLAG_OPEN | base::File::FLAG_READ), false);
+  CHECK(archive->IsValid());
+
+  nu::AsarArchive::FileInfo info;
+  size_t index = 0;
+  while (state->KeepRunning()) {
+    archive->GetFileInfo(paths[index], &info);
+    index = (index + 1) % paths.size();
+  }
+}
+NU_BENCHMARK(BM_AsarArchiveGetFileInfo)->Arg(100)->Arg(10000);
+
+// Serve all subresources of a page with |range| subresources from asar.
+template<typename Job>
+void LoadPage(nu::BenchmarkState* state) {
+  base::ScopedTempDir temp_dir;
+  CHECK(temp_dir.CreateUniqueTempDir());
+  std::vector<std::string> paths;
+  base::FilePath path = WriteArchive(temp_dir, state->range(0),
+                                     std::string(4096, 'x'), &paths);
+
+  std::vector<char> buffer(16 * 1024);
+  while (state->KeepRunning()) {
+    for (const std::string& resource : paths) {
+      scoped_refptr<nu::ProtocolJob> job =
+          base::MakeRefCounted<Job>(path, resource);
+      job->Plug([](int) {});
+      CHECK(job->Start());
+      while (job->Read(buffer.data(), buffer.size()) > 0) {}
+    }
+  }
+  state->SetItemsProcessed(state->iterations() * paths.size());
+}
+
+void BM_AsarPageLoad(nu::BenchmarkState* state) {
+  LoadPage<nu::ProtocolAsarJob>(state);
+}
+NU_BENCHMARK(BM_AsarPageLoad)->Arg(500);
+
+void BM_AsarPageLoadMapped(nu::BenchmarkState* state) {
+  LoadPage<nu::ProtocolMappedJob>(state);
+}
+NU_BENCHMARK(BM_AsarPageLoadMapped)->Arg(500);
+
+// Load a page with 200 scripts from a newly opened archive, with the files
+// stored uncompressed or compressed.
+void BM_AsarColdPageLoad(nu::BenchmarkState* state) {
+  base::ScopedTempDir temp_dir;
+  CHECK(temp_dir.CreateUniqueTempDir());
+  bool compressed = state->range(0);
+  state->SetLabel(compressed ? "compressed" : "uncompressed");
+  std::map<std::string, std::string> files;
+  std::map<std::string, size_t> sizes;
+  std::vector<std::string> paths;
+  size_t total_size = 0;
+  for (int i = 0; i < 200; ++i) {
+    std::string content;
+    for (int line = 0; line < 500; ++line) {
+      content += base::StringPrintf(
+          "export function handler%d(event) { return event.target.value + "
+          "%d; }\n", line, (i * line) % 97);
+    }
+    std::string path = base::StringPrintf("dist/chunk%d.js", i);
+    if (compressed) {
+      files[path] = nu::CompressAsarContent(content);
+      sizes[path] = content.size();
+    } else {
+      files[path] = content;
+    }
+    paths.push_back(path);
+    total_size += content.size();
+  }
+  base::FilePath source = temp_dir.GetPath().AppendASCII("source.asar");
+  CHECK(nu::WriteAsarArchive(source, files, 0, sizes));
+
+  std::vector<char> buffer(16 * 1024);
+  int64_t index = 0;
+  while (state->KeepRunning()) {
+    // Copy to a new path so the archive is parsed again, the copy is still in
+    // the page cache of system.
+    state->PauseTiming();
+    base::FilePath path = temp_dir.GetPath().AppendASCII(
+        base::StringPrintf("app%d.asar", static_cast<int>(index++)));
+    CHECK(base::CopyFile(source, path));
+    state->ResumeTiming();
+    for (const std::string& resource : paths) {
+      auto job = base::MakeRefCounted<nu::ProtocolAsarJob>(path, resource);
+      job->Plug([](int) {});
+      CHECK(job->Start());
+      while (job->Read(buffer.data(), buffer.size()) > 0) {}
+    }
+  }
+  state->SetBytesProcessed(state->iterations() * total_size);
+}
+NU_BENCHMARK(BM_AsarColdPageLoad)->Arg(0)->Arg(1)->Iterations(20);
+
+// Stream a 64MB file stored in different ways.
+enum class StoreMode {
+  Plain,
+  Integrity,
+  Encrypted,
+};
+
+void BM_AsarReadThroughput(nu::BenchmarkState* state) {
+  const std::string kKey = "0123456789abcdef";
+  const std::string kIV = "fedcba9876543210";
+  base::ScopedTempDir temp_dir;
+  CHECK(temp_dir.CreateUniqueTempDir());
+  base::FilePath path = temp_dir.GetPath().AppendASCII("app.asar");
+  const size_t kSize = 64 * 1024 * 1024;
+  std::string content(kSize, 'x');
+  StoreMode mode = static_cast<StoreMode>(state->range(0));
+  if (mode == StoreMode::Encrypted)
+    content = nu::EncryptAsarContent(content, kKey, kIV);
+  CHECK(nu::WriteAsarArchive(
+      path, {{"data.bin", content}},
+      mode == StoreMode::Integrity ? 4 * 1024 * 1024 : 0));
+  const char* labels[] = {"plain", "integrity", "encrypted"};
+  state->SetLabel(labels[state->range(0)]);
+
+  std::vector<char> buffer(64 * 1024);
+  while (state->KeepRunning()) {
+    auto job = base::MakeRefCounted<nu::ProtocolAsarJob>(path, "data.bin");
+    if (mode == StoreMode::Encrypted)
+      CHECK(job->SetDecipher(kKey, kIV));
+    job->Plug([](int) {});
+    CHECK(job->Start());
+    size_t total = 0, nread;
+    while ((nread = job->Read(buffer.data(), buffer.size())) > 0)
+      total += nread;
+    CHECK_EQ(total, kSize);
+  }
+  state->SetBytesProcessed(state->iterations() * kSize);
+}
+NU_BENCHMARK(BM_AsarReadThroughput)->Arg(0)->Arg(1)->Arg(2);
+
+// Decrypt 1MB buffers with the portable code or AES instructions.
+void BM_AESCBCDecrypt(nu::BenchmarkState* state) {
+  nu::AES aes;
+  CHECK(aes.Init("0123456789abcdef", "fedcba9876543210", state->range(0)));
+  state->SetLabel(aes.IsHardwareAccelerated() ? "hardware" : "software");
+  std::vector<uint8_t> buffer(1024 * 1024);
+  while (state->KeepRunning())
+    aes.CBCDecryptBuffer(buffer.data(), buffer.size());
+  state->SetBytesProcessed(state->iterations() * buffer.size());
+}
+NU_BENCHMARK(BM_AESCBCDecrypt)->Arg(0)->Arg(1);
+
+}  // namespace
@@ -0,0 +1,498 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <string.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "nativeui/asar_archive.h"
+#include "nativeui/protocol_asar_job.h"
+#include "nativeui/protocol_mapped_job.h"
+#include "nativeui/test/asar_util.h"
+#include "nativeui/util/aes.h"
+#include "nativeui/util/inflater.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class AsarArchiveTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    path_ = temp_dir_.GetPath().AppendASCII("app.asar");
+  }
+
+  scoped_refptr<nu::AsarArchive> Open() {
+    base::File file(path_, base::File::FLAG_OPEN | base::File::FLAG_READ);
+    return nu::AsarArchive::Open(path_, &file, false);
+  }
+
+  // Read all data from |job|.
+  static std::string ReadJob(nu::ProtocolJob* job) {
+    job->Plug([](int) {});
+    if (!job->Start())
+      return "failed";
+    std::string result;
+    char buf[100];
+    size_t nread;
+    while ((nread = job->Read(buf, sizeof(buf))) > 0)
+      result.append(buf, nread);
+    return result;
+  }
+
+  // Change one byte of the file at |path| inside archive.
+  void CorruptFile(const std::string& path, size_t pos) {
+    nu::AsarArchive::FileInfo info;
+    ASSERT_TRUE(Open()->GetFileInfo(path, &info));
+    base::File file(path_, base::File::FLAG_OPEN | base::File::FLAG_READ |
+                           base::File::FLAG_WRITE);
+    char c;
+    ASSERT_EQ(file.Read(info.offset + pos, &c, 1), 1);
+    c = ~c;
+    ASSERT_EQ(file.Write(info.offset + pos, &c, 1), 1);
+  }
+
+  base::ScopedTempDir temp_dir_;
+  base::FilePath path_;
+};
+
+TEST_F(AsarArchiveTest, GetFileInfo) {
+  ASSERT_TRUE(nu::WriteAsarArchive(path_, {{"index.html", "html"},
+                                           {"js/lib/app.js", "script"}}));
+  scoped_refptr<nu::AsarArchive> archive = Open();
+  ASSERT_TRUE(archive);
+  nu::AsarArchive::FileInfo html, js;
+  ASSERT_TRUE(archive->GetFileInfo("index.html", &html));
+  EXPECT_EQ(html.size, 4u);
+  ASSERT_TRUE(archive->GetFileInfo("js/lib/app.js", &js));
+  EXPECT_EQ(js.size, 6u);
+  EXPECT_EQ(js.offset, html.offset + html.size);
+  nu::AsarArchive::FileInfo info;
+  ASSERT_TRUE(archive->GetFileInfo("/js\\lib//app.js", &info));
+  EXPECT_EQ(info.offset, js.offset);
+  EXPECT_FALSE(archive->GetFileInfo("js/lib", &info));
+  EXPECT_FALSE(archive->GetFileInfo("js/app.js", &info));
+}
+
+TEST_F(AsarArchiveTest, InvalidArchive) {
+  ASSERT_TRUE(base::WriteFile(path_, "not an archive"));
+  EXPECT_FALSE(Open());
+}
+
+TEST_F(AsarArchiveTest, Cache) {
+  ASSERT_TRUE(nu::WriteAsarArchive(path_, {{"a.txt", "a"}}));
+  scoped_refptr<nu::AsarArchive> archive = Open();
+  ASSERT_TRUE(archive);
+  EXPECT_EQ(Open(), archive);
+
+  // Modified archive is parsed again.
+  ASSERT_TRUE(nu::WriteAsarArchive(path_, {{"a.txt", "a"}, {"b.txt", "b"}}));
+  base::Time time = archive->last_modified() + base::Seconds(10);
+  ASSERT_TRUE(base::TouchFile(path_, time, time));
+  scoped_refptr<nu::AsarArchive> modified = Open();
+  ASSERT_TRUE(modified);
+  EXPECT_NE(modified, archive);
+  nu::AsarArchive::FileInfo info;
+  EXPECT_FALSE(archive->GetFileInfo("b.txt", &info));
+  EXPECT_TRUE(modified->GetFileInfo("b.txt", &info));
+}
+
+TEST_F(AsarArchiveTest, GetFileData) {
+  ASSERT_TRUE(nu::WriteAsarArchive(path_, {{"a.txt", "first"},
+                                           {"b.txt", "second"}}));
+  scoped_refptr<nu::AsarArchive> archive = Open();
+  ASSERT_TRUE(archive);
+  ASSERT_TRUE(archive->IsMapped());
+  nu::AsarArchive::FileInfo info;
+  ASSERT_TRUE(archive->GetFileInfo("b.txt", &info));
+  base::span<const uint8_t> data = archive->GetFileData(info);
+  EXPECT_EQ(std::string(data.begin(), data.end()), "second");
+  info.size = 1000;
+  EXPECT_TRUE(archive->GetFileData(info).empty());
+}
+
+TEST_F(AsarArchiveTest, ProtocolMappedJob) {
+  std::string content(10000, 'x');
+  ASSERT_TRUE(nu::WriteAsarArchive(path_, {{"dir/index.html", content}}));
+  scoped_refptr<nu::ProtocolJob> job =
+      base::MakeRefCounted<nu::ProtocolMappedJob>(path_, "dir/index.html");
+  int content_length = -1;
+  job->Plug([&](int size) { content_length = size; });
+  ASSERT_TRUE(job->Start());
+  EXPECT_EQ(content_length, static_cast<int>(content.size()));
+  std::string mime_type;
+  ASSERT_TRUE(job->GetMimeType(&mime_type));
+  EXPECT_EQ(mime_type, "text/html");
+  base::span<const uint8_t> memory = job->GetMemory();
+  EXPECT_EQ(std::string(memory.begin(), memory.end()), content);
+
+  std::string result;
+  char buf[4096];
+  size_t nread;
+  while ((nread = job->Read(buf, sizeof(buf))) > 0)
+    result.append(buf, nread);
+  EXPECT_EQ(result, content);
+
+  scoped_refptr<nu::ProtocolJob> missing =
+      base::MakeRefCounted<nu::ProtocolMappedJob>(path_, "none.html");
+  missing->Plug([](int) {});
+  EXPECT_FALSE(missing->Start());
+}
+
+TEST_F(AsarArchiveTest, Integrity) {
+  std::string content;
+  for (int i = 0; i < 1000; ++i)
+    content.push_back('a' + i % 26);
+  ASSERT_TRUE(nu::WriteAsarArchive(path_, {{"a.txt", content},
+                                           {"empty.txt", ""}}, 64));
+  nu::AsarArchive::FileInfo info;
+  ASSERT_TRUE(Open()->GetFileInfo("a.txt", &info));
+  ASSERT_TRUE(info.integrity);
+  EXPECT_EQ(info.integrity->block_size, 64u);
+  EXPECT_EQ(info.integrity->blocks.size(), 16u);
+  auto data = base::as_bytes(base::make_span(content));
+  EXPECT_TRUE(nu::AsarArchive::VerifyBlock(info, 0, data.first(64)));
+  EXPECT_FALSE(nu::AsarArchive::VerifyBlock(info, 1, data.first(64)));
+  EXPECT_TRUE(nu::AsarArchive::VerifyBlock(info, 15, data.subspan(960)));
+
+  scoped_refptr<nu::ProtocolJob> asar_job =
+      base::MakeRefCounted<nu::ProtocolAsarJob>(path_, "a.txt");
+  EXPECT_EQ(ReadJob(asar_job.get()), content);
+  EXPECT_FALSE(asar_job->IsFailed());
+  scoped_refptr<nu::ProtocolJob> mapped_job =
+      base::MakeRefCounted<nu::ProtocolMappedJob>(path_, "a.txt");
+  EXPECT_EQ(ReadJob(mapped_job.get()), content);
+  EXPECT_FALSE(mapped_job->IsFailed());
+  // The verified file is served from memory.
+  base::span<const uint8_t> memory = mapped_job->GetMemory();
+  EXPECT_EQ(std::string(memory.begin(), memory.end()), content);
+  EXPECT_EQ(ReadJob(base::MakeRefCounted<nu::ProtocolAsarJob>(
+                path_, "empty.txt").get()), "");
+}
+
+TEST_F(AsarArchiveTest, CorruptedIntegrity) {
+  std::string content(1000, 'x');
+  ASSERT_TRUE(nu::WriteAsarArchive(path_, {{"a.txt", content}}, 64));
+  CorruptFile("a.txt", 700);
+
+  // Blocks before the corrupted one are served, and then the job fails.
+  scoped_refptr<nu::ProtocolJob> asar_job =
+      base::MakeRefCounted<nu::ProtocolAsarJob>(path_, "a.txt");
+  std::string result = ReadJob(asar_job.get());
+  EXPECT_LE(result.size(), 640u);
+  EXPECT_EQ(result, content.substr(0, result.size()));
+  EXPECT_TRUE(asar_job->IsFailed());
+  scoped_refptr<nu::ProtocolJob> mapped_job =
+      base::MakeRefCounted<nu::ProtocolMappedJob>(path_, "a.txt");
+  result = ReadJob(mapped_job.get());
+  EXPECT_LE(result.size(), 640u);
+  EXPECT_EQ(result, content.substr(0, result.size()));
+  EXPECT_TRUE(mapped_job->IsFailed());
+
+  // The whole file can not be served from memory.
+  scoped_refptr<nu::ProtocolJob> job =
+      base::MakeRefCounted<nu::ProtocolMappedJob>(path_, "a.txt");
+  job->Plug([](int) {});
+  ASSERT_TRUE(job->Start());
+  EXPECT_TRUE(job->GetMemory().empty());
+}
+
+TEST_F(AsarArchiveTest, EncryptedFile) {
+  const std::string key = "0123456789abcdef";
+  const std::string iv = "fedcba9876543210";
+  std::string content;
+  for (int i = 0; i < 5000; ++i)
+    content.push_back('a' + i % 26);
+  ASSERT_TRUE(nu::WriteAsarArchive(
+      path_, {{"a.txt", nu::EncryptAsarContent(content, key, iv)}}, 1024));
+  auto job = base::MakeRefCounted<nu::ProtocolAsarJob>(path_, "a.txt");
+  ASSERT_TRUE(job->SetDecipher(key, iv));
+  EXPECT_EQ(ReadJob(job.get()), content);
+}
+
+TEST_F(AsarArchiveTest, EncryptedFileRandomReads) {
+  const std::string key = "0123456789abcdef";
+  const std::string iv = "fedcba9876543210";
+  std::mt19937 rng(42);
+  std::map<std::string, std::string> contents;
+  std::map<std::string, std::string> files;
+  for (size_t size : {0, 1, 15, 16, 17, 1000, 65536, 65537, 200000}) {
+    std::string content(size, 0);
+    for (char& c : content)
+      c = static_cast<char>(rng());
+    std::string name = std::to_string(size) + ".bin";
+    contents[name] = content;
+    files[name] = nu::EncryptAsarContent(content, key, iv);
+  }
+  ASSERT_TRUE(nu::WriteAsarArchive(path_, files));
+
+  for (int round = 0; round < 5; ++round) {
+    for (const auto& [name, content] : contents) {
+      auto job = base::MakeRefCounted<nu::ProtocolAsarJob>(path_, name);
+      ASSERT_TRUE(job->SetDecipher(key, iv));
+      job->Plug([](int) {});
+      ASSERT_TRUE(job->Start());
+      // Read with sizes that are not aligned to blocks, including reads
+      // smaller than one block.
+      std::string result;
+      std::vector<char> buf(100000);
+      while (true) {
+        size_t size = 1 + rng() % (round % 2 ? 20 : buf.size());
+        size_t nread = job->Read(buf.data(), size);
+        ASSERT_LE(nread, size);
+        if (nread == 0)
+          break;
+        result.append(buf.data(), nread);
+      }
+      EXPECT_EQ(result, content) << name;
+      EXPECT_FALSE(job->IsFailed()) << name;
+    }
+  }
+}
+
+TEST_F(AsarArchiveTest, EncryptedFileInvalidPaddings) {
+  const std::string key = "0123456789abcdef";
+  const std::string iv = "fedcba9876543210";
+  // Encrypt data whose last byte is not a valid padding.
+  std::string data(64, 'x');
+  data.back() = 17;
+  nu::AES aes;
+  ASSERT_TRUE(aes.Init(key, iv));
+  aes.CBCEncryptBuffer(reinterpret_cast<uint8_t*>(&data[0]), data.size());
+  ASSERT_TRUE(nu::WriteAsarArchive(path_, {{"a.txt", data}}));
+  auto job = base::MakeRefCounted<nu::ProtocolAsarJob>(path_, "a.txt");
+  ASSERT_TRUE(job->SetDecipher(key, iv));
+  // The data decrypted with the invalid last block is not served.
+  EXPECT_EQ(ReadJob(job.get()), "");
+  EXPECT_TRUE(job->IsFailed());
+}
+
+TEST_F(AsarArchiveTest, EncryptedFileNotAligned) {
+  const std::string key = "0123456789abcdef";
+  const std::string iv = "fedcba9876543210";
+  std::string data = nu::EncryptAsarContent(std::string(100, 'x'), key, iv);
+  data.pop_back();
+  ASSERT_TRUE(nu::WriteAsarArchive(path_, {{"a.txt", data}}));
+  auto job = base::MakeRefCounted<nu::ProtocolAsarJob>(path_, "a.txt");
+  ASSERT_TRUE(job->SetDecipher(key, iv));
+  ReadJob(job.get());
+  EXPECT_TRUE(job->IsFailed());
+}
+
+TEST_F(AsarArchiveTest, CompressedFile) {
+  std::string content;
+  for (int i = 0; i < 3000; ++i)
+    content += "<p>" + std::to_string(i % 17) + "</p>\n";
+  std::string compressed = nu::CompressAsarContent(content);
+  ASSERT_LT(compressed.size(), content.size());
+  ASSERT_TRUE(nu::WriteAsarArchive(path_, {{"a.html", compressed}}, 256,
+                                   {{"a.html", content.size()}}));
+  nu::AsarArchive::FileInfo info;
+  ASSERT_TRUE(Open()->GetFileInfo("a.html", &info));
+  EXPECT_TRUE(info.compressed);
+  EXPECT_EQ(info.size, compressed.size());
+  EXPECT_EQ(info.uncompressed_size, static_cast<int64_t>(content.size()));
+
+  scoped_refptr<nu::ProtocolJob> jobs[] = {
+      base::MakeRefCounted<nu::ProtocolAsarJob>(path_, "a.html"),
+      base::MakeRefCounted<nu::ProtocolMappedJob>(path_, "a.html"),
+  };
+  for (auto& job : jobs) {
+    int content_length = 0;
+    job->Plug([&](int length) { content_length = length; });
+    ASSERT_TRUE(job->Start());
+    EXPECT_EQ(content_length, static_cast<int>(content.size()));
+    // Compressed files are always streamed.
+    EXPECT_TRUE(job->GetMemory().empty());
+    std::string result;
+    char buf[1000];
+    size_t nread;
+    while ((nread = job->Read(buf, sizeof(buf))) > 0)
+      result.append(buf, nread);
+    EXPECT_EQ(result, content);
+    EXPECT_FALSE(job->IsFailed());
+  }
+}
+
+TEST_F(AsarArchiveTest, CorruptedCompressedFile) {
+  std::string content(5000, 'x');
+  std::string compressed = nu::CompressAsarContent(content);
+  // Truncate the deflate stream.
+  compressed.resize(compressed.size() / 2);
+  ASSERT_TRUE(nu::WriteAsarArchive(path_, {{"a.html", compressed}}, 0,
+                                   {{"a.html", content.size()}}));
+  scoped_refptr<nu::ProtocolJob> jobs[] = {
+      base::MakeRefCounted<nu::ProtocolAsarJob>(path_, "a.html"),
+      base::MakeRefCounted<nu::ProtocolMappedJob>(path_, "a.html"),
+  };
+  for (auto& job : jobs) {
+    EXPECT_LT(ReadJob(job.get()).size(), content.size());
+    EXPECT_TRUE(job->IsFailed());
+  }
+}
+
+TEST_F(AsarArchiveTest, CompressedEncryptedFileRandomReads) {
+  const std::string key = "0123456789abcdef";
+  const std::string iv = "fedcba9876543210";
+  std::mt19937 rng(7);
+  std::map<std::string, std::string> contents;
+  std::map<std::string, std::string> files;
+  std::map<std::string, size_t> sizes;
+  for (size_t size : {0, 1, 100, 65536, 300000}) {
+    // Random text of few letters that compresses.
+    std::string content(size, 0);
+    for (char& c : content)
+      c = 'a' + rng() % 4;
+    std::string name = std::to_string(size) + ".txt";
+    contents[name] = content;
+    files[name] = nu::EncryptAsarContent(nu::CompressAsarContent(content),
+                                         key, iv);
+    sizes[name] = size;
+  }
+  ASSERT_TRUE(nu::WriteAsarArchive(path_, files, 4096, sizes));
+
+  for (const auto& [name, content] : contents) {
+    auto job = base::MakeRefCounted<nu::ProtocolAsarJob>(path_, name);
+    ASSERT_TRUE(job->SetDecipher(key, iv));
+    job->Plug([](int) {});
+    ASSERT_TRUE(job->Start());
+    std::string result;
+    std::vector<char> buf(100000);
+    while (true) {
+      size_t size = 1 + rng() % buf.size();
+      size_t nread = job->Read(buf.data(), size);
+      ASSERT_LE(nread, size);
+      if (nread == 0)
+        break;
+      result.append(buf.data(), nread);
+    }
+    EXPECT_EQ(result, content) << name;
+  }
+}
+
+TEST_F(AsarArchiveTest, TruncatedCompressedFile) {
+  std::string content(100000, 0);
+  for (size_t i = 0; i < content.size(); ++i)
+    content[i] = 'a' + (i * i) % 7;
+  std::string compressed = nu::CompressAsarContent(content);
+  compressed.resize(compressed.size() / 2);
+  ASSERT_TRUE(nu::WriteAsarArchive(path_, {{"a.txt", compressed}}, 0,
+                                   {{"a.txt", content.size()}}));
+  // Only the data before the end of stream is served.
+  for (bool mapped : {false, true}) {
+    scoped_refptr<nu::ProtocolJob> job;
+    if (mapped)
+      job = base::MakeRefCounted<nu::ProtocolMappedJob>(path_, "a.txt");
+    else
+      job = base::MakeRefCounted<nu::ProtocolAsarJob>(path_, "a.txt");
+    std::string result = ReadJob(job.get());
+    EXPECT_LT(result.size(), content.size());
+    EXPECT_EQ(result, content.substr(0, result.size()));
+  }
+}
+
+namespace {
+
+// Decompress |compressed| which is fed to inflater in chunks of |chunk_size|.
+std::string Inflate(const std::vector<uint8_t>& compressed,
+                    size_t chunk_size,
+                    bool* finished) {
+  size_t pos = 0;
+  nu::Inflater inflater([&](uint8_t* buf, size_t size) {
+    size_t n = std::min({size, chunk_size, compressed.size() - pos});
+    memcpy(buf, compressed.data() + pos, n);
+    pos += n;
+    return n;
+  });
+  std::string result;
+  char buf[37];
+  size_t nread;
+  while ((nread = inflater.Read(reinterpret_cast<uint8_t*>(buf),
+                                sizeof(buf))) > 0)
+    result.append(buf, nread);
+  *finished = inflater.IsFinished();
+  return result;
+}
+
+}  // namespace
+
+TEST(InflaterTest, DynamicBlock) {
+  // Generated by zlib with level 9.
+  const std::vector<uint8_t> compressed = {
+      0x3d, 0x8e, 0x81, 0x0d, 0x00, 0x31, 0x08, 0x02, 0x67, 0x05, 0xf6, 0xdf,
+      0xe1, 0xe1, 0x6c, 0xbe, 0xa6, 0x6a, 0x01, 0xb1, 0xb6, 0x95, 0x28, 0xb2,
+      0xd3, 0xd0, 0x9d, 0x02, 0x06, 0x93, 0xa8, 0x95, 0x94, 0x6f, 0x75, 0xa1,
+      0x81, 0xbd, 0x85, 0xd6, 0xa6, 0x2f, 0x48, 0xd8, 0x3f, 0x9d, 0x41, 0xa9,
+      0x9c, 0xc9, 0x32, 0x2e, 0xc6, 0xe2, 0xe9, 0x83, 0x8f, 0xe8, 0x19, 0xc4,
+      0x52, 0xa4, 0xd1, 0x6c, 0x1e, 0x3a, 0x39, 0x4b, 0x6f, 0x2a, 0xfc, 0x28,
+      0x4f, 0x3b, 0xf2, 0x03,
+  };
+  std::string expected;
+  uint32_t x = 1;
+  for (int i = 0; i < 200; ++i) {
+    x = (x * 1103515245 + 12345) & 0x7fffffff;
+    expected.push_back('a' + ((x >> 16) % 7) / 3);
+  }
+  for (size_t chunk_size : {1, 3, 1000}) {
+    bool finished = false;
+    EXPECT_EQ(Inflate(compressed, chunk_size, &finished), expected);
+    EXPECT_TRUE(finished);
+  }
+}
+
+TEST(InflaterTest, StoredBlocks) {
+  // Two stored blocks, the second one is final.
+  const std::vector<uint8_t> compressed = {
+      0x00, 0x03, 0x00, 0xfc, 0xff, 'a', 'b', 'c',
+      0x01, 0x02, 0x00, 0xfd, 0xff, 'd', 'e',
+  };
+  bool finished = false;
+  EXPECT_EQ(Inflate(compressed, 1, &finished), "abcde");
+  EXPECT_TRUE(finished);
+  // Length does not match its complement.
+  std::vector<uint8_t> invalid = compressed;
+  invalid[3] = 0;
+  EXPECT_EQ(Inflate(invalid, 100, &finished), "");
+  EXPECT_FALSE(finished);
+}
+
+TEST(InflaterTest, InvalidDistance) {
+  // A fixed block starting with a back reference.
+  std::vector<uint8_t> compressed = {0x03, 0x02};
+  bool finished = true;
+  EXPECT_EQ(Inflate(compressed, 100, &finished), "");
+  EXPECT_FALSE(finished);
+}
+
+TEST(AESTest, HardwareMatchesSoftware) {
+  const std::string key = "0123456789abcdef";
+  const std::string iv = "fedcba9876543210";
+  std::vector<uint8_t> plain(16 * 1000);
+  for (size_t i = 0; i < plain.size(); ++i)
+    plain[i] = static_cast<uint8_t>(i * 7 + i / 13);
+  std::vector<uint8_t> cipher = plain;
+  nu::AES encryptor;
+  ASSERT_TRUE(encryptor.Init(key, iv));
+  encryptor.CBCEncryptBuffer(cipher.data(), cipher.size());
+
+  for (bool hardware : {false, true}) {
+    nu::AES aes;
+    ASSERT_TRUE(aes.Init(key, iv, hardware));
+    if (hardware && !aes.IsHardwareAccelerated())
+      continue;
+    // Decrypt in chunks of different sizes to test the chaining.
+    std::vector<uint8_t> data = cipher;
+    size_t pos = 0;
+    for (size_t blocks : {1, 3, 8, 9, 17, 100}) {
+      aes.CBCDecryptBuffer(data.data() + pos, blocks * 16);
+      pos += blocks * 16;
+    }
+    aes.CBCDecryptBuffer(data.data() + pos, data.size() - pos);
+    EXPECT_EQ(data, plain) << "hardware: " << hardware;
+  }
+}
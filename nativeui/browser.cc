@@ -9,13 +9,39 @@
 
 #include "base/base64.h"
 #include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
 #include "base/json/string_escape.h"
 #include "base/logging.h"
 #include "base/rand_util.h"
 #include "base/strings/stringprintf.h"
+#include "nativeui/message_loop.h"
 
 namespace nu {
 
+namespace {
+
+// Interval of delivering messages to web page, which is about one frame.
+const int kMessageFlushInterval = 16;
+
+// Return the code posting |message| to the native side.
+std::string GetPostMessageCode(const std::string& message) {
+#if defined(OS_LINUX)
+  // WebKitGTK converts the posted value directly, so ArrayBuffers do not go
+  // through JSON. Values that can not be cloned still fall back to JSON.
+  return base::StringPrintf(
+      "try {"
+      "  external.postMessage(%s);"
+      "} catch (e) {"
+      "  external.postMessage(JSON.stringify(%s));"
+      "}",
+      message.c_str(), message.c_str());
+#else
+  return "external.postMessage(JSON.stringify(" + message + "));";
+#endif
+}
+
+}  // namespace
+
 Cookie::Cookie(std::string name, std::string value, std::string domain,
                std::string path, bool http_only, bool secure)
     : name(std::move(name)), value(std::move(value)), domain(std::move(domain)),
@@ -28,7 +54,19 @@ Cookie::~Cookie() = default;
 // static
 const char Browser::kClassName[] = "Browser";
 
-Browser::Browser(Options options) {
+// static
+bool Browser::RegisterProtocol(const std::string& scheme,
+                               ProtocolHandler handler) {
+  return PlatformRegisterProtocol(scheme, std::move(handler), false);
+}
+
+// static
+bool Browser::RegisterThreadSafeProtocol(const std::string& scheme,
+                                         ProtocolHandler handler) {
+  return PlatformRegisterProtocol(scheme, std::move(handler), true);
+}
+
+Browser::Browser(Options options) : weak_factory_(this) {
   PlatformInit(std::move(options));
   // Generate a random number as security key.
   security_key_ = base::Base64Encode(base::RandBytesAsString(16));
@@ -53,7 +91,18 @@ void Browser::AddRawBinding(const std::string& name, BindingFunc func) {
     return;
   std::string escaped;
   base::EscapeJSONString(name, false, &escaped);
-  bindings_[escaped] = std::move(func);
+  bindings_[escaped] = {std::move(func), nullptr};
+  if (!is_adding_bindings_ && !stop_serving_)
+    PlatformUpdateBindings();
+}
+
+void Browser::AddRawAsyncBinding(const std::string& name,
+                                 AsyncBindingFunc func) {
+  if (name.empty())
+    return;
+  std::string escaped;
+  base::EscapeJSONString(name, false, &escaped);
+  bindings_[escaped] = {nullptr, std::move(func)};
   if (!is_adding_bindings_ && !stop_serving_)
     PlatformUpdateBindings();
 }
@@ -88,32 +137,120 @@ bool Browser::InvokeBindings(const std::string& json_str) {
     return false;
 
   std::optional<base::Value> tup = base::JSONReader::Read(json_str);
-  if (!tup)
-    return false;
-  if (!tup->is_list() || tup->GetList().size() != 3 ||
-      !tup->GetList()[0].is_string() ||
-      !tup->GetList()[1].is_string() ||
-      !tup->GetList()[2].is_list())
+  if (!tup || !tup->is_list())
     return false;
+  return InvokeBindings(std::move(*tup).TakeList());
+}
 
-  const std::string& key = tup->GetList()[0].GetString();
-  const std::string& method = tup->GetList()[1].GetString();
-  base::Value args = std::move(tup->GetList()[2]);
+bool Browser::InvokeBindings(base::Value::List tup) {
+  if (stop_serving_)
+    return false;
 
-  if (key != security_key_) {
+  if (tup.empty() || !tup[0].is_string())
+    return false;
+  if (tup[0].GetString() != security_key_) {
     stop_serving_ = true;
     LOG(ERROR) << "Recevied invalid key, stop serving navite bindings";
     return false;
   }
-  auto it = bindings_.find(method);
-  if (it == bindings_.end()) {
-    LOG(ERROR) << "Invoking invalid method: " << method;
+  if (tup.size() != 2 || !tup[1].is_list())
     return false;
+
+  // The handlers might release the browser.
+  scoped_refptr<Browser> self(this);
+  // Calls made in one task of web page are sent in one batch.
+  for (base::Value& call : tup[1].GetList()) {
+    if (stop_serving_)
+      return false;
+    if (!call.is_list() || call.GetList().size() != 3 ||
+        !call.GetList()[0].is_string() ||
+        !call.GetList()[1].is_list())
+      return false;
+    const std::string& method = call.GetList()[0].GetString();
+    base::Value args = std::move(call.GetList()[1]);
+    // The id is only set for calls waiting for replies.
+    std::string id;
+    if (!call.GetList()[2].is_none())
+      base::JSONWriter::Write(call.GetList()[2], &id);
+
+    auto it = bindings_.find(method);
+    if (it == bindings_.end()) {
+      LOG(ERROR) << "Invoking invalid method: " << method;
+      if (!id.empty())
+        ReplyBinding(id, false, base::Value("Invoking invalid method"));
+      continue;
+    }
+    if (it->second.async_func) {
+      BindingReply reply;
+      if (!id.empty()) {
+        reply = [weak = weak_factory_.GetWeakPtr(), id](base::Value result) {
+          if (weak)
+            weak->ReplyBinding(id, true, result);
+        };
+      } else {
+        reply = [](base::Value) {};
+      }
+      it->second.async_func(this, std::move(args), std::move(reply));
+    } else {
+      it->second.func(this, std::move(args));
+    }
   }
-  it->second(this, std::move(args));
   return true;
 }
 
+bool Browser::PostMessageToPage(base::Value message) {
+  std::string json;
+  if (!base::JSONWriter::Write(message, &json))
+    return false;
+  if (pending_messages_.empty()) {
+    MessageLoop::PostDelayedTask(kMessageFlushInterval,
+                                 [weak = weak_factory_.GetWeakPtr()]() {
+      if (weak)
+        weak->FlushMessagesToPage();
+    });
+  } else {
+    pending_messages_ += ',';
+  }
+  pending_messages_ += json;
+  return true;
+}
+
+void Browser::FlushMessagesToPage() {
+  if (pending_messages_.empty())
+    return;
+  // One script delivers all messages of the frame, so the cost of compiling
+  // scripts does not grow with the number of messages.
+  std::string code =
+      "(function(messages) {"
+      "  for (var i = 0; i < messages.length; ++i) {"
+      "    var event;"
+      "    if (typeof MessageEvent == 'function') {"
+      "      event = new MessageEvent('message', {data: messages[i]});"
+      "    } else {"
+      "      event = document.createEvent('MessageEvent');"
+      "      event.initMessageEvent('message', false, false, messages[i],"
+      "                             '', '', null);"
+      "    }"
+      "    window.dispatchEvent(event);"
+      "  }"
+      "})([";
+  code += pending_messages_;
+  code += "]);";
+  pending_messages_.clear();
+  ExecuteJavaScript(code, nullptr);
+}
+
+void Browser::ReplyBinding(const std::string& id, bool success,
+                           const base::Value& result) {
+  std::string json;
+  if (!base::JSONWriter::Write(result, &json))
+    json = "null";
+  ExecuteJavaScript(
+      base::StringPrintf("window.__yueReply && window.__yueReply(%s, %s, %s)",
+                         id.c_str(), success ? "true" : "false", json.c_str()),
+      nullptr);
+}
+
 std::string Browser::GetBindingScript() {
   std::string code = "(function(key, external, binding) {";
   std::string name = binding_name_;
@@ -124,14 +261,55 @@ std::string Browser::GetBindingScript() {
     name = base::StringPrintf("window[\"%s\"]", name.c_str());
     code = name + " = {};" + code;
   }
-  // Insert bindings.
+  // Calls made in one task are queued and sent in one message in a
+  // microtask, async calls get promises resolved by window.__yueReply. Old
+  // IE has no Promise, where async calls return nothing.
+  code += base::StringPrintf(
+      "var queue = null;"
+      "var pending = {};"
+      // Start from a random id so replies to previous page are ignored.
+      "var lastId = Math.floor(Math.random() * 1e9);"
+      "function flush() {"
+      "  var calls = queue;"
+      "  queue = null;"
+      "  %s"
+      "}"
+      "function call(name, args, async) {"
+      "  var id = null;"
+      "  var result;"
+      "  if (async && typeof Promise != 'undefined') {"
+      "    id = ++lastId;"
+      "    result = new Promise(function(resolve, reject) {"
+      "      pending[id] = [resolve, reject];"
+      "    });"
+      "  }"
+      "  if (!queue) {"
+      "    queue = [];"
+      "    if (typeof Promise == 'undefined')"
+      "      setTimeout(flush, 0);"
+      "    else"
+      "      Promise.resolve().then(flush);"
+      "  }"
+      "  queue.push([name, args, id]);"
+      "  return result;"
+      "}"
+      "Object.defineProperty(window, '__yueReply', {"
+      "  configurable: true,"
+      "  value: function(id, success, result) {"
+      "    var p = pending[id];"
+      "    if (!p) return;"
+      "    delete pending[id];"
+      "    if (success) p[0](result); else p[1](new Error(result));"
+      "  }"
+      "});",
+      GetPostMessageCode("[key, calls]").c_str());
   for (const auto& it : bindings_) {
     code += base::StringPrintf(
         "binding[\"%s\"] = function() {"
-        "  var args = Array.prototype.slice.call(arguments);"
-        "  external.postMessage(JSON.stringify([key, \"%s\", args]));"
+        "  return call(\"%s\", Array.prototype.slice.call(arguments), %s);"
         "};",
-        it.first.c_str(), it.first.c_str());
+        it.first.c_str(), it.first.c_str(),
+        it.second.async_func ? "true" : "false");
   }
   code += base::StringPrintf("})(\"%s\", %s, %s);",
                              security_key_.c_str(),
@@ -10,6 +10,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/memory/weak_ptr.h"
 #include "base/values.h"
 #include "nativeui/protocol_job.h"
 #include "nativeui/util/function_caller.h"
@@ -38,6 +39,10 @@ class NATIVEUI_EXPORT Browser : public View {
   using ExecutionCallback = std::function<void(bool, base::Value)>;
   using CookiesCallback = std::function<void(std::vector<Cookie>)>;
   using BindingFunc = std::function<void(Browser*, base::Value)>;
+  // Resolves the promise returned by an async binding with the result.
+  using BindingReply = std::function<void(base::Value)>;
+  using AsyncBindingFunc =
+      std::function<void(Browser*, base::Value, BindingReply)>;
 
   struct Options {
     bool devtools = false;
@@ -63,6 +68,10 @@ class NATIVEUI_EXPORT Browser : public View {
   // Protocol APIs.
   static bool RegisterProtocol(const std::string& scheme,
                                ProtocolHandler handler);
+  // Like RegisterProtocol, but the |handler| is called in the thread pool so
+  // creating jobs does not block the GUI thread.
+  static bool RegisterThreadSafeProtocol(const std::string& scheme,
+                                         ProtocolHandler handler);
   static void UnregisterProtocol(const std::string& scheme);
 
   // View:
@@ -86,6 +95,10 @@ class NATIVEUI_EXPORT Browser : public View {
   void GetCookiesForURL(const std::string& url,
                         const CookiesCallback& callback);
 
+  // Send |message| to the web page, where it is received as a "message" event
+  // of window. Messages posted in one frame are delivered together.
+  bool PostMessageToPage(base::Value message);
+
   void GoBack();
   bool CanGoBack() const;
   void GoForward();
@@ -96,6 +109,9 @@ class NATIVEUI_EXPORT Browser : public View {
 
   void SetBindingName(const std::string& name);
   void AddRawBinding(const std::string& name, BindingFunc func);
+  // The binding returns a promise in web page, which is resolved when the
+  // |func| calls the reply, on the GUI thread.
+  void AddRawAsyncBinding(const std::string& name, AsyncBindingFunc func);
   void RemoveBinding(const std::string& name);
   bool HasBindings() const;
   void BeginAddingBindings();
@@ -117,8 +133,31 @@ class NATIVEUI_EXPORT Browser : public View {
     AddBinding(name, std::function<RunType>(func));
   }
 
+  // Like AddBinding, but the first parameter of |func| is the reply that
+  // resolves the promise returned in web page.
+  template<typename... Args>
+  void AddAsyncBinding(const std::string& name,
+                       std::function<void(BindingReply, Args...)> func) {
+    AddRawAsyncBinding(name, [func = std::move(func)](nu::Browser* browser,
+                                                      base::Value args,
+                                                      BindingReply reply) {
+      internal::Dispatcher<void(Args...)>::DispatchToCallback(
+          [&func, &reply](Args... rest) {
+            func(std::move(reply), std::move(rest)...);
+          }, browser, std::move(args));
+    });
+  }
+  template<typename T>
+  void AddAsyncBinding(const std::string& name, T func) {
+    using RunType = typename internal::FunctorTraits<T>::RunType;
+    AddAsyncBinding(name, std::function<RunType>(func));
+  }
+
   // Internal: Called from web pages to invoke native bindings.
   bool InvokeBindings(const std::string& json_arg);
+  // Internal: Like above, but with the message already converted from the
+  // JavaScript value, which is in the form of [key, [[method, args, id]...]].
+  bool InvokeBindings(base::Value::List message);
 
   // Internal: Generate the user script to inject bindings.
   std::string GetBindingScript();
@@ -154,10 +193,21 @@ class NATIVEUI_EXPORT Browser : public View {
 #endif
 
  private:
+  static bool PlatformRegisterProtocol(const std::string& scheme,
+                                       ProtocolHandler handler,
+                                       bool thread_safe);
+
   void PlatformInit(Options options);
   void PlatformDestroy();
   void PlatformUpdateBindings();
 
+  // Deliver the messages posted since last frame to the web page.
+  void FlushMessagesToPage();
+
+  // Resolve or reject the promise of async binding call with |id|.
+  void ReplyBinding(const std::string& id, bool success,
+                    const base::Value& result);
+
   // Prevent malicous calls to native bindings.
   std::string security_key_;
   bool stop_serving_ = false;
@@ -167,9 +217,20 @@ class NATIVEUI_EXPORT Browser : public View {
   std::function<void()> pending_load_;
 #endif
 
+  struct Binding {
+    BindingFunc func;
+    // Set for bindings that return promises.
+    AsyncBindingFunc async_func;
+  };
+
   std::string binding_name_;
-  std::map<std::string, BindingFunc> bindings_;
+  std::map<std::string, Binding> bindings_;
   bool is_adding_bindings_ = false;
+
+  // Messages in JSON separated by commas, waiting to be delivered.
+  std::string pending_messages_;
+
+  base::WeakPtrFactory<Browser> weak_factory_;
 };
 
 }  // namespace nu
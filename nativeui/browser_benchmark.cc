@@ -0,0 +1,94 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <functional>
+#include <string>
+
+#include "base/json/json_writer.h"
+#include "base/strings/stringprintf.h"
+#include "nativeui/browser.h"
+#include "nativeui/message_loop.h"
+#include "nativeui/test/benchmark.h"
+
+namespace {
+
+// Call a native binding 1000 times from the web page with a 64KB payload,
+// which is an ArrayBuffer when |range| is 1 or a string otherwise.
+void BM_BrowserBindingCall(nu::BenchmarkState* state) {
+  const int kCalls = 1000;
+  const int kPayloadSize = 64 * 1024;
+  bool binary = state->range(0);
+  scoped_refptr<nu::Browser> browser = new nu::Browser(nu::Browser::Options());
+  int received = 0;
+  std::function<void(base::Value)> call = [&](base::Value payload) {
+    CHECK(binary ? payload.is_blob() : payload.is_string());
+    if (++received == kCalls)
+      nu::MessageLoop::Quit();
+  };
+  browser->AddBinding("call", call);
+  browser->on_finish_navigation.Connect([](nu::Browser*, const std::string&) {
+    nu::MessageLoop::Quit();
+  });
+  browser->LoadHTML(base::StringPrintf(
+      "<script>window.payload = %s;</script>",
+      binary ? "new ArrayBuffer(65536)" : "'x'.repeat(65536)"),
+      "about:blank");
+  nu::MessageLoop::Run();
+
+  std::string code = base::StringPrintf(
+      "for (var i = 0; i < %d; ++i) window.call(window.payload);", kCalls);
+  while (state->KeepRunning()) {
+    received = 0;
+    browser->ExecuteJavaScript(code, nullptr);
+    nu::MessageLoop::Run();
+  }
+  state->SetItemsProcessed(state->iterations() * kCalls);
+  state->SetBytesProcessed(state->iterations() * kCalls * kPayloadSize);
+  state->SetLabel(binary ? "arraybuffer" : "string");
+}
+
+NU_BENCHMARK(BM_BrowserBindingCall)->Arg(0)->Arg(1);
+
+// Push 1000 small messages to the web page, with PostMessageToPage when
+// |range| is 1 or with one ExecuteJavaScript per message otherwise.
+void BM_BrowserPostMessageToPage(nu::BenchmarkState* state) {
+  const int kMessages = 1000;
+  bool post_message = state->range(0);
+  scoped_refptr<nu::Browser> browser = new nu::Browser(nu::Browser::Options());
+  browser->AddBinding("received", []() { nu::MessageLoop::Quit(); });
+  browser->on_finish_navigation.Connect([](nu::Browser*, const std::string&) {
+    nu::MessageLoop::Quit();
+  });
+  browser->LoadHTML(base::StringPrintf(
+      "<script>"
+      "var count = 0;"
+      "window.addEventListener('message', function(event) {"
+      "  if (++count %% %d == 0) window.received();"
+      "});"
+      "</script>", kMessages), "about:blank");
+  nu::MessageLoop::Run();
+
+  while (state->KeepRunning()) {
+    for (int i = 0; i < kMessages; ++i) {
+      base::Value::Dict message;
+      message.Set("cpu", i);
+      message.Set("name", "metric");
+      if (post_message) {
+        browser->PostMessageToPage(base::Value(std::move(message)));
+      } else {
+        std::string json;
+        base::JSONWriter::Write(message, &json);
+        browser->ExecuteJavaScript(
+            "window.dispatchEvent(new MessageEvent('message', {data: " + json +
+            "}))", nullptr);
+      }
+    }
+    nu::MessageLoop::Run();
+  }
+  state->SetItemsProcessed(state->iterations() * kMessages);
+  state->SetLabel(post_message ? "post_message" : "execute_javascript");
+}
+NU_BENCHMARK(BM_BrowserPostMessageToPage)->Arg(0)->Arg(1);
+
+}  // namespace
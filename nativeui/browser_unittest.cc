@@ -2,6 +2,11 @@
 // Use of this source code is governed by the license that can be found in the
 // LICENSE file.
 
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <vector>
+
 #include "base/base_paths.h"
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
@@ -9,6 +14,7 @@
 #include "base/path_service.h"
 #include "base/strings/stringprintf.h"
 #include "nativeui/nativeui.h"
+#include "nativeui/test/asar_util.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 enum TestOptions {
@@ -290,6 +296,78 @@ TEST_P(BrowserTest, ExecuteJavaScriptComplexResult) {
   nu::MessageLoop::Run();
 }
 
+#if defined(OS_LINUX)
+TEST_P(BrowserTest, ExecuteJavaScriptArrayBuffer) {
+  browser_->on_finish_navigation.Connect([](nu::Browser* browser,
+                                            const std::string& url) {
+    browser->ExecuteJavaScript(
+        "r = {b: new Uint8Array([1, 2, 3, 4]).subarray(1, 3),"
+        "     n: [1.5, -2, NaN], f: function() {}}; r",
+        [](bool success, base::Value result) {
+      nu::MessageLoop::Quit();
+      ASSERT_EQ(success, true);
+      ASSERT_TRUE(result.is_dict());
+      const base::Value* b = result.GetDict().Find("b");
+      ASSERT_TRUE(b && b->is_blob());
+      EXPECT_EQ(b->GetBlob(), std::vector<uint8_t>({2, 3}));
+      EXPECT_FALSE(result.GetDict().Find("f"));
+      std::string json;
+      ASSERT_TRUE(base::JSONWriter::Write(*result.GetDict().Find("n"), &json));
+      EXPECT_EQ(json, "[1.5,-2,null]");
+    });
+  });
+  nu::MessageLoop::PostTask([&]() {
+    browser_->LoadURL("about:blank");
+  });
+  nu::MessageLoop::Run();
+}
+
+TEST_P(BrowserTest, ExecuteJavaScriptHugeArray) {
+  browser_->on_finish_navigation.Connect([](nu::Browser* browser,
+                                            const std::string& url) {
+    browser->ExecuteJavaScript("r = {a: [1, new Array(4294967295)]}; r",
+                               [](bool success, base::Value result) {
+      nu::MessageLoop::Quit();
+      EXPECT_EQ(success, false);
+      EXPECT_TRUE(result.is_none());
+    });
+  });
+  nu::MessageLoop::PostTask([&]() {
+    browser_->LoadURL("about:blank");
+  });
+  nu::MessageLoop::Run();
+}
+#endif
+
+TEST_P(BrowserTest, PostMessageToPage) {
+  std::function<void(base::Value)> done = [](base::Value messages) {
+    nu::MessageLoop::Quit();
+    std::string json;
+    ASSERT_TRUE(base::JSONWriter::Write(messages, &json));
+    EXPECT_EQ(json, "[1,\"two\",{\"three\":[3]}]");
+  };
+  browser_->AddBinding("done", done);
+  browser_->on_finish_navigation.Connect([](nu::Browser* browser,
+                                            const std::string& url) {
+    browser->PostMessageToPage(base::Value(1));
+    browser->PostMessageToPage(base::Value("two"));
+    base::Value::Dict dict;
+    dict.Set("three", base::Value::List().Append(3));
+    browser->PostMessageToPage(base::Value(std::move(dict)));
+  });
+  nu::MessageLoop::PostTask([&]() {
+    browser_->LoadHTML(
+        "<body><script>"
+        "var messages = [];"
+        "window.addEventListener('message', function(event) {"
+        "  messages.push(event.data);"
+        "  if (messages.length == 3) window.done(messages);"
+        "});"
+        "</script></body>", "about:blank");
+  });
+  nu::MessageLoop::Run();
+}
+
 TEST_P(BrowserTest, GetCookiesForURL) {
 #if defined(OS_WIN)
   if (GetParam() == DEFAULT)
@@ -338,6 +416,126 @@ TEST_P(BrowserTest, AddBinding) {
   nu::MessageLoop::Run();
 }
 
+#if defined(OS_LINUX)
+TEST_P(BrowserTest, AddBindingArrayBuffer) {
+  std::function<void(std::vector<uint8_t>, base::Value)> handler =
+      [](std::vector<uint8_t> data, base::Value v) {
+    nu::MessageLoop::Quit();
+    ASSERT_EQ(data.size(), 65536u);
+    EXPECT_EQ(data[0], 0);
+    EXPECT_EQ(data[65535], 255);
+    ASSERT_TRUE(v.is_int());
+    EXPECT_EQ(v.GetInt(), 1);
+  };
+  browser_->AddBinding("method", handler);
+  browser_->on_finish_navigation.Connect([&](nu::Browser* browser,
+                                             const std::string& url) {
+    browser->ExecuteJavaScript(
+        "var a = new Uint8Array(65536);"
+        "for (var i = 0; i < a.length; ++i) a[i] = i % 256;"
+        "window.method(a.buffer, 1);",
+        nullptr);
+  });
+  nu::MessageLoop::PostTask([&]() {
+    browser_->LoadHTML("<body><script></script></body>", "about:blank");
+  });
+  nu::MessageLoop::Run();
+}
+#endif
+
+TEST_P(BrowserTest, AddRawAsyncBinding) {
+#if defined(OS_WIN)
+  // IE does not have Promise.
+  if (GetParam() == DEFAULT)
+    return;
+#if defined(WEBVIEW2_SUPPORT)
+  if (GetParam() == WEBVIEW2_IE)
+    return;
+#endif
+#endif
+  browser_->AddRawAsyncBinding("add", [](nu::Browser*, base::Value args,
+                                         nu::Browser::BindingReply reply) {
+    int sum = args.GetList()[0].GetInt() + args.GetList()[1].GetInt();
+    // Reply asynchronously.
+    nu::MessageLoop::PostTask([reply, sum]() {
+      reply(base::Value(sum));
+    });
+  });
+  browser_->AddRawBinding("done", [](nu::Browser*, base::Value args) {
+    nu::MessageLoop::Quit();
+    ASSERT_EQ(args.GetList().size(), 2u);
+    EXPECT_EQ(args.GetList()[0], base::Value(3));
+    EXPECT_EQ(args.GetList()[1], base::Value(7));
+  });
+  browser_->on_finish_navigation.Connect([&](nu::Browser* browser,
+                                             const std::string& url) {
+    browser->ExecuteJavaScript(
+        "Promise.all([window.add(1, 2), window.add(3, 4)])"
+        "       .then(function(r) { window.done(r[0], r[1]); })",
+        nullptr);
+  });
+  nu::MessageLoop::PostTask([&]() {
+    browser_->LoadHTML("<body><script></script></body>", "about:blank");
+  });
+  nu::MessageLoop::Run();
+}
+
+TEST_P(BrowserTest, AddAsyncBinding) {
+#if defined(OS_WIN)
+  // IE does not have Promise.
+  if (GetParam() == DEFAULT)
+    return;
+#if defined(WEBVIEW2_SUPPORT)
+  if (GetParam() == WEBVIEW2_IE)
+    return;
+#endif
+#endif
+  std::function<void(nu::Browser::BindingReply, std::string, int)> handler =
+      [](nu::Browser::BindingReply reply, std::string s, int i) {
+    nu::MessageLoop::PostTask([reply, s, i]() {
+      reply(base::Value(base::StringPrintf("%s%d", s.c_str(), i)));
+    });
+  };
+  browser_->AddAsyncBinding("join", handler);
+  browser_->AddRawBinding("done", [](nu::Browser*, base::Value args) {
+    nu::MessageLoop::Quit();
+    ASSERT_EQ(args.GetList().size(), 1u);
+    EXPECT_EQ(args.GetList()[0], base::Value("item8"));
+  });
+  browser_->on_finish_navigation.Connect([&](nu::Browser* browser,
+                                             const std::string& url) {
+    browser->ExecuteJavaScript(
+        "window.join('item', 8).then(function(r) { window.done(r); })",
+        nullptr);
+  });
+  nu::MessageLoop::PostTask([&]() {
+    browser_->LoadHTML("<body><script></script></body>", "about:blank");
+  });
+  nu::MessageLoop::Run();
+}
+
+TEST_P(BrowserTest, BatchedBindingCalls) {
+  std::vector<int> calls;
+  std::function<void(int)> handler = [&calls](int i) {
+    calls.push_back(i);
+    if (calls.size() == 100)
+      nu::MessageLoop::Quit();
+  };
+  browser_->AddBinding("method", handler);
+  browser_->on_finish_navigation.Connect([&](nu::Browser* browser,
+                                             const std::string& url) {
+    browser->ExecuteJavaScript("for (var i = 0; i < 100; ++i) window.method(i)",
+                               nullptr);
+  });
+  nu::MessageLoop::PostTask([&]() {
+    browser_->LoadHTML("<body><script></script></body>", "about:blank");
+  });
+  nu::MessageLoop::Run();
+  ASSERT_EQ(calls.size(), 100u);
+  for (int i = 0; i < 100; ++i)
+    EXPECT_EQ(calls[i], i);
+}
+
 TEST_P(BrowserTest, BeginAddingBindings) {
   browser_->BeginAddingBindings();
   browser_->AddBinding("method", []() {});
@@ -520,6 +718,74 @@ TEST_P(BrowserTest, LargeFileProtocol) {
   nu::MessageLoop::Run();
 }
 
+TEST_P(BrowserTest, ThreadSafeProtocol) {
+  // Write a page loading 1000 scripts into asar archive.
+  base::ScopedTempDir dir;
+  ASSERT_TRUE(dir.CreateUniqueTempDir());
+  base::FilePath asar = dir.GetPath().Append(FILE_PATH_LITERAL("app.asar"));
+  static constexpr int kScripts = 1000;
+  std::map<std::string, std::string> files;
+  std::string html = "<html><body>";
+  for (int i = 0; i < kScripts; ++i) {
+    std::string name = base::StringPrintf("s%d.js", i);
+    files[name] = "window.loaded = (window.loaded || 0) + 1;";
+    html += "<script src='" + name + "'></script>";
+  }
+  files["index.html"] = html + "</body></html>";
+  ASSERT_TRUE(nu::WriteAsarArchive(asar, files));
+  // Count the jobs created out of the GUI thread.
+  static std::atomic<int> off_main_jobs;
+  off_main_jobs = 0;
+  nu::Browser::RegisterThreadSafeProtocol("asyncasar", [=](
+      const std::string& url) {
+    if (!nu::TaskRunner::GetMain()->RunsTasksOnCurrentThread())
+      ++off_main_jobs;
+    return new nu::ProtocolAsarJob(asar, url.substr(16));
+  });
+#if defined(OS_WIN) && defined(WEBVIEW2_SUPPORT)
+  // Re-create Browser otherwise RegisterProtocol won't work.
+  if (browser_->IsWebView2())
+    browser_ = new nu::Browser(options_);
+#endif
+  // Measure the longest time the GUI thread is blocked.
+  static base::TimeTicks last_tick;
+  static base::TimeDelta max_gap;
+  static bool done;
+  last_tick = base::TimeTicks::Now();
+  max_gap = base::TimeDelta();
+  done = false;
+  nu::MessageLoop::SetTimer(10, []() {
+    base::TimeTicks now = base::TimeTicks::Now();
+    max_gap = std::max(max_gap, now - last_tick);
+    last_tick = now;
+    return !done;
+  });
+  browser_->on_finish_navigation.Connect([](nu::Browser* browser,
+                                            const std::string& url) {
+    browser->ExecuteJavaScript("window.loaded",
+                               [](bool success, base::Value result) {
+      done = true;
+      nu::Browser::UnregisterProtocol("asyncasar");
+      nu::MessageLoop::Quit();
+      ASSERT_TRUE(result.is_int());
+      EXPECT_EQ(result.GetInt(), kScripts);
+      EXPECT_LT(max_gap, base::Milliseconds(500));
+#if defined(OS_WIN)
+      // The IE backend must start requests synchronously so it calls handlers
+      // on the GUI thread, while WebView2 calls them in the thread pool.
+      if (browser->IsWebView2())
+        EXPECT_GT(off_main_jobs, 0);
+#else
+      EXPECT_GT(off_main_jobs, 0);
+#endif
+    });
+  });
+  nu::MessageLoop::PostTask([=, this]() {
+    browser_->LoadURL("asyncasar://app/index.html");
+  });
+  nu::MessageLoop::Run();
+}
+
 using ::testing::Values;
 
 #if defined(OS_WIN)
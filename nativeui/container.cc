@@ -9,6 +9,7 @@
 #include <utility>
 
 #include "base/logging.h"
+#include "nativeui/util/trace_event.h"
 #include "third_party/yoga/yoga/Yoga.h"
 
 namespace nu {
@@ -79,18 +80,21 @@ void Container::OnSizeChanged() {
 #endif
 
 SizeF Container::GetPreferredSize() const {
+  NU_TRACE_EVENT("layout", "YGNodeCalculateLayout");
   float nan = std::numeric_limits<float>::quiet_NaN();
   YGNodeCalculateLayout(node(), nan, nan, YGDirectionLTR);
   return SizeF(YGNodeLayoutGetWidth(node()), YGNodeLayoutGetHeight(node()));
 }
 
 float Container::GetPreferredHeightForWidth(float width) const {
+  NU_TRACE_EVENT("layout", "YGNodeCalculateLayout");
   float nan = std::numeric_limits<float>::quiet_NaN();
   YGNodeCalculateLayout(node(), width, nan, YGDirectionLTR);
   return YGNodeLayoutGetHeight(node());
 }
 
 float Container::GetPreferredWidthForHeight(float height) const {
+  NU_TRACE_EVENT("layout", "YGNodeCalculateLayout");
   float nan = std::numeric_limits<float>::quiet_NaN();
   YGNodeCalculateLayout(node(), nan, height, YGDirectionLTR);
   return YGNodeLayoutGetWidth(node());
@@ -141,11 +145,15 @@ void Container::RemoveChildView(View* view) {
 }
 
 void Container::UpdateChildBounds() {
+  NU_TRACE_EVENT("layout", "Container::UpdateChildBounds");
   dirty_ = false;
   if (!IsVisibleInHierarchy())
     return;
+  if (PerfCounters* counters = perf_counters())
+    counters->layout_count++;
   // For root CSS node, calculate the layout before setting bounds.
   if (IsRootYGNode(this)) {
+    NU_TRACE_EVENT("layout", "YGNodeCalculateLayout");
     SizeF size = GetBounds().size();
     YGNodeCalculateLayout(node(), size.width(), size.height(), YGDirectionLTR);
   }
@@ -0,0 +1,51 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/nativeui.h"
+#include "nativeui/test/benchmark.h"
+
+namespace {
+
+scoped_refptr<nu::Container> CreateChild() {
+  scoped_refptr<nu::Container> child = new nu::Container;
+  child->SetStyleProperty("height", 10);
+  child->SetStyleProperty("margin", 1);
+  return child;
+}
+
+// Add children one by one to a container in a window, each insertion triggers
+// a layout.
+void BM_ContainerAddChildViews(nu::BenchmarkState* state) {
+  scoped_refptr<nu::Window> window = new nu::Window(nu::Window::Options());
+  window->SetContentSize(nu::SizeF(400, 400));
+  int64_t children = state->range(0);
+  while (state->KeepRunning()) {
+    scoped_refptr<nu::Container> root = new nu::Container;
+    window->SetContentView(root.get());
+    for (int64_t i = 0; i < children; ++i)
+      root->AddChildView(CreateChild());
+  }
+  state->SetItemsProcessed(state->iterations() * children);
+}
+NU_BENCHMARK(BM_ContainerAddChildViews)->Arg(10)->Arg(100)->Arg(1000);
+
+// Resize the window with a built tree.
+void BM_ContainerRelayoutOnResize(nu::BenchmarkState* state) {
+  scoped_refptr<nu::Window> window = new nu::Window(nu::Window::Options());
+  scoped_refptr<nu::Container> root = new nu::Container;
+  root->SetStyleProperty("flex-direction", "row");
+  root->SetStyleProperty("flex-wrap", "wrap");
+  for (int64_t i = 0; i < state->range(0); ++i) {
+    scoped_refptr<nu::Container> child = CreateChild();
+    child->SetStyleProperty("width", 20);
+    root->AddChildView(child.get());
+  }
+  window->SetContentView(root.get());
+  int64_t count = 0;
+  while (state->KeepRunning())
+    window->SetContentSize(nu::SizeF(400 + (count++ % 2) * 50, 400));
+}
+NU_BENCHMARK(BM_ContainerRelayoutOnResize)->Arg(10)->Arg(100)->Arg(1000);
+
+}  // namespace
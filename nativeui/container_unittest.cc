@@ -174,3 +174,23 @@ TEST_F(ContainerTest, MoveBetweenContainers) {
   EXPECT_EQ(v1->GetBounds(), nu::RectF(0, 0, 200, 100));
   EXPECT_EQ(v2->GetBounds(), nu::RectF(0, 100, 200, 100));
 }
+
+TEST_F(ContainerTest, TraceLayout) {
+  window_->SetVisible(true);
+  nu::App* app = nu::App::GetCurrent();
+  app->StartTracing();
+  EXPECT_TRUE(app->IsTracing());
+  nu::App::FrameTimings timings = app->GetFrameTimings();
+  EXPECT_EQ(timings.count, 0);
+  EXPECT_EQ(timings.histogram.size(), timings.buckets.size() + 1);
+  container_->AddChildView(new nu::Label("label"));
+  std::string json = app->StopTracing();
+  EXPECT_FALSE(app->IsTracing());
+  EXPECT_NE(json.find("\"traceEvents\""), std::string::npos);
+  EXPECT_NE(json.find("Container::UpdateChildBounds"), std::string::npos);
+  EXPECT_NE(json.find("MeasureLabel"), std::string::npos);
+  // Nothing is recorded after stopping.
+  container_->AddChildView(new nu::Label("label"));
+  app->StartTracing();
+  EXPECT_EQ(app->StopTracing().find("MeasureLabel"), std::string::npos);
+}
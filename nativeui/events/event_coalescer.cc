@@ -0,0 +1,60 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/events/event_coalescer.h"
+
+#include <utility>
+
+namespace nu {
+
+namespace {
+
+// Assume 60fps.
+const int kFrameIntervalMs = 16;
+
+}  // namespace
+
+EventCoalescer::EventCoalescer(std::function<void()> flush)
+    : flush_(std::move(flush)) {}
+
+EventCoalescer::~EventCoalescer() {
+  if (timer_)
+    MessageLoop::ClearTimeout(timer_);
+}
+
+void EventCoalescer::Request() {
+  if (timer_) {
+    pending_ = true;
+    return;
+  }
+  timer_ = MessageLoop::SetTimeout(kFrameIntervalMs,
+                                   std::bind(&EventCoalescer::OnFrameEnd,
+                                             this));
+  flush_();
+}
+
+void EventCoalescer::Flush() {
+  if (timer_) {
+    MessageLoop::ClearTimeout(timer_);
+    timer_ = 0;
+  }
+  if (!pending_)
+    return;
+  pending_ = false;
+  flush_();
+}
+
+void EventCoalescer::OnFrameEnd() {
+  timer_ = 0;
+  if (!pending_)
+    return;
+  pending_ = false;
+  // Start next frame before flushing, so requests made in |flush_| are merged.
+  timer_ = MessageLoop::SetTimeout(kFrameIntervalMs,
+                                   std::bind(&EventCoalescer::OnFrameEnd,
+                                             this));
+  flush_();
+}
+
+}  // namespace nu
@@ -0,0 +1,43 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_EVENTS_EVENT_COALESCER_H_
+#define NATIVEUI_EVENTS_EVENT_COALESCER_H_
+
+#include <functional>
+
+#include "nativeui/message_loop.h"
+
+namespace nu {
+
+// Limits how often an event is delivered, at most once per frame.
+//
+// The first request is flushed immediately so there is no extra latency, and
+// requests made in the same frame are merged into one flush at the end of the
+// frame.
+class EventCoalescer {
+ public:
+  // The |flush| should deliver the latest data of the event.
+  explicit EventCoalescer(std::function<void()> flush);
+  ~EventCoalescer();
+
+  EventCoalescer& operator=(const EventCoalescer&) = delete;
+  EventCoalescer(const EventCoalescer&) = delete;
+
+  void Request();
+
+  // Deliver the pending request now and stop waiting for the frame end.
+  void Flush();
+
+ private:
+  void OnFrameEnd();
+
+  std::function<void()> flush_;
+  MessageLoop::TimerId timer_ = 0;
+  bool pending_ = false;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_EVENTS_EVENT_COALESCER_H_
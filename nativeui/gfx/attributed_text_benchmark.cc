@@ -0,0 +1,37 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <string>
+
+#include "nativeui/nativeui.h"
+#include "nativeui/test/benchmark.h"
+
+namespace {
+
+// Measure a paragraph with |range| words, with alternating widths so results
+// are not cached.
+void BM_AttributedTextGetBoundsFor(nu::BenchmarkState* state) {
+  std::string text;
+  for (int64_t i = 0; i < state->range(0); ++i)
+    text += i % 7 ? "word " : "longerword ";
+  scoped_refptr<nu::AttributedText> attributed_text =
+      new nu::AttributedText(text, nu::TextFormat());
+  int64_t count = 0;
+  while (state->KeepRunning()) {
+    float width = (count++ % 2) ? 200 : 201;
+    attributed_text->GetBoundsFor(nu::SizeF(width, 10000));
+  }
+}
+NU_BENCHMARK(BM_AttributedTextGetBoundsFor)->Arg(10)->Arg(100)->Arg(1000);
+
+void BM_AttributedTextCreateAndMeasure(nu::BenchmarkState* state) {
+  while (state->KeepRunning()) {
+    scoped_refptr<nu::AttributedText> text =
+        new nu::AttributedText("Label text", nu::TextFormat());
+    text->GetOneLineSize();
+  }
+}
+NU_BENCHMARK(BM_AttributedTextCreateAndMeasure);
+
+}  // namespace
@@ -0,0 +1,56 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/nativeui.h"
+#include "nativeui/test/benchmark.h"
+
+namespace {
+
+void BM_PainterFillRect(nu::BenchmarkState* state) {
+  scoped_refptr<nu::Canvas> canvas = new nu::Canvas(nu::SizeF(256, 256), 1);
+  nu::Painter* painter = canvas->GetPainter();
+  painter->SetFillColor(nu::Color(255, 0, 0));
+  while (state->KeepRunning())
+    painter->FillRect(nu::RectF(8, 8, 240, 240));
+}
+NU_BENCHMARK(BM_PainterFillRect);
+
+void BM_PainterStrokePath(nu::BenchmarkState* state) {
+  scoped_refptr<nu::Canvas> canvas = new nu::Canvas(nu::SizeF(256, 256), 1);
+  nu::Painter* painter = canvas->GetPainter();
+  painter->SetStrokeColor(nu::Color(0, 0, 255));
+  painter->SetLineWidth(2);
+  while (state->KeepRunning()) {
+    painter->BeginPath();
+    painter->MoveTo(nu::PointF(10, 10));
+    for (int i = 1; i < 16; ++i)
+      painter->LineTo(nu::PointF(10 + i * 15, i % 2 ? 240 : 10));
+    painter->Arc(nu::PointF(128, 128), 64, 0, 6.28f);
+    painter->Stroke();
+  }
+}
+NU_BENCHMARK(BM_PainterStrokePath);
+
+void BM_PainterDrawText(nu::BenchmarkState* state) {
+  scoped_refptr<nu::Canvas> canvas = new nu::Canvas(nu::SizeF(256, 256), 1);
+  nu::Painter* painter = canvas->GetPainter();
+  nu::TextAttributes attributes;
+  while (state->KeepRunning())
+    painter->DrawText("The quick brown fox jumps over the lazy dog",
+                      nu::RectF(0, 0, 256, 256), attributes);
+}
+NU_BENCHMARK(BM_PainterDrawText);
+
+void BM_PainterDrawCanvas(nu::BenchmarkState* state) {
+  scoped_refptr<nu::Canvas> canvas = new nu::Canvas(nu::SizeF(256, 256), 1);
+  scoped_refptr<nu::Canvas> source = new nu::Canvas(nu::SizeF(64, 64), 1);
+  source->GetPainter()->SetFillColor(nu::Color(0, 255, 0));
+  source->GetPainter()->FillRect(nu::RectF(0, 0, 64, 64));
+  nu::Painter* painter = canvas->GetPainter();
+  while (state->KeepRunning())
+    painter->DrawCanvas(source.get(), nu::RectF(32, 32, 128, 128));
+}
+NU_BENCHMARK(BM_PainterDrawCanvas);
+
+}  // namespace
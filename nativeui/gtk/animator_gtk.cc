@@ -0,0 +1,76 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/animator.h"
+
+#include <gtk/gtk.h>
+
+#include "nativeui/view.h"
+
+namespace nu {
+
+namespace {
+
+gboolean OnTick(GtkWidget* widget, GdkFrameClock* clock, gpointer data) {
+  // Frame time uses the same monotonic clock with base::TimeTicks.
+  base::TimeTicks now = base::TimeTicks() +
+      base::Microseconds(gdk_frame_clock_get_frame_time(clock));
+  static_cast<Animator*>(data)->Tick(now);
+  return G_SOURCE_CONTINUE;
+}
+
+}  // namespace
+
+bool Animator::PlatformStartTicking() {
+  // All animations share the frame clock of one visible window, since the
+  // frame clock stops when its window is hidden.
+  for (const auto& animation : animations_) {
+    if (!animation)
+      continue;
+    GtkWidget* widget = gtk_widget_get_toplevel(
+        animation->GetView()->GetNative());
+    if (!gtk_widget_is_toplevel(widget) || !gtk_widget_get_mapped(widget))
+      continue;
+    tick_widget_ = widget;
+    tick_id_ = gtk_widget_add_tick_callback(widget, OnTick, this,
+                                            OnTickCallbackDestroyed);
+    g_signal_connect(widget, "unmap", G_CALLBACK(OnTickWidgetHidden), this);
+    g_signal_connect(widget, "unrealize", G_CALLBACK(OnTickWidgetHidden),
+                     this);
+    return true;
+  }
+  return false;
+}
+
+void Animator::PlatformStopTicking() {
+  if (!tick_widget_)
+    return;
+  GtkWidget* widget = tick_widget_;
+  guint id = tick_id_;
+  tick_widget_ = nullptr;
+  tick_id_ = 0;
+  g_signal_handlers_disconnect_by_data(widget, this);
+  if (id)
+    gtk_widget_remove_tick_callback(widget, id);
+}
+
+// static
+void Animator::OnTickCallbackDestroyed(void* data) {
+  auto* self = static_cast<Animator*>(data);
+  // Removed by PlatformStopTicking.
+  if (!self->tick_id_)
+    return;
+  // The widget has been destroyed, switch to another clock.
+  self->tick_id_ = 0;
+  self->RestartTicking();
+}
+
+// static
+void Animator::OnTickWidgetHidden(NativeView widget, void* data) {
+  // The frame clock of the window stops, switch to another clock or the
+  // timer.
+  static_cast<Animator*>(data)->RestartTicking();
+}
+
+}  // namespace nu
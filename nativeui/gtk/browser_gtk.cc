@@ -7,6 +7,11 @@
 #include <JavaScriptCore/JavaScript.h>
 #include <webkit2/webkit2.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
 #include "base/json/json_reader.h"
 #include "base/no_destructor.h"
 #include "nativeui/gtk/nu_protocol_stream.h"
@@ -18,8 +23,13 @@ namespace {
 
 const char* kIgnoreNextFinish = "ignore-next-finish";
 
+struct ProtocolEntry {
+  Browser::ProtocolHandler handler;
+  bool thread_safe = false;
+};
+
 // Stores the protocol factories.
-using ProtocolHandlerMap = std::map<std::string, Browser::ProtocolHandler>;
+using ProtocolHandlerMap = std::map<std::string, ProtocolEntry>;
 ProtocolHandlerMap& GetProtocolHandlers() {
   static base::NoDestructor<ProtocolHandlerMap> handlers;
   return *handlers;
@@ -34,19 +44,170 @@ std::string JSStringToString(JSStringRef js) {
   return str;
 }
 
-base::Value JSResultToBaseValue(WebKitJavascriptResult* js_result) {
+// Same with the default max depth of JSONReader.
+const size_t kMaxValueDepth = 200;
+
+// The length of arrays comes from page, limit the total number of converted
+// elements so a sparse array like |new Array(4294967295)| can not exhaust
+// memory.
+const size_t kMaxArrayElements = 1 << 22;
+
+// The state of converting one JavaScript value.
+struct ConvertState {
+  std::vector<JSObjectRef> parents;
+  size_t array_elements = 0;
+  bool failed = false;
+};
+
+base::Value JSValueToBaseValue(JSContextRef context,
+                               JSValueRef value,
+                               ConvertState* state);
+
+// Convert ArrayBuffer and its views to binary value, return false if |object|
+// is not one of them.
+bool ArrayBufferToBaseValue(JSContextRef context,
+                            JSObjectRef object,
+                            base::Value* result) {
+  JSTypedArrayType type = JSValueGetTypedArrayType(context, object, nullptr);
+  if (type == kJSTypedArrayTypeNone)
+    return false;
+  const uint8_t* data;
+  size_t size;
+  if (type == kJSTypedArrayTypeArrayBuffer) {
+    data = static_cast<const uint8_t*>(
+        JSObjectGetArrayBufferBytesPtr(context, object, nullptr));
+    size = JSObjectGetArrayBufferByteLength(context, object, nullptr);
+  } else {
+    // The pointer is the start of the underlying buffer.
+    data = static_cast<const uint8_t*>(
+        JSObjectGetTypedArrayBytesPtr(context, object, nullptr));
+    if (data)
+      data += JSObjectGetTypedArrayByteOffset(context, object, nullptr);
+    size = JSObjectGetTypedArrayByteLength(context, object, nullptr);
+  }
+  if (data && size > 0)
+    *result = base::Value(base::span<const uint8_t>(data, size));
+  else
+    *result = base::Value(base::Value::Type::BINARY);
+  return true;
+}
+
+base::Value JSObjectToBaseValue(JSContextRef context,
+                                JSObjectRef object,
+                                ConvertState* state) {
+  base::Value binary;
+  if (ArrayBufferToBaseValue(context, object, &binary))
+    return binary;
+  // Dates and other special objects are rare, leave them to JSON.
+  if (JSValueIsDate(context, object)) {
+    JSStringRef json = JSValueCreateJSONString(context, object, 0, nullptr);
+    if (!json)
+      return base::Value();
+    std::optional<base::Value> result =
+        base::JSONReader::Read(JSStringToString(json));
+    JSStringRelease(json);
+    return result ? std::move(*result) : base::Value();
+  }
+  // Like JSON, cyclic and too deep values are not converted.
+  std::vector<JSObjectRef>& parents = state->parents;
+  if (parents.size() >= kMaxValueDepth ||
+      std::find(parents.begin(), parents.end(), object) != parents.end()) {
+    return base::Value();
+  }
+  base::Value result;
+  if (JSValueIsArray(context, object)) {
+    JSStringRef length_name = JSStringCreateWithUTF8CString("length");
+    double length = JSValueToNumber(
+        context, JSObjectGetProperty(context, object, length_name, nullptr),
+        nullptr);
+    JSStringRelease(length_name);
+    // Fail the whole conversion instead of returning a truncated value.
+    if (!(length >= 0) ||
+        length > kMaxArrayElements - state->array_elements) {
+      state->failed = true;
+      return base::Value();
+    }
+    state->array_elements += static_cast<size_t>(length);
+    parents.push_back(object);
+    base::Value::List list;
+    for (unsigned i = 0; i < length && !state->failed; ++i) {
+      list.Append(JSValueToBaseValue(
+          context, JSObjectGetPropertyAtIndex(context, object, i, nullptr),
+          state));
+    }
+    parents.pop_back();
+    result = base::Value(std::move(list));
+  } else {
+    parents.push_back(object);
+    base::Value::Dict dict;
+    JSPropertyNameArrayRef names = JSObjectCopyPropertyNames(context, object);
+    size_t count = JSPropertyNameArrayGetCount(names);
+    for (size_t i = 0; i < count && !state->failed; ++i) {
+      JSStringRef name = JSPropertyNameArrayGetNameAtIndex(names, i);
+      JSValueRef property = JSObjectGetProperty(context, object, name,
+                                                nullptr);
+      // Members that JSON can not represent are omitted.
+      if (!property || JSValueIsUndefined(context, property) ||
+          (JSValueIsObject(context, property) &&
+           JSObjectIsFunction(context,
+                              JSValueToObject(context, property, nullptr)))) {
+        continue;
+      }
+      dict.Set(JSStringToString(name),
+               JSValueToBaseValue(context, property, state));
+    }
+    JSPropertyNameArrayRelease(names);
+    parents.pop_back();
+    result = base::Value(std::move(dict));
+  }
+  return result;
+}
+
+// Convert JavaScript value to base::Value directly, which produces the same
+// result with JSON except that ArrayBuffers are converted to binary.
+base::Value JSValueToBaseValue(JSContextRef context,
+                               JSValueRef value,
+                               ConvertState* state) {
+  switch (JSValueGetType(context, value)) {
+    case kJSTypeBoolean:
+      return base::Value(JSValueToBoolean(context, value));
+    case kJSTypeNumber: {
+      double number = JSValueToNumber(context, value, nullptr);
+      if (!std::isfinite(number))
+        return base::Value();
+      if (number == std::trunc(number) &&
+          number >= std::numeric_limits<int>::min() &&
+          number <= std::numeric_limits<int>::max())
+        return base::Value(static_cast<int>(number));
+      return base::Value(number);
+    }
+    case kJSTypeString: {
+      JSStringRef str = JSValueToStringCopy(context, value, nullptr);
+      if (!str)
+        return base::Value();
+      base::Value result(JSStringToString(str));
+      JSStringRelease(str);
+      return result;
+    }
+    case kJSTypeObject: {
+      JSObjectRef object = JSValueToObject(context, value, nullptr);
+      if (!object || JSObjectIsFunction(context, object))
+        return base::Value();
+      return JSObjectToBaseValue(context, object, state);
+    }
+    default:
+      return base::Value();
+  }
+}
+
+// Return false if the value is too large to convert.
+bool JSResultToBaseValue(WebKitJavascriptResult* js_result,
+                         base::Value* result) {
   auto* context = webkit_javascript_result_get_global_context(js_result);
   auto* value = webkit_javascript_result_get_value(js_result);
-  // TODO(zcbenz): Convert types directly instead of using JSON parsing.
-  JSStringRef json = JSValueCreateJSONString(context, value, 0, nullptr);
-  if (!json)
-    return base::Value();
-  std::string json_str = JSStringToString(json);
-  JSStringRelease(json);
-  std::optional<base::Value> result = base::JSONReader::Read(json_str);
-  if (!result)
-    return base::Value();
-  return std::move(*result);
+  ConvertState state;
+  *result = JSValueToBaseValue(context, value, &state);
+  return !state.failed;
 }
 
 gboolean OnContextMenu(WebKitWebView* widget,
@@ -113,8 +274,9 @@ void OnJavaScriptFinish(WebKitWebView* webview,
   auto* js_result = webkit_web_view_run_javascript_finish(
       webview, result, nullptr);
   if (*callback) {
-    if (js_result)
-      (*callback)(true, JSResultToBaseValue(js_result));
+    base::Value value;
+    if (js_result && JSResultToBaseValue(js_result, &value))
+      (*callback)(true, std::move(value));
     else
       (*callback)(false, base::Value());
   }
@@ -153,11 +315,16 @@ void OnScriptMessage(WebKitUserContentManager* manager,
     return;
   auto* context = webkit_javascript_result_get_global_context(js_result);
   auto* value = webkit_javascript_result_get_value(js_result);
-  if (!JSValueIsString(context, value))
+  // Arguments that can not be cloned are sent in JSON.
+  if (JSValueIsString(context, value)) {
+    JSStringRef str = JSValueToStringCopy(context, value, nullptr);
+    browser->InvokeBindings(JSStringToString(str));
+    JSStringRelease(str);
     return;
-  JSStringRef str = JSValueToStringCopy(context, value, nullptr);
-  browser->InvokeBindings(JSStringToString(str));
-  JSStringRelease(str);
+  }
+  base::Value message;
+  if (JSResultToBaseValue(js_result, &message) && message.is_list())
+    browser->InvokeBindings(std::move(message).TakeList());
 }
 
 void OnNullProtocolRequest(WebKitURISchemeRequest* request, gpointer) {
@@ -170,44 +337,35 @@ void OnNullProtocolRequest(WebKitURISchemeRequest* request, gpointer) {
 }
 
 void OnProtocolRequest(WebKitURISchemeRequest* request,
-                       Browser::ProtocolHandler* handler) {
-  // Create job.
-  ProtocolJob* protocol_job =
-      (*handler)(webkit_uri_scheme_request_get_uri(request));
-  if (!protocol_job) {
-    GError* error = g_error_new_literal(
-        g_quark_from_static_string("yue"),
-        WEBKIT_NETWORK_ERROR_FAILED,
-        "The protocol handler did not return a request job");
-    webkit_uri_scheme_request_finish_error(request, error);
-    g_error_free(error);
-    return;
-  }
-  // Manage the protocol_job with the stream.
-  // DO NOT pass protocol_job to the lambda, it would cause circular ref.
-  GInputStream* protocol_stream = nu_protocol_stream_new(protocol_job);
-  std::string mime_type;
-  protocol_job->GetMimeType(&mime_type);
-  // Start.
+                       ProtocolEntry* entry) {
+  // The job is created and started asynchronously when possible, so file I/O
+  // does not block the GUI thread.
   g_object_ref(request);
-  protocol_job->Plug([protocol_stream, request, mime_type](int size) {
-    webkit_uri_scheme_request_finish(
-        request, protocol_stream, size,
-        mime_type.empty() ? nullptr : mime_type.c_str());
-    g_object_unref(protocol_stream);
-    g_object_unref(request);
-  });
-  if (!protocol_job->Start()) {
-    GError* error = g_error_new_literal(
-        g_quark_from_static_string("yue"),
-        WEBKIT_NETWORK_ERROR_FAILED,
-        "The protocol request job failed to start");
-    webkit_uri_scheme_request_finish_error(request, error);
-    g_error_free(error);
-    // Free on failure.
-    g_object_unref(protocol_stream);
-    g_object_unref(request);
-  }
+  StartProtocolJob(
+      entry->handler, entry->thread_safe,
+      webkit_uri_scheme_request_get_uri(request),
+      [request](scoped_refptr<ProtocolJob> protocol_job, int size) {
+        if (!protocol_job) {
+          GError* error = g_error_new_literal(
+              g_quark_from_static_string("yue"),
+              WEBKIT_NETWORK_ERROR_FAILED,
+              "The protocol request job failed to start");
+          webkit_uri_scheme_request_finish_error(request, error);
+          g_error_free(error);
+          g_object_unref(request);
+          return;
+        }
+        // Manage the protocol_job with the stream.
+        GInputStream* protocol_stream =
+            nu_protocol_stream_new(protocol_job.get());
+        std::string mime_type;
+        protocol_job->GetMimeType(&mime_type);
+        webkit_uri_scheme_request_finish(
+            request, protocol_stream, size,
+            mime_type.empty() ? nullptr : mime_type.c_str());
+        g_object_unref(protocol_stream);
+        g_object_unref(request);
+      });
 }
 
 }  // namespace
@@ -367,9 +525,12 @@ void Browser::PlatformUpdateBindings() {
 }
 
 // static
-bool Browser::RegisterProtocol(const std::string& scheme,
-                               ProtocolHandler handler) {
-  ProtocolHandler& ref = GetProtocolHandlers()[scheme] = std::move(handler);
+bool Browser::PlatformRegisterProtocol(const std::string& scheme,
+                                       ProtocolHandler handler,
+                                       bool thread_safe) {
+  ProtocolEntry& ref = GetProtocolHandlers()[scheme];
+  ref.handler = std::move(handler);
+  ref.thread_safe = thread_safe;
   WebKitWebContext* context = webkit_web_context_get_default();
   webkit_web_context_register_uri_scheme(
       context,
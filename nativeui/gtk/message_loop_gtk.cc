@@ -6,17 +6,196 @@
 
 #include <gtk/gtk.h>
 
-#include "nativeui/gtk/util/widget_util.h"
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/synchronization/lock.h"
+#include "nativeui/util/task_queue.h"
+#include "nativeui/util/timer_wheel.h"
 
 namespace nu {
 
 namespace {
 
-gboolean OnSource(MessageLoop::Task* func) {
-  (*func)();
-  return G_SOURCE_REMOVE;
+// Leave time for input events and painting when there are lots of tasks.
+constexpr base::TimeDelta kTaskBudget = base::Milliseconds(8);
+
+// The GSource that runs posted tasks, there is one source for each priority
+// instead of one for each task.
+struct TaskSource {
+  GSource source;
+  MessageLoop::Priority priority;
+};
+
+TaskQueue* GetTaskQueue();
+
+gboolean TaskSourceDispatch(GSource* source, GSourceFunc, gpointer) {
+  // Reset ready time before running tasks, so tasks posted meanwhile can
+  // wake up the source again.
+  g_source_set_ready_time(source, -1);
+  GetTaskQueue()->RunTasks(reinterpret_cast<TaskSource*>(source)->priority,
+                           kTaskBudget);
+  return G_SOURCE_CONTINUE;
 }
 
+GSourceFuncs g_task_source_funcs = {
+  nullptr, nullptr, TaskSourceDispatch, nullptr,
+};
+
+int ToGPriority(MessageLoop::Priority priority) {
+  switch (priority) {
+    case MessageLoop::Priority::Input:
+      return G_PRIORITY_DEFAULT;
+    case MessageLoop::Priority::Layout:
+      return GTK_PRIORITY_RESIZE - 1;
+    case MessageLoop::Priority::Paint:
+      return GDK_PRIORITY_REDRAW - 1;
+    case MessageLoop::Priority::Idle:
+      return G_PRIORITY_DEFAULT_IDLE;
+  }
+  return G_PRIORITY_DEFAULT;
+}
+
+GSource** CreateTaskSources() {
+  static GSource* sources[TaskQueue::kPriorityCount];
+  for (int i = 0; i < TaskQueue::kPriorityCount; ++i) {
+    GSource* source = g_source_new(&g_task_source_funcs, sizeof(TaskSource));
+    auto priority = static_cast<MessageLoop::Priority>(i);
+    reinterpret_cast<TaskSource*>(source)->priority = priority;
+    g_source_set_priority(source, ToGPriority(priority));
+    g_source_set_can_recurse(source, TRUE);
+    g_source_attach(source, nullptr);
+    sources[i] = source;
+  }
+  return sources;
+}
+
+TaskQueue* GetTaskQueue() {
+  // Intentionally leaked, tasks can be posted until the process exits.
+  static TaskQueue* queue = new TaskQueue([](MessageLoop::Priority priority) {
+    static GSource** sources = CreateTaskSources();
+    // Safe to call from any thread, it wakes up the main context.
+    g_source_set_ready_time(sources[static_cast<int>(priority)], 0);
+  });
+  return queue;
+}
+
+// All timers are stored in a timer wheel, which is driven by a single GSource
+// whose ready time is the nearest wakeup of the wheel.
+class Timers {
+ public:
+  static Timers* Get() {
+    // Intentionally leaked, timers can be set until the process exits.
+    static Timers* timers = new Timers;
+    return timers;
+  }
+
+  MessageLoop::TimerId Add(int ms, int tolerance,
+                           MessageLoop::Task task,
+                           MessageLoop::RepeatedTask repeated_task) {
+    base::AutoLock auto_lock(lock_);
+    MessageLoop::TimerId id = ++next_id_;
+    if (id == 0)  // 0 means no timer
+      id = ++next_id_;
+    Entry& entry = entries_[id];
+    entry.interval = ms;
+    entry.tolerance = tolerance;
+    entry.task = std::move(task);
+    entry.repeated_task = std::move(repeated_task);
+    wheel_.Add(id, Now() + ms, tolerance);
+    UpdateReadyTime();
+    return id;
+  }
+
+  void Remove(MessageLoop::TimerId id) {
+    base::AutoLock auto_lock(lock_);
+    // An earlier ready time is harmless, so no need to update it.
+    if (entries_.erase(id) > 0)
+      wheel_.Remove(id);
+  }
+
+ private:
+  struct Entry {
+    int interval = 0;
+    int tolerance = 0;
+    MessageLoop::Task task;
+    MessageLoop::RepeatedTask repeated_task;
+  };
+
+  Timers() : wheel_(Now()) {
+    static GSourceFuncs funcs = {
+      nullptr, nullptr,
+      [](GSource*, GSourceFunc, gpointer) -> gboolean {
+        Timers::Get()->Dispatch();
+        return G_SOURCE_CONTINUE;
+      },
+      nullptr,
+    };
+    source_ = g_source_new(&funcs, sizeof(GSource));
+    g_source_set_priority(source_, G_PRIORITY_DEFAULT);
+    g_source_set_can_recurse(source_, TRUE);
+    g_source_attach(source_, nullptr);
+  }
+
+  static int64_t Now() {
+    return g_get_monotonic_time() / 1000;
+  }
+
+  void Dispatch() {
+    std::vector<TimerWheel::TimerId> expired;
+    {
+      base::AutoLock auto_lock(lock_);
+      wheel_.Advance(Now(), &expired);
+      UpdateReadyTime();
+    }
+    for (TimerWheel::TimerId id : expired) {
+      MessageLoop::Task task;
+      MessageLoop::RepeatedTask repeated_task;
+      {
+        base::AutoLock auto_lock(lock_);
+        auto it = entries_.find(id);
+        if (it == entries_.end())  // cleared by a previous timer
+          continue;
+        if (it->second.repeated_task) {
+          repeated_task = it->second.repeated_task;
+        } else {
+          task = std::move(it->second.task);
+          entries_.erase(it);
+        }
+      }
+      if (task) {
+        task();
+        continue;
+      }
+      bool repeat = repeated_task();
+      base::AutoLock auto_lock(lock_);
+      auto it = entries_.find(id);
+      if (it == entries_.end())
+        continue;
+      if (repeat) {
+        wheel_.Add(id, Now() + it->second.interval, it->second.tolerance);
+        UpdateReadyTime();
+      } else {
+        entries_.erase(it);
+      }
+    }
+  }
+
+  // Must be called with |lock_| held.
+  void UpdateReadyTime() {
+    int64_t wakeup = wheel_.GetNextWakeup();
+    // Safe to call from any thread, it wakes up the main context.
+    g_source_set_ready_time(source_, wakeup < 0 ? -1 : wakeup * 1000);
+  }
+
+  base::Lock lock_;
+  GSource* source_;
+  TimerWheel wheel_;
+  MessageLoop::TimerId next_id_ = 0;
+  std::unordered_map<MessageLoop::TimerId, Entry> entries_;
+};
+
 }  // namespace
 
 // static
@@ -31,8 +210,12 @@ void MessageLoop::Quit() {
 
 // static
 void MessageLoop::PostTask(Task task) {
-  g_idle_add_full(G_PRIORITY_DEFAULT, reinterpret_cast<GSourceFunc>(OnSource),
-                  new Task(std::move(task)), Delete<Task>);
+  PostTaskWithPriority(Priority::Input, std::move(task));
+}
+
+// static
+void MessageLoop::PostTaskWithPriority(Priority priority, Task task) {
+  GetTaskQueue()->Push(priority, std::move(task));
 }
 
 // static
@@ -42,24 +225,30 @@ void MessageLoop::PostDelayedTask(int ms, Task task) {
 
 // static
 void MessageLoop::SetTimer(int ms, RepeatedTask task) {
-  g_timeout_add_full(G_PRIORITY_DEFAULT, ms,
-                     [](void *src) -> int {
-                        auto *task = static_cast<RepeatedTask*>(src);
-                        return (*task)();
-                     },
-                     new RepeatedTask(std::move(task)), Delete<RepeatedTask>);
+  SetTimerWithTolerance(ms, 0, std::move(task));
+}
+
+// static
+void MessageLoop::SetTimerWithTolerance(int ms, int tolerance,
+                                        RepeatedTask task) {
+  Timers::Get()->Add(ms, tolerance, nullptr, std::move(task));
 }
 
 // static
 MessageLoop::TimerId MessageLoop::SetTimeout(int ms, Task task) {
-  return g_timeout_add_full(G_PRIORITY_DEFAULT, ms,
-                            reinterpret_cast<GSourceFunc>(OnSource),
-                            new Task(std::move(task)), Delete<Task>);
+  return SetTimeoutWithTolerance(ms, 0, std::move(task));
+}
+
+// static
+MessageLoop::TimerId MessageLoop::SetTimeoutWithTolerance(int ms,
+                                                          int tolerance,
+                                                          Task task) {
+  return Timers::Get()->Add(ms, tolerance, std::move(task), nullptr);
 }
 
 // static
 void MessageLoop::ClearTimeout(TimerId id) {
-  g_source_remove(id);
+  Timers::Get()->Remove(id);
 }
 
 }  // namespace nu
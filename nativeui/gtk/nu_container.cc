@@ -6,6 +6,7 @@
 
 #include "nativeui/container.h"
 #include "nativeui/gfx/gtk/painter_gtk.h"
+#include "nativeui/util/trace_event.h"
 
 namespace nu {
 
@@ -158,14 +159,26 @@ static void nu_container_style_updated(GtkWidget* widget) {
 }
 
 static gboolean nu_container_draw(GtkWidget* widget, cairo_t* cr) {
+  NU_TRACE_FRAME("nu_container_draw");
+  base::TimeTicks paint_start;
+  if (View::IsPerfCountersEnabled())
+    paint_start = base::TimeTicks::Now();
   int width = gtk_widget_get_allocated_width(widget);
   int height = gtk_widget_get_allocated_height(widget);
   gtk_render_background(gtk_widget_get_style_context(widget), cr,
                         0, 0, width, height);
 
   Container* delegate = NU_CONTAINER(widget)->priv->delegate;
-  PainterGtk painter(cr, SizeF(width, height));
-  delegate->on_draw.Emit(delegate, &painter, nu::RectF(0, 0, width, height));
+  if (!delegate->on_draw.IsEmpty()) {
+    PainterGtk painter(cr, SizeF(width, height));
+    {
+      NU_TRACE_EVENT("paint", "on_draw");
+      delegate->on_draw.Emit(delegate, &painter,
+                             nu::RectF(0, 0, width, height));
+    }
+    // Children record their own paints.
+    delegate->RecordPaint(paint_start);
+  }
 
   for (int i = 0; i < delegate->ChildCount(); ++i)
     gtk_container_propagate_draw(GTK_CONTAINER(widget),
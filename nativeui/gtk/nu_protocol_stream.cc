@@ -17,22 +17,32 @@ G_DEFINE_TYPE_WITH_PRIVATE(NUProtocolStream,
                            nu_protocol_stream,
                            G_TYPE_INPUT_STREAM)
 
-static void nu_protocol_stream_finialize(GObject* stream) {
-  NUProtocolStreamPrivate* priv = NU_PROTOCOL_STREAM(stream)->priv;
-  // Free the ProtocolJob on the main thread.
-  ProtocolJob* protocol_job = priv->protocol_job;
+// Free the ProtocolJob on the main thread.
+static void release_protocol_job(gpointer data) {
+  ProtocolJob* protocol_job = static_cast<ProtocolJob*>(data);
   MessageLoop::PostTask([protocol_job]() {
     protocol_job->Release();
   });
+}
+
+static void nu_protocol_stream_finialize(GObject* stream) {
+  NUProtocolStreamPrivate* priv = NU_PROTOCOL_STREAM(stream)->priv;
+  release_protocol_job(priv->protocol_job);
 
   G_OBJECT_CLASS(nu_protocol_stream_parent_class)->finalize(stream);
 }
 
 static gssize nu_protocol_stream_read(GInputStream* stream,
                                       void* buffer, gsize count,
-                                      GCancellable*, GError**) {
+                                      GCancellable*, GError** error) {
   NUProtocolStreamPrivate* priv = NU_PROTOCOL_STREAM(stream)->priv;
-  return priv->protocol_job->Read(buffer, count);
+  size_t nread = priv->protocol_job->Read(buffer, count);
+  if (nread == 0 && priv->protocol_job->IsFailed()) {
+    g_set_error_literal(error, G_IO_ERROR, G_IO_ERROR_FAILED,
+                        "Failed to read the protocol response");
+    return -1;
+  }
+  return nread;
 }
 
 static gboolean nu_protocol_stream_close(GInputStream* stream,
@@ -55,6 +65,18 @@ static void nu_protocol_stream_init(NUProtocolStream* stream) {
 }
 
 GInputStream* nu_protocol_stream_new(ProtocolJob* protocol_job) {
+  base::span<const uint8_t> memory = protocol_job->GetMemory();
+  if (!memory.empty()) {
+    // The bytes keep a reference to the job owning the memory.
+    protocol_job->AddRef();
+    GBytes* bytes = g_bytes_new_with_free_func(memory.data(), memory.size(),
+                                               release_protocol_job,
+                                               protocol_job);
+    GInputStream* stream = g_memory_input_stream_new_from_bytes(bytes);
+    g_bytes_unref(bytes);
+    return stream;
+  }
+
   void* stream = g_object_new(NU_TYPE_PROTOCOL_STREAM, nullptr);
   NUProtocolStreamPrivate* priv = NU_PROTOCOL_STREAM(stream)->priv;
   priv->protocol_job = protocol_job;
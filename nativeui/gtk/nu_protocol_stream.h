@@ -38,6 +38,9 @@ struct _NUProtocolStreamClass {
 };
 
 GType nu_protocol_stream_get_type();
+
+// Jobs that have the response in memory are served by GMemoryInputStream
+// without copying.
 GInputStream* nu_protocol_stream_new(ProtocolJob*);
 
 }  // namespace nu
@@ -40,7 +40,7 @@ gboolean OnMouseMove(GtkWidget* widget, GdkEvent* event, Responder* responder) {
       HandleViewDragging(widget, event, static_cast<View*>(responder)))
     return true;
   if (!responder->on_mouse_move.IsEmpty()) {
-    responder->on_mouse_move.Emit(responder, MouseEvent(event, widget));
+    responder->DispatchMouseMove(MouseEvent(event, widget));
     return false;
   }
   return false;
@@ -31,7 +31,7 @@ Scroll::Policy PolicyFromGTK(GtkPolicyType policy) {
 }
 
 void OnScrollValueChanged(GtkAdjustment* adjust, Scroll* scroll) {
-  scroll->on_scroll.Emit(scroll);
+  scroll->DispatchScroll();
 }
 
 }  // namespace
@@ -0,0 +1,145 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gtk/table/cell_raster_cache.h"
+
+#include <string>
+
+#include "base/json/json_writer.h"
+#include "nativeui/table_model.h"
+
+namespace nu {
+
+namespace {
+
+// FNV-1a hash.
+size_t HashBytes(const void* data, size_t size, size_t seed) {
+  const uint64_t kPrime = 1099511628211ull;
+  uint64_t hash = 14695981039346656037ull ^ seed;
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= kPrime;
+  }
+  return static_cast<size_t>(hash);
+}
+
+template<typename T>
+size_t HashPod(const T& value, TableValueView::Type type) {
+  return HashBytes(&value, sizeof(T), static_cast<size_t>(type));
+}
+
+size_t HashCombine(size_t seed, size_t value) {
+  return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+}  // namespace
+
+size_t HashTableValueView(const TableValueView& view) {
+  using Type = TableValueView::Type;
+  switch (view.type) {
+    case Type::Null:
+      return 0;
+    case Type::Bool:
+      return HashPod(view.bool_value, Type::Bool);
+    case Type::Integer:
+      return HashPod(view.int_value, Type::Integer);
+    case Type::Double:
+      return HashPod(view.double_value, Type::Double);
+    case Type::String:
+      return HashBytes(view.string_value.data(), view.string_value.size(),
+                       static_cast<size_t>(Type::String));
+    case Type::Value:
+      break;
+  }
+  // Hash primitive values in the same way with typed views.
+  const base::Value& value = *view.value;
+  if (value.is_none())
+    return 0;
+  if (value.is_bool())
+    return HashPod(value.GetBool(), Type::Bool);
+  if (value.is_int())
+    return HashPod(value.GetInt(), Type::Integer);
+  if (value.is_double())
+    return HashPod(value.GetDouble(), Type::Double);
+  if (value.is_string()) {
+    const std::string& str = value.GetString();
+    return HashBytes(str.data(), str.size(), static_cast<size_t>(Type::String));
+  }
+  // Complex values are rare in cells, just hash the serialized data.
+  std::string json;
+  base::JSONWriter::Write(value, &json);
+  return HashBytes(json.data(), json.size(), static_cast<size_t>(Type::Value));
+}
+
+bool CellRasterCache::Key::operator==(const Key& other) const {
+  return row == other.row &&
+         value_hash == other.value_hash &&
+         width == other.width &&
+         height == other.height &&
+         scale_factor == other.scale_factor &&
+         selected == other.selected;
+}
+
+size_t CellRasterCache::KeyHash::operator()(const Key& key) const {
+  size_t hash = key.value_hash;
+  hash = HashCombine(hash, static_cast<size_t>(key.row));
+  hash = HashCombine(hash, static_cast<size_t>(key.width));
+  hash = HashCombine(hash, static_cast<size_t>(key.height));
+  hash = HashCombine(hash, static_cast<size_t>(key.scale_factor));
+  return HashCombine(hash, key.selected);
+}
+
+CellRasterCache::CellRasterCache(size_t max_entries)
+    : max_entries_(max_entries) {}
+
+CellRasterCache::~CellRasterCache() {
+  Clear();
+}
+
+cairo_surface_t* CellRasterCache::Get(const Key& key) {
+  auto it = map_.find(key);
+  if (it == map_.end())
+    return nullptr;
+  if (it->second != entries_.begin())
+    entries_.splice(entries_.begin(), entries_, it->second);
+  return entries_.front().surface;
+}
+
+void CellRasterCache::Put(const Key& key, cairo_surface_t* surface) {
+  auto it = map_.find(key);
+  if (it != map_.end()) {
+    cairo_surface_destroy(it->second->surface);
+    entries_.erase(it->second);
+    map_.erase(it);
+  }
+  entries_.push_front({key, surface});
+  map_[key] = entries_.begin();
+  while (entries_.size() > max_entries_) {
+    cairo_surface_destroy(entries_.back().surface);
+    map_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+}
+
+void CellRasterCache::InvalidateRows(int start, int count) {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->key.row >= start && it->key.row < start + count) {
+      cairo_surface_destroy(it->surface);
+      map_.erase(it->key);
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void CellRasterCache::Clear() {
+  for (Entry& entry : entries_)
+    cairo_surface_destroy(entry.surface);
+  entries_.clear();
+  map_.clear();
+}
+
+}  // namespace nu
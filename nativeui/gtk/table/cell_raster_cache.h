@@ -0,0 +1,75 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GTK_TABLE_CELL_RASTER_CACHE_H_
+#define NATIVEUI_GTK_TABLE_CELL_RASTER_CACHE_H_
+
+#include <cairo.h>
+
+#include <list>
+#include <unordered_map>
+
+#include "nativeui/nativeui_export.h"
+
+namespace nu {
+
+struct TableValueView;
+
+// Hash of the data in cell, used to tell whether the cell has changed.
+NATIVEUI_EXPORT size_t HashTableValueView(const TableValueView& view);
+
+// A LRU cache of drawn cells of one column, so custom cells can be painted
+// without invoking the on_draw callback when nothing has changed.
+class NATIVEUI_EXPORT CellRasterCache {
+ public:
+  struct Key {
+    bool operator==(const Key& other) const;
+
+    int row = -1;
+    size_t value_hash = 0;
+    int width = 0;
+    int height = 0;
+    int scale_factor = 1;
+    bool selected = false;
+  };
+
+  explicit CellRasterCache(size_t max_entries);
+  ~CellRasterCache();
+
+  CellRasterCache& operator=(const CellRasterCache&) = delete;
+  CellRasterCache(const CellRasterCache&) = delete;
+
+  // Return the cached surface and mark it as recently used, nullptr is
+  // returned if there is no cache. The surface is owned by the cache.
+  cairo_surface_t* Get(const Key& key);
+
+  // Add |surface| to cache, the cache takes the ownership.
+  void Put(const Key& key, cairo_surface_t* surface);
+
+  // Drop the cached cells of rows.
+  void InvalidateRows(int start, int count);
+  void Clear();
+
+  size_t size() const { return entries_.size(); }
+
+ private:
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct Entry {
+    Key key;
+    cairo_surface_t* surface;
+  };
+
+  const size_t max_entries_;
+
+  // The front is the most recently used entry.
+  std::list<Entry> entries_;
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> map_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GTK_TABLE_CELL_RASTER_CACHE_H_
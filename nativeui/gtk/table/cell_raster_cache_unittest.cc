@@ -0,0 +1,146 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gtk/table/cell_raster_cache.h"
+
+#include <gtk/gtk.h>
+
+#include "nativeui/gtk/table/nu_custom_cell_renderer.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+nu::CellRasterCache::Key MakeKey(int row, size_t value_hash = 0) {
+  nu::CellRasterCache::Key key;
+  key.row = row;
+  key.value_hash = value_hash;
+  key.width = 10;
+  key.height = 10;
+  return key;
+}
+
+cairo_surface_t* MakeSurface() {
+  return cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1, 1);
+}
+
+// Return the cache of the first custom column of |table|.
+nu::CellRasterCache* GetCache(nu::Table* table) {
+  auto* tree_view = GTK_TREE_VIEW(g_object_get_data(
+      G_OBJECT(table->GetNative()), "widget"));
+  nu::CellRasterCache* cache = nullptr;
+  GList* columns = gtk_tree_view_get_columns(tree_view);
+  for (GList* column = columns; column && !cache; column = column->next) {
+    GList* cells = gtk_cell_layout_get_cells(GTK_CELL_LAYOUT(column->data));
+    for (GList* cell = cells; cell && !cache; cell = cell->next)
+      cache = nu::nu_custom_cell_renderer_get_cache(
+          GTK_CELL_RENDERER(cell->data));
+    g_list_free(cells);
+  }
+  g_list_free(columns);
+  return cache;
+}
+
+}  // namespace
+
+class CellRasterCacheTest : public testing::Test {
+ protected:
+  nu::Lifetime lifetime_;
+  nu::State state_;
+};
+
+TEST_F(CellRasterCacheTest, EvictLeastRecentlyUsed) {
+  nu::CellRasterCache cache(2);
+  cairo_surface_t* first = MakeSurface();
+  cache.Put(MakeKey(0), first);
+  cache.Put(MakeKey(1), MakeSurface());
+  // Using the first entry makes the second one the oldest.
+  EXPECT_EQ(cache.Get(MakeKey(0)), first);
+  cache.Put(MakeKey(2), MakeSurface());
+  EXPECT_EQ(cache.size(), 2u);
+  EXPECT_EQ(cache.Get(MakeKey(0)), first);
+  EXPECT_EQ(cache.Get(MakeKey(1)), nullptr);
+  EXPECT_NE(cache.Get(MakeKey(2)), nullptr);
+}
+
+TEST_F(CellRasterCacheTest, PutReplaces) {
+  nu::CellRasterCache cache(2);
+  cache.Put(MakeKey(0), MakeSurface());
+  cairo_surface_t* surface = MakeSurface();
+  cache.Put(MakeKey(0), surface);
+  EXPECT_EQ(cache.size(), 1u);
+  EXPECT_EQ(cache.Get(MakeKey(0)), surface);
+}
+
+TEST_F(CellRasterCacheTest, Key) {
+  nu::CellRasterCache cache(10);
+  cache.Put(MakeKey(0, 1), MakeSurface());
+  EXPECT_EQ(cache.Get(MakeKey(0, 2)), nullptr);
+  EXPECT_EQ(cache.Get(MakeKey(1, 1)), nullptr);
+  nu::CellRasterCache::Key selected = MakeKey(0, 1);
+  selected.selected = true;
+  EXPECT_EQ(cache.Get(selected), nullptr);
+  nu::CellRasterCache::Key scaled = MakeKey(0, 1);
+  scaled.scale_factor = 2;
+  EXPECT_EQ(cache.Get(scaled), nullptr);
+  EXPECT_NE(cache.Get(MakeKey(0, 1)), nullptr);
+}
+
+TEST_F(CellRasterCacheTest, InvalidateRows) {
+  nu::CellRasterCache cache(10);
+  for (int row = 0; row < 5; ++row)
+    cache.Put(MakeKey(row), MakeSurface());
+  cache.InvalidateRows(1, 2);
+  EXPECT_EQ(cache.size(), 3u);
+  EXPECT_NE(cache.Get(MakeKey(0)), nullptr);
+  EXPECT_EQ(cache.Get(MakeKey(1)), nullptr);
+  EXPECT_EQ(cache.Get(MakeKey(2)), nullptr);
+  EXPECT_NE(cache.Get(MakeKey(3)), nullptr);
+  cache.Clear();
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST_F(CellRasterCacheTest, HashTableValueView) {
+  // Typed views and base::Value views of the same data have the same hash.
+  base::Value integer(42);
+  nu::TableValueView typed;
+  typed.type = nu::TableValueView::Type::Integer;
+  typed.int_value = 42;
+  EXPECT_EQ(nu::HashTableValueView(typed),
+            nu::HashTableValueView(nu::TableValueView(&integer)));
+  base::Value other(43);
+  EXPECT_NE(nu::HashTableValueView(typed),
+            nu::HashTableValueView(nu::TableValueView(&other)));
+  // Same bits of different types are different.
+  base::Value boolean(true);
+  base::Value one(1);
+  EXPECT_NE(nu::HashTableValueView(nu::TableValueView(&boolean)),
+            nu::HashTableValueView(nu::TableValueView(&one)));
+}
+
+TEST_F(CellRasterCacheTest, NotifyValueChange) {
+  scoped_refptr<nu::SimpleTableModel> model = new nu::SimpleTableModel(1);
+  for (int i = 0; i < 3; ++i) {
+    nu::SimpleTableModel::Row row;
+    row.emplace_back(i);
+    model->AddRow(std::move(row));
+  }
+  scoped_refptr<nu::Table> table = new nu::Table;
+  nu::Table::ColumnOptions options;
+  options.type = nu::Table::ColumnType::Custom;
+  options.on_draw = [](nu::Painter*, const nu::RectF&, const base::Value&) {};
+  options.cache_size = 10;
+  table->AddColumnWithOptions("A", options);
+  table->SetModel(model);
+  nu::CellRasterCache* cache = GetCache(table.get());
+  ASSERT_TRUE(cache);
+  for (int row = 0; row < 3; ++row)
+    cache->Put(MakeKey(row), MakeSurface());
+  // Only the cells of changed row are dropped.
+  model->SetValue(0, 1, base::Value(100));
+  EXPECT_EQ(cache->size(), 2u);
+  EXPECT_NE(cache->Get(MakeKey(0)), nullptr);
+  EXPECT_EQ(cache->Get(MakeKey(1)), nullptr);
+  EXPECT_NE(cache->Get(MakeKey(2)), nullptr);
+}
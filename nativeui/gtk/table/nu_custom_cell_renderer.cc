@@ -4,18 +4,28 @@
 
 #include "nativeui/gtk/table/nu_custom_cell_renderer.h"
 
+#include <memory>
 #include <utility>
 
 #include "base/values.h"
 #include "nativeui/gfx/gtk/painter_gtk.h"
+#include "nativeui/gtk/table/cell_raster_cache.h"
+#include "nativeui/table_model.h"
 
 namespace nu {
 
-enum { PROP_VALUE = 1 };
+enum { PROP_VALUE = 1, PROP_VALUE_VIEW, PROP_ROW };
 
 struct _NUCustomCellRendererPrivate {
   Table::ColumnOptions options;
+  // Owned value, used when model can not lend the data.
   base::Value value;
+  // Borrowed value, which is only valid during current cell rendering.
+  TableValueView view;
+  // The row of current cell.
+  int row;
+  // Drawn cells, only created when ColumnOptions::cache_size is set.
+  std::unique_ptr<CellRasterCache> cache;
 };
 
 static void nu_custom_cell_renderer_class_init(
@@ -58,6 +68,19 @@ static void nu_custom_cell_renderer_class_init(NUCustomCellRendererClass* cl) {
                                                        "Value",
                                                        "The value to display",
                                                        G_PARAM_WRITABLE));
+  g_object_class_install_property(object_class,
+                                  PROP_VALUE_VIEW,
+                                  g_param_spec_pointer("value-view",
+                                                       "Value view",
+                                                       "The borrowed value",
+                                                       G_PARAM_WRITABLE));
+  g_object_class_install_property(object_class,
+                                  PROP_ROW,
+                                  g_param_spec_int("row",
+                                                   "Row",
+                                                   "The row of cell",
+                                                   -1, G_MAXINT, -1,
+                                                   G_PARAM_WRITABLE));
 }
 
 static void nu_custom_cell_renderer_finalize(GObject* object) {
@@ -65,6 +88,8 @@ static void nu_custom_cell_renderer_finalize(GObject* object) {
   NUCustomCellRendererPrivate* priv = NU_CUSTOM_CELL_RENDERER(object)->priv;
   priv->options.Table::ColumnOptions::~ColumnOptions();
   priv->value.base::Value::~Value();
+  priv->view.TableValueView::~TableValueView();
+  priv->cache.std::unique_ptr<CellRasterCache>::~unique_ptr();
 
   G_OBJECT_CLASS(nu_custom_cell_renderer_parent_class)->finalize(object);
 }
@@ -73,16 +98,25 @@ static void nu_custom_cell_renderer_set_property(GObject* object,
                                                  guint param_id,
                                                  const GValue* gval,
                                                  GParamSpec* pspec) {
-  if (param_id != PROP_VALUE) {
+  NUCustomCellRendererPrivate* priv = NU_CUSTOM_CELL_RENDERER(object)->priv;
+  if (param_id == PROP_VALUE) {
+    auto* value = static_cast<base::Value*>(g_value_get_pointer(gval));
+    if (value)
+      priv->value = base::Value(std::move(*value));
+    else
+      priv->value = base::Value();
+    priv->view = TableValueView(&priv->value);
+  } else if (param_id == PROP_VALUE_VIEW) {
+    auto* view = static_cast<TableValueView*>(g_value_get_pointer(gval));
+    if (view)
+      priv->view = *view;
+    else
+      priv->view = TableValueView();
+  } else if (param_id == PROP_ROW) {
+    priv->row = g_value_get_int(gval);
+  } else {
     G_OBJECT_WARN_INVALID_PROPERTY_ID(object, param_id, pspec);
-    return;
   }
-  NUCustomCellRendererPrivate* priv = NU_CUSTOM_CELL_RENDERER(object)->priv;
-  auto* value = static_cast<base::Value*>(g_value_get_pointer(gval));
-  if (value)
-    priv->value = base::Value(std::move(*value));
-  else
-    priv->value = base::Value();
 }
 
 static void nu_custom_cell_renderer_get_size(GtkCellRenderer* renderer,
@@ -102,6 +136,19 @@ static void nu_custom_cell_renderer_get_size(GtkCellRenderer* renderer,
     *height = 0;
 }
 
+// Invoke the on_draw callback on |cr|.
+static void DrawCell(NUCustomCellRendererPrivate* priv, cairo_t* cr,
+                     int width, int height) {
+  PainterGtk painter(cr, SizeF(width, height));
+  RectF rect(0, 0, width, height);
+  if (priv->view.type == TableValueView::Type::Value) {
+    priv->options.on_draw(&painter, rect, *priv->view.value);
+  } else {
+    // Typed data only gets converted when the cell is actually drawn.
+    priv->options.on_draw(&painter, rect, priv->view.ToValue());
+  }
+}
+
 static void nu_custom_cell_renderer_render(GtkCellRenderer* cell,
                                            cairo_t* cr,
                                            GtkWidget* widget,
@@ -116,10 +163,33 @@ static void nu_custom_cell_renderer_render(GtkCellRenderer* cell,
   cairo_rectangle(cr, 0, 0, cell_area->width, cell_area->height);
   cairo_clip(cr);
 
-  PainterGtk painter(cr, SizeF(cell_area->width, cell_area->height));
-  priv->options.on_draw(&painter,
-                        nu::RectF(0, 0, cell_area->width, cell_area->height),
-                        priv->value);
+  if (!priv->cache) {
+    DrawCell(priv, cr, cell_area->width, cell_area->height);
+    return;
+  }
+
+  // Reuse the cell drawn before if nothing has changed.
+  CellRasterCache::Key key;
+  key.row = priv->row;
+  key.value_hash = HashTableValueView(priv->view);
+  key.width = cell_area->width;
+  key.height = cell_area->height;
+  key.scale_factor = gtk_widget_get_scale_factor(widget);
+  key.selected = flags & GTK_CELL_RENDERER_SELECTED;
+  cairo_surface_t* surface = priv->cache->Get(key);
+  if (!surface) {
+    surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32,
+                                         key.width * key.scale_factor,
+                                         key.height * key.scale_factor);
+    cairo_surface_set_device_scale(surface, key.scale_factor,
+                                   key.scale_factor);
+    cairo_t* surface_cr = cairo_create(surface);
+    DrawCell(priv, surface_cr, key.width, key.height);
+    cairo_destroy(surface_cr);
+    priv->cache->Put(key, surface);
+  }
+  cairo_set_source_surface(cr, surface, 0, 0);
+  cairo_paint(cr);
 }
 
 static void nu_custom_cell_renderer_init(NUCustomCellRenderer* cell) {
@@ -127,6 +197,9 @@ static void nu_custom_cell_renderer_init(NUCustomCellRenderer* cell) {
   cell->priv = static_cast<NUCustomCellRendererPrivate*>(
       nu_custom_cell_renderer_get_instance_private(cell));
   new(&cell->priv->value) base::Value();
+  new(&cell->priv->view) TableValueView(&cell->priv->value);
+  new(&cell->priv->cache) std::unique_ptr<CellRasterCache>();
+  cell->priv->row = -1;
 }
 
 GtkCellRenderer* nu_custom_cell_renderer_new(
@@ -135,7 +208,28 @@ GtkCellRenderer* nu_custom_cell_renderer_new(
   // Do in-place new since memory has already been allocated.
   NUCustomCellRendererPrivate* priv = NU_CUSTOM_CELL_RENDERER(object)->priv;
   new(&priv->options) Table::ColumnOptions(options);
+  if (options.cache_size > 0)
+    priv->cache = std::make_unique<CellRasterCache>(options.cache_size);
   return GTK_CELL_RENDERER(object);
 }
 
+void nu_custom_cell_renderer_invalidate_rows(GtkCellRenderer* renderer,
+                                             int start, int count) {
+  NUCustomCellRendererPrivate* priv = NU_CUSTOM_CELL_RENDERER(renderer)->priv;
+  if (priv->cache)
+    priv->cache->InvalidateRows(start, count);
+}
+
+void nu_custom_cell_renderer_clear_cache(GtkCellRenderer* renderer) {
+  NUCustomCellRendererPrivate* priv = NU_CUSTOM_CELL_RENDERER(renderer)->priv;
+  if (priv->cache)
+    priv->cache->Clear();
+}
+
+CellRasterCache* nu_custom_cell_renderer_get_cache(GtkCellRenderer* renderer) {
+  if (!NU_IS_CUSTOM_CELL_RENDERER(renderer))
+    return nullptr;
+  return NU_CUSTOM_CELL_RENDERER(renderer)->priv->cache.get();
+}
+
 }  // namespace nu
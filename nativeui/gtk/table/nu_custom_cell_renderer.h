@@ -13,6 +13,8 @@
 
 namespace nu {
 
+class CellRasterCache;
+
 #define NU_TYPE_CUSTOM_CELL_RENDERER (nu_custom_cell_renderer_get_type())
 #define NU_CUSTOM_CELL_RENDERER(obj) (G_TYPE_CHECK_INSTANCE_CAST((obj), \
                                       NU_TYPE_CUSTOM_CELL_RENDERER, \
@@ -37,6 +39,16 @@ GType nu_custom_cell_renderer_get_type();
 GtkCellRenderer* nu_custom_cell_renderer_new(
     const Table::ColumnOptions& options);
 
+// Drop the cached drawings of cells.
+void nu_custom_cell_renderer_invalidate_rows(GtkCellRenderer* renderer,
+                                             int start, int count);
+void nu_custom_cell_renderer_clear_cache(GtkCellRenderer* renderer);
+
+// Internal: Return the cache of drawn cells, nullptr is returned if the
+// |renderer| is not a custom cell renderer or has no cache. Used by tests.
+NATIVEUI_EXPORT CellRasterCache* nu_custom_cell_renderer_get_cache(
+    GtkCellRenderer* renderer);
+
 }  // namespace nu
 
 #endif  // NATIVEUI_GTK_TABLE_NU_CUSTOM_CELL_RENDERER_H_
@@ -171,7 +171,7 @@ static gboolean nu_tree_model_iter_has_child(GtkTreeModel* tree_model,
 static gint nu_tree_model_iter_n_children(GtkTreeModel* tree_model,
                                           GtkTreeIter* iter) {
   NUTreeModelPrivate* priv = NU_TREE_MODEL(tree_model)->priv;
-  return iter ? 0 : priv->table->GetColumnCount();
+  return iter ? 0 : priv->model->GetRowCount();
 }
 
 static gboolean nu_tree_model_iter_nth_child(GtkTreeModel* tree_model,
@@ -208,4 +208,8 @@ NUTreeModel* nu_tree_model_new(Table* table, TableModel* model) {
   return NU_TREE_MODEL(obj);
 }
 
+TableModel* nu_tree_model_get_table_model(NUTreeModel* tree_model) {
+  return tree_model->priv->model;
+}
+
 }  // namespace nu
@@ -36,6 +36,9 @@ struct _NUTreeModelClass {
 GType nu_tree_model_get_type();
 NUTreeModel* nu_tree_model_new(Table* table, TableModel* model);
 
+// Return the TableModel for direct access, which avoids boxing values.
+TableModel* nu_tree_model_get_table_model(NUTreeModel* tree_model);
+
 }  // namespace nu
 
 #endif  // NATIVEUI_GTK_TABLE_NU_TREE_MODEL_H_
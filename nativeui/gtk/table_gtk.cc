@@ -16,6 +16,10 @@ namespace nu {
 
 namespace {
 
+// Changing more rows than this number would make the table reload the model
+// instead of updating row by row.
+const uint32_t kMaxIncrementalRows = 1000;
+
 // Calculate the default row height of cell.
 int GetDefaultRowHeight() {
   // Cache calls.
@@ -87,30 +91,79 @@ void TreeCellData(GtkTreeViewColumn* tree_column,
                   GtkTreeIter* iter,
                   void* user_data) {
   auto* options = static_cast<Table::ColumnOptions*>(user_data);
+  if (!iter->stamp)
+    return;
 
-  // Read value from model.
-  GValue gval = G_VALUE_INIT;
-  gtk_tree_model_get_value(tree_model, iter, options->column, &gval);
-  auto* value = static_cast<base::Value*>(g_value_get_boxed(&gval));
+  // Read value from model, try to borrow the value first and fallback to the
+  // copy when model does not support it.
+  TableModel* model = nu_tree_model_get_table_model(NU_TREE_MODEL(tree_model));
+  gint row = GPOINTER_TO_INT(iter->user_data);
+  base::Value copy;
+  TableValueView view;
+  if (!model->GetValueView(options->column, row, &view)) {
+    copy = model->GetValue(options->column, row);
+    view = TableValueView(&copy);
+  }
 
   // Pass value.
   switch (options->type) {
     case Table::ColumnType::Text:
     case Table::ColumnType::Edit:
-      if (value && value->is_string())
-        g_object_set(renderer, "text", value->GetString().c_str(), nullptr);
+      if (view.is_string())
+        g_object_set(renderer, "text", view.GetCString(), nullptr);
       break;
 
     case Table::ColumnType::Checkbox:
-      if (value && value->is_bool())
-        g_object_set(renderer, "active", value->GetBool(), nullptr);
+      if (view.is_bool())
+        g_object_set(renderer, "active", view.GetBool(), nullptr);
       break;
 
     case Table::ColumnType::Custom:
-      g_object_set(renderer, "value", value, nullptr);
+      // The renderer copies the view, and only materializes the value when
+      // the data is not borrowed from model.
+      g_object_set(renderer, "row", row, nullptr);
+      if (view.type == TableValueView::Type::Value && view.value == &copy)
+        g_object_set(renderer, "value", &copy, nullptr);
+      else
+        g_object_set(renderer, "value-view", &view, nullptr);
       break;
   }
-  g_value_unset(&gval);
+}
+
+// Drop the cached drawings of custom cells in rows, |count| being -1 means
+// all rows.
+void InvalidateCustomCells(GtkTreeView* tree_view, int start, int count) {
+  GList* columns = gtk_tree_view_get_columns(tree_view);
+  for (GList* column = columns; column; column = column->next) {
+    GList* cells = gtk_cell_layout_get_cells(GTK_CELL_LAYOUT(column->data));
+    for (GList* cell = cells; cell; cell = cell->next) {
+      auto* renderer = GTK_CELL_RENDERER(cell->data);
+      if (!NU_IS_CUSTOM_CELL_RENDERER(renderer))
+        continue;
+      if (count == -1)
+        nu_custom_cell_renderer_clear_cache(renderer);
+      else
+        nu_custom_cell_renderer_invalidate_rows(renderer, start, count);
+    }
+    g_list_free(cells);
+  }
+  g_list_free(columns);
+}
+
+// Replace the tree model with a new one, which is much faster than emitting
+// signals for each row when lots of rows have changed.
+void ReloadTreeModel(Table* table,
+                     GtkTreeView* tree_view,
+                     const std::set<int>& selection) {
+  GtkAdjustment* vadjust =
+      gtk_scrollable_get_vadjustment(GTK_SCROLLABLE(tree_view));
+  double position = gtk_adjustment_get_value(vadjust);
+  InvalidateCustomCells(tree_view, 0, -1);
+  NUTreeModel* tree_model = nu_tree_model_new(table, table->GetModel());
+  gtk_tree_view_set_model(tree_view, GTK_TREE_MODEL(tree_model));
+  g_object_unref(tree_model);
+  table->SelectRows(selection);
+  gtk_adjustment_set_value(vadjust, position);
 }
 
 }  // namespace
@@ -144,8 +197,14 @@ void Table::PlatformDestroy() {
 void Table::PlatformSetModel(TableModel* model) {
   auto* tree_view = GTK_TREE_VIEW(g_object_get_data(G_OBJECT(GetNative()),
                                                     "widget"));
+  InvalidateCustomCells(tree_view, 0, -1);
+  if (!model) {
+    gtk_tree_view_set_model(tree_view, nullptr);
+    return;
+  }
   NUTreeModel* tree_model = nu_tree_model_new(this, model);
   gtk_tree_view_set_model(tree_view, GTK_TREE_MODEL(tree_model));
+  g_object_unref(tree_model);
 }
 
 void Table::AddColumnWithOptions(const std::string& title,
@@ -298,39 +357,89 @@ std::set<int> Table::GetSelectedRows() const {
   return rows;
 }
 
-void Table::NotifyRowInsertion(uint32_t row) {
+void Table::NotifyRowsInsertion(uint32_t start, uint32_t count) {
   auto* tree_view = GTK_TREE_VIEW(g_object_get_data(G_OBJECT(GetNative()),
                                                     "widget"));
   auto* tree_model = gtk_tree_view_get_model(tree_view);
   if (!tree_model)
     return;
-  GtkTreeIter iter = {true, GINT_TO_POINTER(row)};
-  GtkTreePath* tree_path = gtk_tree_path_new_from_indices(row, -1);
-  gtk_tree_model_row_inserted(tree_model, tree_path, &iter);
+  if (count > kMaxIncrementalRows) {
+    // Shift the selected rows after the inserted ones.
+    std::set<int> selection;
+    for (int row : GetSelectedRows())
+      selection.insert(row < static_cast<int>(start) ? row : row + count);
+    ReloadTreeModel(this, tree_view, selection);
+    return;
+  }
+  // Rows after |start| are shifted.
+  InvalidateCustomCells(tree_view, 0, -1);
+  GtkTreePath* tree_path = gtk_tree_path_new_from_indices(start, -1);
+  for (uint32_t row = start; row < start + count; ++row) {
+    GtkTreeIter iter = {true, GINT_TO_POINTER(row)};
+    gtk_tree_model_row_inserted(tree_model, tree_path, &iter);
+    gtk_tree_path_next(tree_path);
+  }
   gtk_tree_path_free(tree_path);
 }
 
-void Table::NotifyRowDeletion(uint32_t row) {
+void Table::NotifyRowsDeletion(uint32_t start, uint32_t count) {
   auto* tree_view = GTK_TREE_VIEW(g_object_get_data(G_OBJECT(GetNative()),
                                                     "widget"));
   auto* tree_model = gtk_tree_view_get_model(tree_view);
   if (!tree_model)
     return;
-  GtkTreePath* tree_path = gtk_tree_path_new_from_indices(row, -1);
-  gtk_tree_model_row_deleted(tree_model, tree_path);
+  if (count > kMaxIncrementalRows) {
+    // Remove the deleted rows from selection and shift the rows after them.
+    std::set<int> selection;
+    for (int row : GetSelectedRows()) {
+      if (row < static_cast<int>(start))
+        selection.insert(row);
+      else if (row >= static_cast<int>(start + count))
+        selection.insert(row - count);
+    }
+    ReloadTreeModel(this, tree_view, selection);
+    return;
+  }
+  InvalidateCustomCells(tree_view, 0, -1);
+  // Each deletion shifts the following rows, so always delete at |start|.
+  GtkTreePath* tree_path = gtk_tree_path_new_from_indices(start, -1);
+  for (uint32_t i = 0; i < count; ++i)
+    gtk_tree_model_row_deleted(tree_model, tree_path);
   gtk_tree_path_free(tree_path);
 }
 
-void Table::NotifyValueChange(uint32_t column, uint32_t row) {
+void Table::NotifyRowsChange(uint32_t start, uint32_t count) {
   auto* tree_view = GTK_TREE_VIEW(g_object_get_data(G_OBJECT(GetNative()),
                                                     "widget"));
   auto* tree_model = gtk_tree_view_get_model(tree_view);
   if (!tree_model)
     return;
-  GtkTreeIter iter = {true, GINT_TO_POINTER(row)};
-  GtkTreePath* tree_path = gtk_tree_path_new_from_indices(row, -1);
-  gtk_tree_model_row_changed(tree_model, tree_path, &iter);
+  if (count > kMaxIncrementalRows) {
+    // Values are read lazily when painting, so just redraw.
+    InvalidateCustomCells(tree_view, 0, -1);
+    gtk_widget_queue_draw(GTK_WIDGET(tree_view));
+    return;
+  }
+  InvalidateCustomCells(tree_view, start, count);
+  GtkTreePath* tree_path = gtk_tree_path_new_from_indices(start, -1);
+  for (uint32_t row = start; row < start + count; ++row) {
+    GtkTreeIter iter = {true, GINT_TO_POINTER(row)};
+    gtk_tree_model_row_changed(tree_model, tree_path, &iter);
+    gtk_tree_path_next(tree_path);
+  }
   gtk_tree_path_free(tree_path);
 }
 
+void Table::NotifyValueChange(uint32_t column, uint32_t row) {
+  NotifyRowsChange(row, 1);
+}
+
+void Table::NotifyReset() {
+  auto* tree_view = GTK_TREE_VIEW(g_object_get_data(G_OBJECT(GetNative()),
+                                                    "widget"));
+  if (!gtk_tree_view_get_model(tree_view))
+    return;
+  ReloadTreeModel(this, tree_view, std::set<int>());
+}
+
 }  // namespace nu
@@ -284,6 +284,8 @@ RectF View::GetBoundsInScreen() const {
 }
 
 void View::SetPixelBounds(const Rect& bounds) {
+  if (PerfCounters* counters = perf_counters())
+    counters->set_bounds_count++;
   // The size allocation is relative to the window instead of parent.
   GdkRectangle rect = bounds.ToGdkRectangle();
   if (GetParent()) {
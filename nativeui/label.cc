@@ -9,6 +9,7 @@
 #include "nativeui/app.h"
 #include "nativeui/gfx/attributed_text.h"
 #include "nativeui/gfx/font.h"
+#include "nativeui/util/trace_event.h"
 #include "third_party/yoga/yoga/Yoga.h"
 
 namespace nu {
@@ -18,7 +19,10 @@ namespace {
 YGSize MeasureLabel(YGNodeRef node,
                     float width, YGMeasureMode mode,
                     float height, YGMeasureMode height_mode) {
+  NU_TRACE_EVENT("text", "MeasureLabel");
   auto* label = static_cast<Label*>(YGNodeGetContext(node));
+  if (View::PerfCounters* counters = label->perf_counters())
+    counters->measure_count++;
   SizeF size = label->GetAttributedText()
                     ->GetBoundsFor(SizeF(width, height)).size();
   size.Enlarge(1, 1);  // leave space for border
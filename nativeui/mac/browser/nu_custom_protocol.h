@@ -14,7 +14,8 @@
   nu::ProtocolJob* protocol_job_;
 }
 + (bool)registerProtocol:(NSString*)scheme
-             withHandler:(nu::Browser::ProtocolHandler)handler;
+             withHandler:(nu::Browser::ProtocolHandler)handler
+              threadSafe:(bool)threadSafe;
 + (bool)unregisterProtocol:(NSString*)scheme;
 @end
 
@@ -22,8 +22,13 @@ base::Lock& GetProtocolHandlersLock() {
   return *lock;
 }
 
+struct ProtocolEntry {
+  nu::Browser::ProtocolHandler handler;
+  bool thread_safe = false;
+};
+
 // A map of schemes and handlers.
-using ProtocolHandlerMap = std::map<std::string, nu::Browser::ProtocolHandler>;
+using ProtocolHandlerMap = std::map<std::string, ProtocolEntry>;
 ProtocolHandlerMap& GetProtocolHandlers() {
   static base::NoDestructor<ProtocolHandlerMap> handlers;
   return *handlers;
@@ -34,14 +39,17 @@ ProtocolHandlerMap& GetProtocolHandlers() {
 @implementation NUCustomProtocol
 
 + (bool)registerProtocol:(NSString*)scheme
-             withHandler:(nu::Browser::ProtocolHandler)handler {
+             withHandler:(nu::Browser::ProtocolHandler)handler
+              threadSafe:(bool)threadSafe {
   if (!g_initailized) {
     [NSURLProtocol registerClass:[NUCustomProtocol class]];
     g_initailized = true;
   }
   {
     base::AutoLock auto_lock(GetProtocolHandlersLock());
-    GetProtocolHandlers()[[scheme UTF8String]] = std::move(handler);
+    ProtocolEntry& entry = GetProtocolHandlers()[[scheme UTF8String]];
+    entry.handler = std::move(handler);
+    entry.thread_safe = threadSafe;
   }
   // This private API can make WKWebview aware of our custom protocol class.
   Class cls = NSClassFromString(@"WKBrowsingContextController");
@@ -90,31 +98,48 @@ ProtocolHandlerMap& GetProtocolHandlers() {
 }
 
 - (void)startLoading {
-  // Create job in main thread.
-  __block nu::ProtocolJob* job = nullptr;
   __block std::string scheme([self.request.URL.scheme UTF8String]);
   __block std::string url([[self.request.URL absoluteString] UTF8String]);
-  dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
-  dispatch_async(dispatch_get_main_queue(), ^{
-    nu::Browser::ProtocolHandler handler;
-    {
-      base::AutoLock auto_lock(GetProtocolHandlersLock());
-      auto& handlers = GetProtocolHandlers();
-      auto it = handlers.find(scheme);
-      if (it != handlers.end())
-        handler = it->second;
-    }
-    if (handler) {
-      job = handler(url);
-      if (job)
-        job->AddRef();
-    }
-    // Wake up the thread that waits for the job.
-    dispatch_semaphore_signal(semaphore);
-  });
 
-  // Wait for the protocol job.
-  dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+  // Thread-safe handlers are called directly on the loading thread.
+  nu::Browser::ProtocolHandler thread_safe_handler;
+  {
+    base::AutoLock auto_lock(GetProtocolHandlersLock());
+    auto& handlers = GetProtocolHandlers();
+    auto it = handlers.find(scheme);
+    if (it != handlers.end() && it->second.thread_safe)
+      thread_safe_handler = it->second.handler;
+  }
+
+  __block nu::ProtocolJob* job = nullptr;
+  if (thread_safe_handler) {
+    job = thread_safe_handler(url);
+    if (job)
+      job->AddRef();
+  } else {
+    // Create job in main thread.
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    dispatch_async(dispatch_get_main_queue(), ^{
+      nu::Browser::ProtocolHandler handler;
+      {
+        base::AutoLock auto_lock(GetProtocolHandlersLock());
+        auto& handlers = GetProtocolHandlers();
+        auto it = handlers.find(scheme);
+        if (it != handlers.end())
+          handler = it->second.handler;
+      }
+      if (handler) {
+        job = handler(url);
+        if (job)
+          job->AddRef();
+      }
+      // Wake up the thread that waits for the job.
+      dispatch_semaphore_signal(semaphore);
+    });
+
+    // Wait for the protocol job.
+    dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+  }
   protocol_job_ = job;
   if (!protocol_job_) {
     NSError* error = [NSError errorWithDomain:NSURLErrorDomain
@@ -146,6 +171,14 @@ ProtocolHandlerMap& GetProtocolHandlers() {
                                     freeWhenDone:NO];
       [[self client] URLProtocol:self didLoadData:data];
     }
+    if (protocol_job_->IsFailed()) {
+      NSError* error =
+          [NSError errorWithDomain:NSURLErrorDomain
+                              code:NSURLErrorCannotDecodeContentData
+                          userInfo:nil];
+      [[self client] URLProtocol:self didFailWithError:error];
+      return;
+    }
     // Done.
     [[self client] URLProtocolDidFinishLoading:self];
   });
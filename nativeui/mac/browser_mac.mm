@@ -384,10 +384,12 @@ void Browser::PlatformInstallMouseMoveEvents() {
 }
 
 // static
-bool Browser::RegisterProtocol(const std::string& scheme,
-                               ProtocolHandler handler) {
+bool Browser::PlatformRegisterProtocol(const std::string& scheme,
+                                       ProtocolHandler handler,
+                                       bool thread_safe) {
   return [NUCustomProtocol registerProtocol:base::SysUTF8ToNSString(scheme)
-                                withHandler:std::move(handler)];
+                                withHandler:std::move(handler)
+                                 threadSafe:thread_safe];
 }
 
 // static
@@ -6,6 +6,7 @@
 
 #include "nativeui/gfx/mac/painter_mac.h"
 #include "nativeui/mac/nu_responder.h"
+#include "nativeui/util/trace_event.h"
 
 @implementation NUContainer
 
@@ -36,15 +37,24 @@
 }
 
 - (void)drawRect:(NSRect)dirtyRect {
+  // Containers are painted separately, the frame is recorded by the window.
+  NU_TRACE_EVENT("paint", "NUContainer drawRect");
   nu::Container* shell = static_cast<nu::Container*>([self shell]);
   if (!shell)
     return;
+  base::TimeTicks paint_start;
+  if (nu::View::IsPerfCountersEnabled())
+    paint_start = base::TimeTicks::Now();
 
   nu::RectF dirty(dirtyRect);
   nu::PainterMac painter(self);
   painter.SetColor(background_color_);
   painter.FillRect(dirty);
+  if (shell->on_draw.IsEmpty())
+    return;
+  NU_TRACE_EVENT("paint", "on_draw");
   shell->on_draw.Emit(shell, &painter, dirty);
+  shell->RecordPaint(paint_start);
 }
 
 @end
@@ -201,7 +201,7 @@ bool DispatchMouseEvent(Responder* responder, NSEvent* event) {
       prevent_default = responder->on_mouse_up.Emit(responder, mouse_event);
       break;
     case EventType::MouseMove:
-      responder->on_mouse_move.Emit(responder, mouse_event);
+      responder->DispatchMouseMove(mouse_event);
       prevent_default = true;
       break;
     case EventType::MouseEnter:
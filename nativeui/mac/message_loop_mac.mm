@@ -7,12 +7,41 @@
 #import <Cocoa/Cocoa.h>
 #import <CoreFoundation/CoreFoundation.h>
 
+#include "nativeui/util/task_queue.h"
+
 namespace nu {
 
 namespace {
 
+// Leave time for input events and painting when there are lots of tasks.
+constexpr base::TimeDelta kTaskBudget = base::Milliseconds(8);
+
 unsigned int g_task_id = 0;
 
+TaskQueue* GetTaskQueue();
+
+// A single run loop source runs all posted tasks, which is signaled from any
+// thread when tasks are pushed.
+CFRunLoopSourceRef CreateTaskSource() {
+  CFRunLoopSourceContext context = {};
+  context.perform = [](void*) {
+    GetTaskQueue()->RunTasks(MessageLoop::Priority::Idle, kTaskBudget);
+  };
+  CFRunLoopSourceRef source = CFRunLoopSourceCreate(nullptr, 0, &context);
+  CFRunLoopAddSource(CFRunLoopGetMain(), source, kCFRunLoopCommonModes);
+  return source;
+}
+
+TaskQueue* GetTaskQueue() {
+  // Intentionally leaked, tasks can be posted until the process exits.
+  static TaskQueue* queue = new TaskQueue([](MessageLoop::Priority) {
+    static CFRunLoopSourceRef source = CreateTaskSource();
+    CFRunLoopSourceSignal(source);
+    CFRunLoopWakeUp(CFRunLoopGetMain());
+  });
+  return queue;
+}
+
 }  // namespace
 
 // static
@@ -44,10 +73,12 @@ void MessageLoop::Quit() {
 
 // static
 void MessageLoop::PostTask(Task task) {
-  __block Task callback = std::move(task);
-  dispatch_async(dispatch_get_main_queue(), ^{
-    callback();
-  });
+  PostTaskWithPriority(Priority::Input, std::move(task));
+}
+
+// static
+void MessageLoop::PostTaskWithPriority(Priority priority, Task task) {
+  GetTaskQueue()->Push(priority, std::move(task));
 }
 
 // static
@@ -61,6 +92,12 @@ void MessageLoop::PostDelayedTask(int ms, Task task) {
 
 // static
 void MessageLoop::SetTimer(int ms, RepeatedTask task) {
+  SetTimerWithTolerance(ms, 0, std::move(task));
+}
+
+// static
+void MessageLoop::SetTimerWithTolerance(int ms, int tolerance,
+                                        RepeatedTask task) {
   CFRunLoopRef run_loop = NSRunLoop.mainRunLoop.getCFRunLoop;
   CFRunLoopTimerContext context = { .info = new RepeatedTask(std::move(task)) };
   CFRunLoopTimerRef timer = CFRunLoopTimerCreate(
@@ -73,6 +110,8 @@ void MessageLoop::SetTimer(int ms, RepeatedTask task) {
         }
       },
       &context);
+  if (tolerance > 0)
+    CFRunLoopTimerSetTolerance(timer, static_cast<double>(tolerance) / 1000);
 
   CFRunLoopAddTimer(run_loop, timer, kCFRunLoopCommonModes);
   CFRelease(timer);
@@ -104,6 +143,13 @@ MessageLoop::TimerId MessageLoop::SetTimeout(int ms, Task task) {
   return id;
 }
 
+// static
+MessageLoop::TimerId MessageLoop::SetTimeoutWithTolerance(int ms,
+                                                          int tolerance,
+                                                          Task task) {
+  return SetTimeout(ms, std::move(task));
+}
+
 // static
 void MessageLoop::ClearTimeout(TimerId id) {
   base::AutoLock auto_lock(lock_);
@@ -9,6 +9,7 @@
 
 #include "nativeui/mac/nu_private.h"
 #include "nativeui/mac/nu_responder.h"
+#include "nativeui/util/trace_event.h"
 #include "nativeui/window.h"
 
 namespace nu {
@@ -98,6 +99,14 @@ void SetFrameDisplay(NSWindow* self, SEL _cmd,
   super_impl(self, _cmd, windowFrame, displayViews);
 }
 
+void DisplayIfNeeded(NSWindow* self, SEL _cmd) {
+  // All dirty views of the window are painted in one display pass.
+  NU_TRACE_FRAME("NSWindow displayIfNeeded");
+  auto super_impl = reinterpret_cast<decltype(&DisplayIfNeeded)>(
+      [[self superclass] instanceMethodForSelector:_cmd]);
+  super_impl(self, _cmd);
+}
+
 }  // namespace
 
 void InstallNUWindowMethods(Class cl) {
@@ -121,6 +130,8 @@ void InstallNUWindowMethods(Class cl) {
                   (IMP)ConstrainFrameRect, "^{_NSRect=ffff}@:{_NSRect=ffff}@");
   class_addMethod(cl, @selector(setFrame:display:),
                   (IMP)SetFrameDisplay, "^v@:{_NSRect=ffff}B");
+  class_addMethod(cl, @selector(displayIfNeeded),
+                  (IMP)DisplayIfNeeded, "v@:");
 }
 
 }  // namespace nu
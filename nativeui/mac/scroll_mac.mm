@@ -57,7 +57,7 @@
 }
 
 - (void)onScroll:(NSNotification*)notification {
-  shell_->on_scroll.Emit(shell_);
+  shell_->DispatchScroll();
 }
 
 - (nu::NUViewPrivate*)nuPrivate {
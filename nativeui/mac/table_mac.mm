@@ -245,20 +245,32 @@ std::set<int> Table::GetSelectedRows() const {
   return selection;
 }
 
-void Table::NotifyRowInsertion(uint32_t row) {
+void Table::NotifyRowsInsertion(uint32_t start, uint32_t count) {
   auto* tableView = static_cast<NSTableView*>(
       [static_cast<NUTable*>(GetNative()) documentView]);
-  [tableView insertRowsAtIndexes:[NSIndexSet indexSetWithIndex:row]
+  [tableView insertRowsAtIndexes:[NSIndexSet indexSetWithIndexesInRange:
+                                      NSMakeRange(start, count)]
                    withAnimation:NSTableViewAnimationEffectNone];
 }
 
-void Table::NotifyRowDeletion(uint32_t row) {
+void Table::NotifyRowsDeletion(uint32_t start, uint32_t count) {
   auto* tableView = static_cast<NSTableView*>(
       [static_cast<NUTable*>(GetNative()) documentView]);
-  [tableView removeRowsAtIndexes:[NSIndexSet indexSetWithIndex:row]
+  [tableView removeRowsAtIndexes:[NSIndexSet indexSetWithIndexesInRange:
+                                      NSMakeRange(start, count)]
                    withAnimation:NSTableViewAnimationEffectNone];
 }
 
+void Table::NotifyRowsChange(uint32_t start, uint32_t count) {
+  auto* tableView = static_cast<NSTableView*>(
+      [static_cast<NUTable*>(GetNative()) documentView]);
+  NSRange columns = NSMakeRange(0, [tableView numberOfColumns]);
+  [tableView reloadDataForRowIndexes:[NSIndexSet indexSetWithIndexesInRange:
+                                          NSMakeRange(start, count)]
+                       columnIndexes:[NSIndexSet
+                                         indexSetWithIndexesInRange:columns]];
+}
+
 void Table::NotifyValueChange(uint32_t column, uint32_t row) {
   auto* tableView = static_cast<NSTableView*>(
       [static_cast<NUTable*>(GetNative()) documentView]);
@@ -266,4 +278,10 @@ void Table::NotifyValueChange(uint32_t column, uint32_t row) {
                        columnIndexes:[NSIndexSet indexSetWithIndex:column]];
 }
 
+void Table::NotifyReset() {
+  auto* tableView = static_cast<NSTableView*>(
+      [static_cast<NUTable*>(GetNative()) documentView]);
+  [tableView reloadData];
+}
+
 }  // namespace nu
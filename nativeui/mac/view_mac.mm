@@ -83,6 +83,8 @@ void View::TakeOverView(NativeView view) {
 }
 
 void View::SetBounds(const RectF& bounds) {
+  if (PerfCounters* counters = perf_counters())
+    counters->set_bounds_count++;
   NSRect frame = bounds.ToCGRect();
   [view_ setFrame:frame];
   // Calling setFrame manually does not trigger resizeSubviewsWithOldSize.
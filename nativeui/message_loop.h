@@ -27,13 +27,29 @@ class NATIVEUI_EXPORT MessageLoop {
   // repeating the function.
   using RepeatedTask = std::function<bool()>;
 
+  // Tasks with higher priority run first. On Linux the priorities are also
+  // relative to the events processed by GTK, e.g. Layout tasks run before the
+  // widgets are resized, and Paint tasks run before they are redrawn.
+  enum class Priority {
+    Input,  // same with input events, used by PostTask
+    Layout,
+    Paint,
+    Idle,
+  };
+
   // Control message loop.
   static void Run();
   static void Quit();
   static void PostTask(Task task);
+  static void PostTaskWithPriority(Priority priority, Task task);
   static void PostDelayedTask(int ms, Task task);
   static void SetTimer(int ms, RepeatedTask task);
 
+  // The timer may fire up to |tolerance| milliseconds late, so it can be
+  // merged with other timers to reduce wakeups. The tolerance is a hint and
+  // may be ignored on some platforms.
+  static void SetTimerWithTolerance(int ms, int tolerance, RepeatedTask task);
+
   // Internal: Cancellable timers.
 #if defined(OS_WIN)
   using TimerId = UINT_PTR;
@@ -41,6 +57,7 @@ class NATIVEUI_EXPORT MessageLoop {
   using TimerId = unsigned int;
 #endif
   static TimerId SetTimeout(int ms, Task task);
+  static TimerId SetTimeoutWithTolerance(int ms, int tolerance, Task task);
   static void ClearTimeout(TimerId id);
 
  private:
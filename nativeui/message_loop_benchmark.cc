@@ -0,0 +1,91 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <thread>
+#include <vector>
+
+#include "nativeui/message_loop.h"
+#include "nativeui/test/benchmark.h"
+#include "nativeui/util/timer_wheel.h"
+
+namespace {
+
+// Post |range| tasks and run the loop until all of them are done.
+void BM_MessageLoopPostTask(nu::BenchmarkState* state) {
+  int64_t tasks = state->range(0);
+  while (state->KeepRunning()) {
+    int64_t done = 0;
+    for (int64_t i = 0; i < tasks; ++i) {
+      nu::MessageLoop::PostTask([&done, tasks]() {
+        if (++done == tasks)
+          nu::MessageLoop::Quit();
+      });
+    }
+    nu::MessageLoop::Run();
+  }
+  state->SetItemsProcessed(state->iterations() * tasks);
+}
+NU_BENCHMARK(BM_MessageLoopPostTask)->Arg(10000);
+
+// Post |range| tasks from 4 threads while the loop is running.
+void BM_MessageLoopPostTaskFromThreads(nu::BenchmarkState* state) {
+  const int kThreads = 4;
+  int64_t tasks = state->range(0);
+  while (state->KeepRunning()) {
+    int64_t done = 0;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+      threads.emplace_back([&done, tasks]() {
+        for (int64_t i = 0; i < tasks / kThreads; ++i) {
+          nu::MessageLoop::PostTask([&done, tasks]() {
+            if (++done == tasks / kThreads * kThreads)
+              nu::MessageLoop::Quit();
+          });
+        }
+      });
+    }
+    nu::MessageLoop::Run();
+    for (std::thread& thread : threads)
+      thread.join();
+  }
+  state->SetItemsProcessed(state->iterations() * tasks);
+}
+NU_BENCHMARK(BM_MessageLoopPostTaskFromThreads)->Arg(10000);
+
+// Run |range| concurrent timeouts expiring within 16ms.
+void BM_MessageLoopTimeouts(nu::BenchmarkState* state) {
+  int64_t timers = state->range(0);
+  while (state->KeepRunning()) {
+    int64_t fired = 0;
+    for (int64_t i = 0; i < timers; ++i) {
+      nu::MessageLoop::SetTimeout(static_cast<int>(i % 16) + 1,
+                                  [&fired, timers]() {
+        if (++fired == timers)
+          nu::MessageLoop::Quit();
+      });
+    }
+    nu::MessageLoop::Run();
+  }
+  state->SetItemsProcessed(state->iterations() * timers);
+}
+NU_BENCHMARK(BM_MessageLoopTimeouts)->Arg(10000);
+
+void BM_TimerWheelAddAndExpire(nu::BenchmarkState* state) {
+  int64_t timers = state->range(0);
+  std::vector<nu::TimerWheel::TimerId> expired;
+  expired.reserve(timers);
+  int64_t now = 0;
+  while (state->KeepRunning()) {
+    nu::TimerWheel wheel(now);
+    for (int64_t i = 0; i < timers; ++i)
+      wheel.Add(static_cast<nu::TimerWheel::TimerId>(i), now + i % 5000);
+    expired.clear();
+    now += 5000;
+    wheel.Advance(now, &expired);
+  }
+  state->SetItemsProcessed(state->iterations() * timers);
+}
+NU_BENCHMARK(BM_TimerWheelAddAndExpire)->Arg(10000);
+
+}  // namespace
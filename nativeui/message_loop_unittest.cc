@@ -2,7 +2,11 @@
 // Use of this source code is governed by the license that can be found in the
 // LICENSE file.
 
+#include <thread>
+#include <vector>
+
 #include "nativeui/nativeui.h"
+#include "nativeui/util/timer_wheel.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 class MessageLoopTest : public testing::Test {
@@ -41,3 +45,120 @@ TEST_F(MessageLoopTest, SetTimer) {
   nu::MessageLoop::Run();
   ASSERT_EQ(count, 3);
 }
+
+TEST_F(MessageLoopTest, PostTaskWithPriority) {
+  std::vector<nu::MessageLoop::Priority> order;
+  for (auto priority : {nu::MessageLoop::Priority::Idle,
+                        nu::MessageLoop::Priority::Paint,
+                        nu::MessageLoop::Priority::Layout,
+                        nu::MessageLoop::Priority::Input}) {
+    nu::MessageLoop::PostTaskWithPriority(priority, [&order, priority]() {
+      order.push_back(priority);
+      if (order.size() == 4)
+        nu::MessageLoop::Quit();
+    });
+  }
+  nu::MessageLoop::Run();
+  EXPECT_EQ(order, std::vector<nu::MessageLoop::Priority>({
+      nu::MessageLoop::Priority::Input,
+      nu::MessageLoop::Priority::Layout,
+      nu::MessageLoop::Priority::Paint,
+      nu::MessageLoop::Priority::Idle}));
+}
+
+TEST_F(MessageLoopTest, PostTaskFromThreads) {
+  const int kThreads = 4;
+  const int kTasks = 10000;
+  int count = 0;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&count]() {
+      for (int j = 0; j < kTasks; ++j) {
+        nu::MessageLoop::PostTask([&count]() {
+          if (++count == kThreads * kTasks)
+            nu::MessageLoop::Quit();
+        });
+      }
+    });
+  }
+  nu::MessageLoop::Run();
+  for (std::thread& thread : threads)
+    thread.join();
+  EXPECT_EQ(count, kThreads * kTasks);
+}
+
+TEST_F(MessageLoopTest, SetTimerWithTolerance) {
+  int count = 0;
+  nu::MessageLoop::SetTimerWithTolerance(10, 5, [&count]() {
+    if (++count == 3) {
+      nu::MessageLoop::Quit();
+      return false;
+    } else {
+      return true;
+    }
+  });
+  nu::MessageLoop::Run();
+  ASSERT_EQ(count, 3);
+}
+
+TEST_F(MessageLoopTest, ManyTimeouts) {
+  const int kTimers = 1000;
+  std::vector<int> fired;
+  std::vector<nu::MessageLoop::TimerId> ids;
+  for (int i = 0; i < kTimers; ++i) {
+    ids.push_back(nu::MessageLoop::SetTimeout(i % 50, [&fired, i]() {
+      fired.push_back(i);
+    }));
+  }
+  // Clearing timers is safe before and after they fire.
+  for (int i = 0; i < kTimers; i += 2)
+    nu::MessageLoop::ClearTimeout(ids[i]);
+  nu::MessageLoop::PostDelayedTask(100, []() {
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+  for (nu::MessageLoop::TimerId id : ids)
+    nu::MessageLoop::ClearTimeout(id);
+  ASSERT_EQ(fired.size(), static_cast<size_t>(kTimers / 2));
+  for (int i : fired)
+    EXPECT_EQ(i % 2, 1);
+}
+
+TEST(TimerWheelTest, Expire) {
+  nu::TimerWheel wheel(1000);
+  wheel.Add(1, 1010);
+  wheel.Add(2, 1005);
+  wheel.Add(3, 1000 + 100000);
+  wheel.Add(4, 1010);
+  EXPECT_TRUE(wheel.Remove(4));
+  EXPECT_FALSE(wheel.Remove(5));
+  EXPECT_EQ(wheel.GetNextWakeup(), 1005);
+  std::vector<nu::TimerWheel::TimerId> expired;
+  wheel.Advance(1020, &expired);
+  EXPECT_EQ(expired, std::vector<nu::TimerWheel::TimerId>({2, 1}));
+  EXPECT_EQ(wheel.size(), 1u);
+  // Wake up earlier than deadline to move timers between levels.
+  EXPECT_LE(wheel.GetNextWakeup(), 1000 + 100000);
+  expired.clear();
+  wheel.Advance(1000 + 99999, &expired);
+  EXPECT_TRUE(expired.empty());
+  wheel.Advance(1000 + 100000, &expired);
+  EXPECT_EQ(expired, std::vector<nu::TimerWheel::TimerId>({3}));
+  EXPECT_EQ(wheel.GetNextWakeup(), -1);
+}
+
+TEST(TimerWheelTest, Tolerance) {
+  nu::TimerWheel wheel(1000);
+  // Timers with close deadlines are aligned to the same tick.
+  wheel.Add(1, 1001, 16);
+  wheel.Add(2, 1009, 16);
+  wheel.Add(3, 1015, 16);
+  EXPECT_EQ(wheel.GetNextWakeup(), 1008);
+  std::vector<nu::TimerWheel::TimerId> expired;
+  wheel.Advance(1008, &expired);
+  EXPECT_EQ(expired.size(), 1u);
+  wheel.Advance(1024, &expired);
+  EXPECT_EQ(expired.size(), 3u);
+  EXPECT_EQ(nu::TimerWheel::AlignDeadline(1001, 0), 1001);
+  EXPECT_EQ(nu::TimerWheel::AlignDeadline(1001, 20), 1008);
+}
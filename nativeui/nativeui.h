@@ -5,6 +5,7 @@
 #ifndef NATIVEUI_NATIVEUI_H_
 #define NATIVEUI_NATIVEUI_H_
 
+#include "nativeui/animator.h"
 #include "nativeui/app.h"
 #include "nativeui/appearance.h"
 #include "nativeui/browser.h"
@@ -39,6 +40,7 @@
 #include "nativeui/notification_center.h"
 #include "nativeui/progress_bar.h"
 #include "nativeui/protocol_asar_job.h"
+#include "nativeui/protocol_mapped_job.h"
 #include "nativeui/screen.h"
 #include "nativeui/scroll.h"
 #include "nativeui/separator.h"
@@ -47,7 +49,9 @@
 #include "nativeui/tab.h"
 #include "nativeui/table.h"
 #include "nativeui/table_model.h"
+#include "nativeui/task_runner.h"
 #include "nativeui/text_edit.h"
+#include "nativeui/thread_pool.h"
 #include "nativeui/tray.h"
 #include "nativeui/window.h"
 
@@ -6,6 +6,8 @@
 
 #include <string.h>
 
+#include <algorithm>
+
 #include "base/logging.h"
 #include "nativeui/asar_archive.h"
 
@@ -13,31 +15,16 @@ namespace nu {
 
 namespace {
 
-// The old asar extension name.
-const base::FilePath::CharType kOldAsarExt[] = FILE_PATH_LITERAL(".asar");
+// Size of encrypted data read and decrypted at once.
+const size_t kReadAheadSize = 64 * 1024;
 
 }  // namespace
 
 ProtocolAsarJob::ProtocolAsarJob(const base::FilePath& asar,
                                  const std::string& path)
-    : ProtocolFileJob(asar) {
-  // Do nothing if the asar file does not exist.
-  if (!file_.IsValid())
-    return;
-
-  // Read asar.
-  AsarArchive archive(file_.Duplicate(), !asar.MatchesExtension(kOldAsarExt));
-  AsarArchive::FileInfo info;
-  if (!archive.IsValid() ||
-      !archive.GetFileInfo(path, &info)) {
-    file_.Close();
-    return;
-  }
-
-  // Seek to the position of the path.
-  file_.Seek(base::File::FROM_BEGIN, info.offset);
-  path_ = base::FilePath::FromUTF8Unsafe(path);
-  content_length_ = info.size;
+    : ProtocolFileJob(base::FilePath::FromUTF8Unsafe(path)),
+      asar_path_(asar),
+      path_in_asar_(path) {
 }
 
 ProtocolAsarJob::~ProtocolAsarJob() {
@@ -49,73 +36,184 @@ bool ProtocolAsarJob::SetDecipher(const std::string& key,
 }
 
 bool ProtocolAsarJob::Start() {
-  if (!aes_.IsValid())
-    return ProtocolFileJob::Start();
+  if (!Open())
+    return false;
+  if (info_.integrity && info_.integrity->block_size == 0) {
+    LOG(ERROR) << "Malformed integrity info of " << path_;
+    return false;
+  }
+  if (info_.compressed) {
+    // Decompress while reading so the file is never fully buffered.
+    inflater_ = std::make_unique<Inflater>([this](uint8_t* buf, size_t size) {
+      return ReadDecrypted(buf, size);
+    });
+    notify_content_length(static_cast<int>(info_.uncompressed_size));
+  } else if (aes_.IsValid()) {
+    // Don't pass content length when stream is encrypted, since the decrypted
+    // size might be smaller.
+    notify_content_length(-1);
+  } else {
+    notify_content_length(static_cast<int>(content_length_));
+  }
+  return true;
+}
+
+bool ProtocolAsarJob::Open() {
+  file_.Initialize(asar_path_, base::File::FLAG_OPEN | base::File::FLAG_READ);
   if (!file_.IsValid())
     return false;
-  // Don't pass content length when stream is encrypted, since the decrypted
-  // size might be smaller.
-  notify_content_length(-1);
+
+  // Read asar, the parsed archive is shared by all jobs.
+  archive_ = AsarArchive::Open(asar_path_, &file_,
+                               AsarArchive::IsExtendedFormat(asar_path_));
+  if (!archive_ || !archive_->GetFileInfo(path_in_asar_, &info_)) {
+    file_.Close();
+    return false;
+  }
+
+  // Seek to the position of the path.
+  file_.Seek(base::File::FROM_BEGIN, info_.offset);
+  content_length_ = info_.size;
   return true;
 }
 
 size_t ProtocolAsarJob::Read(void* buf, size_t buf_size) {
-  if (!aes_.IsValid())
-    return ProtocolFileJob::Read(buf, buf_size);
+  if (!inflater_)
+    return ReadDecrypted(buf, buf_size);
+  if (inflater_->IsFailed())
+    return 0;
+  size_t nread = inflater_->Read(static_cast<uint8_t*>(buf), buf_size);
+  if (inflater_->IsFailed()) {
+    LOG(ERROR) << "The compressed data of " << path_ << " is corrupted";
+    set_failed();
+  }
+  return nread;
+}
 
-  if (buf_size < remaining_)
-    return 0;  // this is unlikely to happen
+size_t ProtocolAsarJob::ReadDecrypted(void* buf, size_t buf_size) {
+  if (!aes_.IsValid())
+    return ReadVerified(buf, buf_size);
 
-  // Read as much as we can.
-  size_t nread = ProtocolFileJob::Read(static_cast<char*>(buf) + remaining_,
-                                       buf_size - remaining_);
-  if (nread == 0) {
-    if (remaining_ != 0) {
-      LOG(ERROR) << "The encrypted stream stored in asar is not aligned to "
-                 << AES_BLOCKLEN << "bytes";
+  // Serve from decrypted data, which works for any size of read.
+  uint8_t* out = static_cast<uint8_t*>(buf);
+  size_t nread = 0;
+  while (nread < buf_size) {
+    if (begin_ == ready_) {
+      if (!FillDecrypted())
+        break;
+      continue;
     }
-    return 0;
+    size_t n = std::min(buf_size - nread, ready_ - begin_);
+    memcpy(out + nread, buffer_.data() + begin_, n);
+    begin_ += n;
+    nread += n;
   }
+  return nread;
+}
 
-  // Put the remaining data of last read into buf, as if it was read this time.
-  if (remaining_ > 0) {
-    memcpy(buf, buffer_, remaining_);
-    nread += remaining_;
+bool ProtocolAsarJob::FillDecrypted() {
+  if (finished_ || corrupted_)
+    return false;
+  if (buffer_.empty())
+    buffer_.resize(kReadAheadSize + 2 * AES_BLOCKLEN);
+
+  // Move the held back block and encrypted tail to the front.
+  size_t pending = end_ - ready_;
+  memmove(buffer_.data(), buffer_.data() + ready_, pending);
+  decrypted_ -= ready_;
+  begin_ = ready_ = 0;
+  end_ = pending;
+
+  // Read ahead as much as the buffer can hold.
+  while (end_ < buffer_.size()) {
+    size_t n = ReadVerified(buffer_.data() + end_, buffer_.size() - end_);
+    if (n == 0)
+      break;
+    end_ += n;
+  }
+  bool eof = bytes_left() == 0;
+  if (!eof && end_ == pending) {
+    finished_ = true;
+    set_failed();
+    return false;
   }
 
-  // Handle the data in alignment of 16 bytes.
-  uint8_t* in = static_cast<uint8_t*>(buf);
-  uint8_t* out = static_cast<uint8_t*>(buf);
-  remaining_ = nread;
-  while (remaining_ >= AES_BLOCKLEN) {
-    // Fill buffer with 16 bytes and move pointers forward.
-    memcpy(buffer_, in, AES_BLOCKLEN);
-    in += AES_BLOCKLEN;
-    remaining_ -= AES_BLOCKLEN;
-    // Write to output buffer with decrypted data.
-    aes_.CBCDecryptBuffer(buffer_, AES_BLOCKLEN);
-    memcpy(out, buffer_, AES_BLOCKLEN);
-    out += AES_BLOCKLEN;
+  // Decrypt the data aligned to 16 bytes in place.
+  size_t aligned = (end_ - decrypted_) / AES_BLOCKLEN * AES_BLOCKLEN;
+  aes_.CBCDecryptBuffer(buffer_.data() + decrypted_,
+                        static_cast<uint32_t>(aligned));
+  decrypted_ += aligned;
+
+  if (!eof) {
+    ready_ = decrypted_ >= AES_BLOCKLEN ? decrypted_ - AES_BLOCKLEN : 0;
+    return true;
   }
 
-  // Determine the padding when all data has been read.
-  if (content_length_ == 0) {
-    int paddings = buffer_[AES_BLOCKLEN - 1];
-    if (nread < paddings + remaining_)
-      return 0;  // likely a corrupted padding value
-    // We should probably do some verification, but we don't really care when
-    // the encryption is corrupted.
-    nread -= paddings;
+  // Remove the PKCS#7 paddings at the end of stream.
+  finished_ = true;
+  if (decrypted_ != end_) {
+    LOG(ERROR) << "The encrypted stream stored in asar is not aligned to "
+               << AES_BLOCKLEN << " bytes";
+    set_failed();
+    return false;
   }
+  size_t paddings = decrypted_ > 0 ? buffer_[decrypted_ - 1] : 0;
+  if (paddings == 0 || paddings > AES_BLOCKLEN || paddings > decrypted_) {
+    LOG(ERROR) << "The encrypted stream stored in asar has invalid paddings";
+    set_failed();
+    return false;
+  }
+  for (size_t i = decrypted_ - paddings; i < decrypted_; ++i) {
+    if (buffer_[i] != paddings) {
+      LOG(ERROR) << "The encrypted stream stored in asar has invalid paddings";
+      set_failed();
+      return false;
+    }
+  }
+  ready_ = decrypted_ - paddings;
+  return true;
+}
 
-  // Still have some data left, leave it to the next read.
-  DCHECK(remaining_ < AES_BLOCKLEN);
-  memcpy(buffer_, in, remaining_);
+size_t ProtocolAsarJob::ReadVerified(void* buf, size_t buf_size) {
+  if (!info_.integrity)
+    return ProtocolFileJob::Read(buf, buf_size);
+  if (corrupted_)
+    return 0;
 
-  // Return the bytes we decrypted.
-  // FIXME(zcbenz): The stream would end when we can not get 16 bytes in one
-  // read, we should probably improve our API to fix this.
-  return nread - remaining_;
+  uint8_t* out = static_cast<uint8_t*>(buf);
+  size_t nread = 0;
+  while (nread < buf_size) {
+    // Read and verify next block when current one is consumed.
+    if (block_pos_ == block_.size()) {
+      if (content_length_ == 0)
+        break;
+      size_t size = static_cast<size_t>(std::min<int64_t>(
+          content_length_, info_.integrity->block_size));
+      block_.resize(size);
+      block_pos_ = 0;
+      size_t filled = 0;
+      while (filled < size) {
+        size_t n = ProtocolFileJob::Read(block_.data() + filled,
+                                         size - filled);
+        if (n == 0)
+          break;
+        filled += n;
+      }
+      if (filled != size ||
+          !AsarArchive::VerifyBlock(info_, block_index_++, block_)) {
+        LOG(ERROR) << "Integrity check failed for " << path_;
+        corrupted_ = true;
+        block_.clear();
+        set_failed();
+        return 0;
+      }
+    }
+    size_t n = std::min(buf_size - nread, block_.size() - block_pos_);
+    memcpy(out + nread, block_.data() + block_pos_, n);
+    block_pos_ += n;
+    nread += n;
+  }
+  return nread;
 }
 
 }  // namespace nu
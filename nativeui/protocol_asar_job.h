@@ -5,10 +5,14 @@
 #ifndef NATIVEUI_PROTOCOL_ASAR_JOB_H_
 #define NATIVEUI_PROTOCOL_ASAR_JOB_H_
 
+#include <memory>
 #include <string>
+#include <vector>
 
+#include "nativeui/asar_archive.h"
 #include "nativeui/protocol_file_job.h"
 #include "nativeui/util/aes.h"
+#include "nativeui/util/inflater.h"
 
 namespace nu {
 
@@ -27,11 +31,54 @@ class NATIVEUI_EXPORT ProtocolAsarJob : public ProtocolFileJob {
   bool Start() override;
   size_t Read(void* buf, size_t buf_size) override;
 
+  // ProtocolFileJob:
+  bool Open() override;
+
   AES aes_;
 
-  // Buffer used to store remaining encrypted data.
-  uint8_t buffer_[AES_BLOCKLEN];
-  size_t remaining_ = 0;
+ private:
+  // Read the data after decrypting, which is the compressed data for
+  // compressed files.
+  size_t ReadDecrypted(void* buf, size_t buf_size);
+
+  // Read ahead a chunk of encrypted data and decrypt it into |buffer_|,
+  // returns false when no more data can be read.
+  bool FillDecrypted();
+
+  // Read the data stored in archive, when the file has integrity info each
+  // block is verified before any of its data is returned.
+  size_t ReadVerified(void* buf, size_t buf_size);
+
+  // Number of stored bytes that have not been returned.
+  int64_t bytes_left() const {
+    return content_length_ + static_cast<int64_t>(block_.size() - block_pos_);
+  }
+
+  base::FilePath asar_path_;
+  std::string path_in_asar_;
+  scoped_refptr<AsarArchive> archive_;
+  AsarArchive::FileInfo info_;
+
+  // The verified block being read.
+  std::vector<uint8_t> block_;
+  size_t block_pos_ = 0;
+  size_t block_index_ = 0;
+  bool corrupted_ = false;
+
+  // Decrypted data is stored in |buffer_| as:
+  // | served | ready to serve | last decrypted block | encrypted tail |
+  // 0        begin_           ready_                 decrypted_       end_
+  // The last decrypted block is held back until the end of stream is known,
+  // since it may contain paddings.
+  std::vector<uint8_t> buffer_;
+  size_t begin_ = 0;
+  size_t ready_ = 0;
+  size_t decrypted_ = 0;
+  size_t end_ = 0;
+  bool finished_ = false;
+
+  // Decompresses the data returned by ReadDecrypted.
+  std::unique_ptr<Inflater> inflater_;
 };
 
 }  // namespace nu
@@ -151,16 +151,14 @@ bool GetMimeTypeFromExtension(const base::FilePath::StringType& ext,
 }  // namespace
 
 ProtocolFileJob::ProtocolFileJob(const base::FilePath& path)
-    : path_(path),
-      file_(path, base::File::FLAG_OPEN | base::File::FLAG_READ),
-      content_length_(file_.IsValid() ? file_.GetLength() : 0) {
+    : path_(path) {
 }
 
 ProtocolFileJob::~ProtocolFileJob() {
 }
 
 bool ProtocolFileJob::Start() {
-  if (!file_.IsValid())
+  if (!Open())
     return false;
   notify_content_length(content_length_);
   return true;
@@ -171,10 +169,7 @@ void ProtocolFileJob::Kill() {
 }
 
 bool ProtocolFileJob::GetMimeType(std::string* mime_type) {
-  base::FilePath::StringType ext = path_.Extension();
-  if (ext.empty())
-    return false;
-  return GetMimeTypeFromExtension(ext.substr(1), mime_type);
+  return GetMimeTypeFromPath(path_, mime_type);
 }
 
 size_t ProtocolFileJob::Read(void* buf, size_t buf_size) {
@@ -193,4 +188,23 @@ size_t ProtocolFileJob::Read(void* buf, size_t buf_size) {
   }
 }
 
+bool ProtocolFileJob::IsThreadSafe() const {
+  return true;
+}
+
+bool ProtocolFileJob::Open() {
+  file_.Initialize(path_, base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!file_.IsValid())
+    return false;
+  content_length_ = file_.GetLength();
+  return content_length_ >= 0;
+}
+
+bool GetMimeTypeFromPath(const base::FilePath& path, std::string* mime_type) {
+  base::FilePath::StringType ext = path.Extension();
+  if (ext.empty())
+    return false;
+  return GetMimeTypeFromExtension(ext.substr(1), mime_type);
+}
+
 }  // namespace nu
@@ -14,6 +14,9 @@
 namespace nu {
 
 // Serve file for the protocol request.
+//
+// The job is started in the thread pool, subclasses accessing states bound to
+// the GUI thread must override IsThreadSafe to return false.
 class NATIVEUI_EXPORT ProtocolFileJob : public ProtocolJob {
  public:
   explicit ProtocolFileJob(const base::FilePath& path);
@@ -23,15 +26,23 @@ class NATIVEUI_EXPORT ProtocolFileJob : public ProtocolJob {
   void Kill() override;
   bool GetMimeType(std::string* mime_type) override;
   size_t Read(void* buf, size_t buf_size) override;
+  bool IsThreadSafe() const override;
 
  protected:
   ~ProtocolFileJob() override;
 
+  // Open the file and compute the content length, which is done when the job
+  // starts so the blocking I/O can happen in the thread pool.
+  virtual bool Open();
+
   base::FilePath path_;
   base::File file_;
   int64_t content_length_ = 0;
 };
 
+// Internal: Guess the mime type from the extension of |path|.
+bool GetMimeTypeFromPath(const base::FilePath& path, std::string* mime_type);
+
 }  // namespace nu
 
 #endif  // NATIVEUI_PROTOCOL_FILE_JOB_H_
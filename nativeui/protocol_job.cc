@@ -7,10 +7,78 @@
 #include <string.h>
 
 #include <algorithm>
+#include <memory>
+#include <optional>
 #include <utility>
 
+#include "nativeui/message_loop.h"
+#include "nativeui/task_runner.h"
+
 namespace nu {
 
+namespace {
+
+// The callback may hold objects bound to the GUI thread, so it is shared by
+// the tasks and only destroyed on the GUI thread.
+using SharedCallback = std::shared_ptr<ProtocolJobCallback>;
+
+void RunCallback(const SharedCallback& callback,
+                 scoped_refptr<ProtocolJob> job,
+                 int content_length) {
+  ProtocolJobCallback func = std::move(*callback);
+  *callback = nullptr;
+  func(std::move(job), content_length);
+}
+
+// Start |job| in the thread pool, the caller must have added a reference to
+// the |job| which is released on the GUI thread.
+void StartInThreadPool(ProtocolJob* job, SharedCallback callback) {
+  auto content_length = std::make_shared<std::optional<int>>();
+  TaskRunner::GetMain()->PostTaskAndReply(
+      [job, content_length]() {
+        job->Plug([content_length](int size) { *content_length = size; });
+        if (!job->Start())
+          content_length->reset();
+      },
+      [job, content_length, callback]() {
+        scoped_refptr<ProtocolJob> ref(job);
+        job->Release();
+        if (content_length->has_value())
+          RunCallback(callback, std::move(ref), content_length->value());
+        else
+          RunCallback(callback, nullptr, 0);
+      });
+}
+
+// Start the |job| created by handler on the GUI thread.
+void StartJob(ProtocolJob* raw, SharedCallback callback) {
+  scoped_refptr<ProtocolJob> job(raw);
+  if (!job) {
+    RunCallback(callback, nullptr, 0);
+    return;
+  }
+  // The reference is released after the job has started.
+  job->AddRef();
+  if (job->IsThreadSafe()) {
+    StartInThreadPool(raw, std::move(callback));
+    return;
+  }
+  // Jobs started on the GUI thread may notify after Start returns.
+  auto notified = std::make_shared<bool>(false);
+  job->Plug([raw, callback, notified](int size) {
+    *notified = true;
+    RunCallback(callback, raw, size);
+    // Still inside the job's method, release it later.
+    MessageLoop::PostTask([raw]() { raw->Release(); });
+  });
+  if (!job->Start() && !*notified) {
+    job->Release();
+    RunCallback(callback, nullptr, 0);
+  }
+}
+
+}  // namespace
+
 ///////////////////////////////////////////////////////////////////////////////
 // ProtocolJob implementation.
 
@@ -28,10 +96,39 @@ bool ProtocolJob::Start() {
 void ProtocolJob::Kill() {
 }
 
+bool ProtocolJob::IsThreadSafe() const {
+  return false;
+}
+
 void ProtocolJob::Plug(std::function<void(int)> func) {
   notify_content_length = std::move(func);
 }
 
+base::span<const uint8_t> ProtocolJob::GetMemory() {
+  return base::span<const uint8_t>();
+}
+
+void StartProtocolJob(std::function<ProtocolJob*(std::string)> handler,
+                      bool handler_thread_safe,
+                      std::string url,
+                      ProtocolJobCallback callback) {
+  auto shared_callback =
+      std::make_shared<ProtocolJobCallback>(std::move(callback));
+  if (!handler_thread_safe) {
+    StartJob(handler(std::move(url)), std::move(shared_callback));
+    return;
+  }
+  // The job created in the thread pool is adopted on the GUI thread.
+  auto job = std::make_shared<ProtocolJob*>(nullptr);
+  TaskRunner::GetMain()->PostTaskAndReply(
+      [handler = std::move(handler), url = std::move(url), job]() {
+        *job = handler(url);
+      },
+      [job, shared_callback]() {
+        StartJob(*job, shared_callback);
+      });
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // ProtocolStringJob implementation.
 
@@ -63,4 +160,8 @@ size_t ProtocolStringJob::Read(void* buf, size_t buf_size) {
   return nread;
 }
 
+base::span<const uint8_t> ProtocolStringJob::GetMemory() {
+  return base::as_bytes(base::make_span(content_));
+}
+
 }  // namespace nu
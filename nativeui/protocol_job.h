@@ -8,6 +8,7 @@
 #include <functional>
 #include <string>
 
+#include "base/containers/span.h"
 #include "base/memory/ref_counted.h"
 #include "nativeui/nativeui_export.h"
 #include "nativeui/util/leak_tracker.h"
@@ -23,9 +24,26 @@ class NATIVEUI_EXPORT ProtocolJob : public base::RefCounted<ProtocolJob> {
   virtual bool GetMimeType(std::string* mime_type) = 0;
   virtual size_t Read(void* buf, size_t buf_size) = 0;
 
+  // Whether the job has failed while reading, in which case Read returns 0
+  // and the request should fail instead of finishing with partial data.
+  bool IsFailed() const { return failed_; }
+
+  // Whether the job can be started and read on threads other than the GUI
+  // thread, jobs doing blocking I/O should return true so they are started
+  // in the thread pool.
+  //
+  // Thread-safe jobs must notify the content length before Start returns, and
+  // must only be referenced and released on the GUI thread.
+  virtual bool IsThreadSafe() const;
+
   // Internal: Used by Browser implementations to plug adapters.
   void Plug(std::function<void(int)> start);
 
+  // Internal: Return the whole response if it is already in memory after the
+  // job has started, which can be served without copying. The memory must
+  // stay valid until the job is destroyed.
+  virtual base::span<const uint8_t> GetMemory();
+
  protected:
   friend class base::RefCounted<ProtocolJob>;
 
@@ -35,9 +53,30 @@ class NATIVEUI_EXPORT ProtocolJob : public base::RefCounted<ProtocolJob> {
   // Used by subclasses to notify the browser.
   std::function<void(int)> notify_content_length;
 
+  // Used by subclasses to mark the job as failed.
+  void set_failed() { failed_ = true; }
+
   LeakTracker<ProtocolJob> leak_tracker_;
+
+ private:
+  bool failed_ = false;
 };
 
+// Internal: Create a job for |url| with |handler| and start it, the
+// |callback| is called on the GUI thread with the started job and its content
+// length, or with null when the job failed to be created or started.
+//
+// When |handler_thread_safe| is true the |handler| is called in the thread
+// pool. Thread-safe jobs are always started in the thread pool, otherwise the
+// job is started on the GUI thread.
+using ProtocolJobCallback =
+    std::function<void(scoped_refptr<ProtocolJob> job, int content_length)>;
+NATIVEUI_EXPORT void StartProtocolJob(
+    std::function<ProtocolJob*(std::string)> handler,
+    bool handler_thread_safe,
+    std::string url,
+    ProtocolJobCallback callback);
+
 // Use string as response.
 class NATIVEUI_EXPORT ProtocolStringJob : public ProtocolJob {
  public:
@@ -46,6 +85,7 @@ class NATIVEUI_EXPORT ProtocolStringJob : public ProtocolJob {
   bool Start() override;
   bool GetMimeType(std::string* mime_type) override;
   size_t Read(void* buf, size_t buf_size) override;
+  base::span<const uint8_t> GetMemory() override;
 
  protected:
   ~ProtocolStringJob() override;
@@ -0,0 +1,182 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/protocol_mapped_job.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "nativeui/protocol_file_job.h"
+
+namespace nu {
+
+ProtocolMappedJob::ProtocolMappedJob(const base::FilePath& asar,
+                                     const std::string& path)
+    : path_(base::FilePath::FromUTF8Unsafe(path)),
+      asar_path_(asar),
+      path_in_asar_(path) {
+}
+
+ProtocolMappedJob::~ProtocolMappedJob() {
+}
+
+bool ProtocolMappedJob::Start() {
+  file_.Initialize(asar_path_, base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!file_.IsValid())
+    return false;
+  archive_ = AsarArchive::Open(asar_path_, &file_,
+                               AsarArchive::IsExtendedFormat(asar_path_));
+  if (!archive_ || !archive_->GetFileInfo(path_in_asar_, &info_)) {
+    archive_ = nullptr;
+    file_.Close();
+    return false;
+  }
+  data_ = archive_->GetFileData(info_);
+  // The file is only kept when the content can not be read from mapping.
+  if (data_.size() == info_.size)
+    file_.Close();
+  // The mapping reflects later writes to the archive, so files with integrity
+  // info are copied out before verification, and only the verified copy is
+  // served.
+  if (info_.integrity && data_.size() == info_.size) {
+    copy_.assign(data_.begin(), data_.end());
+    data_ = copy_;
+  }
+
+  if (info_.integrity && info_.integrity->block_size == 0) {
+    LOG(ERROR) << "Malformed integrity info of " << path_;
+    return false;
+  }
+  if (info_.compressed) {
+    inflater_ = std::make_unique<Inflater>([this](uint8_t* buf, size_t size) {
+      return ReadStored(buf, size);
+    });
+    notify_content_length(static_cast<int>(info_.uncompressed_size));
+  } else {
+    // Files served from memory are verified as a whole, which is done here
+    // since Start is called in the thread pool while GetMemory is not.
+    if (data_.size() == info_.size)
+      memory_verified_ = VerifyUntil(info_.size);
+    notify_content_length(static_cast<int>(info_.size));
+  }
+  return true;
+}
+
+bool ProtocolMappedJob::GetMimeType(std::string* mime_type) {
+  return GetMimeTypeFromPath(path_, mime_type);
+}
+
+size_t ProtocolMappedJob::Read(void* buf, size_t buf_size) {
+  if (!inflater_)
+    return ReadStored(buf, buf_size);
+  if (inflater_->IsFailed())
+    return 0;
+  size_t nread = inflater_->Read(static_cast<uint8_t*>(buf), buf_size);
+  if (inflater_->IsFailed()) {
+    LOG(ERROR) << "The compressed data of " << path_ << " is corrupted";
+    set_failed();
+  }
+  return nread;
+}
+
+size_t ProtocolMappedJob::ReadStored(void* buf, size_t buf_size) {
+  if (data_.size() != info_.size)
+    return ReadUnmapped(buf, buf_size);
+  size_t nread = std::min(buf_size, info_.size - pos_);
+  if (nread == 0)
+    return 0;
+  if (!VerifyUntil(pos_ + nread)) {
+    set_failed();
+    return 0;
+  }
+  memcpy(buf, data_.data() + pos_, nread);
+  pos_ += nread;
+  return nread;
+}
+
+size_t ProtocolMappedJob::ReadUnmapped(void* buf, size_t buf_size) {
+  if (IsFailed())
+    return 0;
+  const AsarArchive::Integrity* integrity = info_.integrity;
+  if (!integrity) {
+    size_t nread = std::min(buf_size, info_.size - pos_);
+    if (nread == 0)
+      return 0;
+    int result = file_.Read(info_.offset + pos_, static_cast<char*>(buf),
+                            static_cast<int>(nread));
+    if (result <= 0) {
+      set_failed();
+      return 0;
+    }
+    pos_ += result;
+    return result;
+  }
+
+  // Serve from the verified block, so the file is read only once and the
+  // data returned is always the data that has been verified.
+  uint8_t* out = static_cast<uint8_t*>(buf);
+  size_t nread = 0;
+  while (nread < buf_size) {
+    if (block_pos_ == block_.size()) {
+      if (pos_ == info_.size)
+        break;
+      size_t size = std::min<size_t>(integrity->block_size,
+                                     info_.size - pos_);
+      block_.resize(size);
+      block_pos_ = 0;
+      if (file_.Read(info_.offset + pos_,
+                     reinterpret_cast<char*>(block_.data()),
+                     static_cast<int>(size)) != static_cast<int>(size) ||
+          !AsarArchive::VerifyBlock(info_, verified_blocks_, block_)) {
+        LOG(ERROR) << "Integrity check failed for " << path_;
+        block_.clear();
+        set_failed();
+        return 0;
+      }
+      pos_ += size;
+      ++verified_blocks_;
+    }
+    size_t n = std::min(buf_size - nread, block_.size() - block_pos_);
+    memcpy(out + nread, block_.data() + block_pos_, n);
+    block_pos_ += n;
+    nread += n;
+  }
+  return nread;
+}
+
+bool ProtocolMappedJob::IsThreadSafe() const {
+  return true;
+}
+
+base::span<const uint8_t> ProtocolMappedJob::GetMemory() {
+  // The whole file is served at once so all blocks must have been verified,
+  // and compressed files can only be streamed.
+  if (!memory_verified_)
+    return base::span<const uint8_t>();
+  return data_;
+}
+
+bool ProtocolMappedJob::VerifyUntil(size_t end) {
+  const AsarArchive::Integrity* integrity = info_.integrity;
+  if (!integrity)
+    return true;
+  if (corrupted_ || integrity->block_size == 0)
+    return false;
+  while (verified_blocks_ * integrity->block_size < end) {
+    size_t start = verified_blocks_ * integrity->block_size;
+    size_t size = std::min<size_t>(integrity->block_size, info_.size - start);
+    if (!AsarArchive::VerifyBlock(info_, verified_blocks_,
+                                  data_.subspan(start, size))) {
+      LOG(ERROR) << "Integrity check failed for " << path_;
+      corrupted_ = true;
+      return false;
+    }
+    ++verified_blocks_;
+  }
+  return true;
+}
+
+}  // namespace nu
@@ -0,0 +1,79 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_PROTOCOL_MAPPED_JOB_H_
+#define NATIVEUI_PROTOCOL_MAPPED_JOB_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "nativeui/asar_archive.h"
+#include "nativeui/protocol_job.h"
+#include "nativeui/util/inflater.h"
+
+namespace nu {
+
+// Serve a file inside asar archive from the memory mapping of archive.
+class NATIVEUI_EXPORT ProtocolMappedJob : public ProtocolJob {
+ public:
+  ProtocolMappedJob(const base::FilePath& asar, const std::string& path);
+
+  // ProtocolJob:
+  bool Start() override;
+  bool GetMimeType(std::string* mime_type) override;
+  size_t Read(void* buf, size_t buf_size) override;
+  bool IsThreadSafe() const override;
+  base::span<const uint8_t> GetMemory() override;
+
+ protected:
+  ~ProtocolMappedJob() override;
+
+ private:
+  // Read the data stored in archive.
+  size_t ReadStored(void* buf, size_t buf_size);
+
+  // Read the file when the archive can not be mapped, when the file has
+  // integrity info each block is verified before any of its data is returned.
+  size_t ReadUnmapped(void* buf, size_t buf_size);
+
+  // Verify the mapped blocks of file up to |end|, files without integrity
+  // info always pass.
+  bool VerifyUntil(size_t end);
+
+  base::FilePath path_;
+  base::FilePath asar_path_;
+  std::string path_in_asar_;
+  scoped_refptr<AsarArchive> archive_;
+  AsarArchive::FileInfo info_;
+  base::span<const uint8_t> data_;
+  size_t pos_ = 0;
+
+  // Blocks are verified in order when they are first read.
+  size_t verified_blocks_ = 0;
+  bool corrupted_ = false;
+
+  // Whether the whole mapped file has been verified in Start, and can be
+  // served from memory.
+  bool memory_verified_ = false;
+
+  // Files with integrity info are served from a copy of the mapping.
+  std::vector<uint8_t> copy_;
+
+  // Used to read file when the archive can not be mapped.
+  base::File file_;
+
+  // The verified block being read when the archive can not be mapped.
+  std::vector<uint8_t> block_;
+  size_t block_pos_ = 0;
+
+  // Decompresses the stored data of compressed files.
+  std::unique_ptr<Inflater> inflater_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_PROTOCOL_MAPPED_JOB_H_
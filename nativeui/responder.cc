@@ -4,6 +4,8 @@
 
 #include "nativeui/responder.h"
 
+#include "nativeui/events/event_coalescer.h"
+
 namespace nu {
 
 Responder::Responder() {
@@ -19,6 +21,65 @@ Responder::Responder() {
 
 Responder::~Responder() = default;
 
+void Responder::SetEventCoalescing(EventCoalescing coalescing) {
+  event_coalescing_ = coalescing;
+  // Deliver the pending events now.
+  if (coalescing == EventCoalescing::None) {
+    // The handlers may release the responder.
+    scoped_refptr<Responder> self(this);
+    FlushCoalescedEvents();
+  }
+}
+
+void Responder::SetKeepCoalescedEvents(bool keep) {
+  keep_coalesced_events_ = keep;
+  if (!keep)
+    coalesced_events_.clear();
+}
+
+void Responder::DispatchMouseMove(const MouseEvent& event) {
+  if (on_mouse_move.IsEmpty())
+    return;
+  // The handler may release the responder.
+  scoped_refptr<Responder> self(this);
+  if (event_coalescing_ == EventCoalescing::None) {
+    if (keep_coalesced_events_)
+      coalesced_events_.push_back(event);
+    pending_mouse_move_ = event;
+    FlushMouseMove();
+    return;
+  }
+  if (keep_coalesced_events_) {
+    coalesced_events_.push_back(event);
+    coalesced_events_.back().native_event = nullptr;
+  }
+  pending_mouse_move_ = event;
+  if (!mouse_move_coalescer_) {
+    mouse_move_coalescer_ = std::make_unique<EventCoalescer>(
+        std::bind(&Responder::FlushMouseMove, this));
+  }
+  mouse_move_coalescer_->Request();
+  // The native event is gone when the event is delivered later.
+  if (pending_mouse_move_)
+    pending_mouse_move_->native_event = nullptr;
+}
+
+void Responder::FlushCoalescedEvents() {
+  if (mouse_move_coalescer_)
+    mouse_move_coalescer_->Flush();
+}
+
+void Responder::FlushMouseMove() {
+  if (!pending_mouse_move_)
+    return;
+  // The handler may release the responder.
+  scoped_refptr<Responder> self(this);
+  MouseEvent event = std::move(*pending_mouse_move_);
+  pending_mouse_move_.reset();
+  on_mouse_move.Emit(this, event);
+  coalesced_events_.clear();
+}
+
 void Responder::InitResponder(NativeResponder native, Type type) {
   responder_ = native;
   type_ = type;
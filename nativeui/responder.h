@@ -5,14 +5,18 @@
 #ifndef NATIVEUI_RESPONDER_H_
 #define NATIVEUI_RESPONDER_H_
 
+#include <memory>
+#include <optional>
+#include <vector>
+
 #include "base/memory/ref_counted.h"
+#include "nativeui/events/event.h"
 #include "nativeui/signal.h"
 #include "nativeui/types.h"
 
 namespace nu {
 
-struct MouseEvent;
-struct KeyEvent;
+class EventCoalescer;
 
 class NATIVEUI_EXPORT Responder : public SignalDelegate,
                                   public base::RefCounted<Responder> {
@@ -39,6 +43,30 @@ class NATIVEUI_EXPORT Responder : public SignalDelegate,
   };
   Type GetType() const { return type_; }
 
+  // How continuous events like mouse moves are delivered.
+  enum class EventCoalescing {
+    // Deliver every event.
+    None,
+    // Deliver at most one event per frame, with the latest data.
+    Frame,
+  };
+  void SetEventCoalescing(EventCoalescing coalescing);
+  EventCoalescing GetEventCoalescing() const { return event_coalescing_; }
+
+  // Record the mouse move events merged into one on_mouse_move event, which
+  // is useful for drawing apps that need every point.
+  void SetKeepCoalescedEvents(bool keep);
+  bool IsKeepCoalescedEvents() const { return keep_coalesced_events_; }
+
+  // Return the events merged into current on_mouse_move event, including the
+  // delivered one. Only valid in on_mouse_move handlers.
+  const std::vector<MouseEvent>& GetCoalescedEvents() const {
+    return coalesced_events_;
+  }
+
+  // Internal: Deliver the mouse move event with respect of coalescing.
+  void DispatchMouseMove(const MouseEvent& event);
+
   // Events.
   Signal<bool(Responder*, const MouseEvent&)> on_mouse_down;
   Signal<bool(Responder*, const MouseEvent&)> on_mouse_up;
@@ -57,6 +85,9 @@ class NATIVEUI_EXPORT Responder : public SignalDelegate,
 
   void InitResponder(NativeResponder native, Type type);
 
+  // Deliver the events held by coalescing.
+  virtual void FlushCoalescedEvents();
+
   // SignalDelegate:
   void OnConnect(int identifier) override;
 
@@ -68,11 +99,20 @@ class NATIVEUI_EXPORT Responder : public SignalDelegate,
   // Event types.
   enum { kOnMouseClick, kOnMouseMove, kOnKey };
 
+  void FlushMouseMove();
+
   // Whether events have been installed.
   bool on_mouse_click_installed_ = false;
   bool on_mouse_move_installed_ = false;
   bool on_key_installed_ = false;
 
+  // Coalescing of mouse move events.
+  EventCoalescing event_coalescing_ = EventCoalescing::None;
+  bool keep_coalesced_events_ = false;
+  std::unique_ptr<EventCoalescer> mouse_move_coalescer_;
+  std::optional<MouseEvent> pending_mouse_move_;
+  std::vector<MouseEvent> coalesced_events_;
+
   Type type_;
   NativeResponder responder_ = nullptr;
 };
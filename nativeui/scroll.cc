@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "nativeui/container.h"
+#include "nativeui/events/event_coalescer.h"
 #include "nativeui/gfx/geometry/size_conversions.h"
 
 namespace nu {
@@ -43,6 +44,27 @@ const char* Scroll::GetClassName() const {
   return kClassName;
 }
 
+void Scroll::DispatchScroll() {
+  if (GetEventCoalescing() == EventCoalescing::None) {
+    on_scroll.Emit(this);
+    return;
+  }
+  // Scroll events carry no data, so merging them only needs a flag.
+  if (!scroll_coalescer_) {
+    scroll_coalescer_ = std::make_unique<EventCoalescer>([this]() {
+      scoped_refptr<Scroll> self(this);
+      on_scroll.Emit(this);
+    });
+  }
+  scroll_coalescer_->Request();
+}
+
+void Scroll::FlushCoalescedEvents() {
+  View::FlushCoalescedEvents();
+  if (scroll_coalescer_)
+    scroll_coalescer_->Flush();
+}
+
 void Scroll::OnConnect(int identifier) {
   View::OnConnect(identifier);
   if (identifier == kOnScroll)
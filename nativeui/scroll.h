@@ -5,6 +5,7 @@
 #ifndef NATIVEUI_SCROLL_H_
 #define NATIVEUI_SCROLL_H_
 
+#include <memory>
 #include <tuple>
 
 #include "nativeui/view.h"
@@ -18,6 +19,8 @@
 
 namespace nu {
 
+class EventCoalescer;
+
 class NATIVEUI_EXPORT Scroll : public View {
  public:
   Scroll();
@@ -60,6 +63,9 @@ class NATIVEUI_EXPORT Scroll : public View {
   // View:
   const char* GetClassName() const override;
 
+  // Internal: Deliver the scroll event with respect of coalescing.
+  void DispatchScroll();
+
   // Events.
   Signal<bool(Scroll*)> on_scroll;
 
@@ -72,6 +78,9 @@ class NATIVEUI_EXPORT Scroll : public View {
 
   enum { kOnScroll };
 
+  // Responder:
+  void FlushCoalescedEvents() override;
+
   // SignalDelegate:
   void OnConnect(int identifier) override;
 
@@ -84,6 +93,7 @@ class NATIVEUI_EXPORT Scroll : public View {
 #endif
 
   scoped_refptr<View> content_view_;
+  std::unique_ptr<EventCoalescer> scroll_coalescer_;
 };
 
 }  // namespace nu
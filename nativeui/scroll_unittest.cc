@@ -48,3 +48,42 @@ TEST_F(ScrollTest, Scroll) {
   scroll_->SetScrollPosition(std::get<0>(range), std::get<1>(range));
   EXPECT_EQ(scroll_->GetScrollPosition(), range);
 }
+
+TEST_F(ScrollTest, CoalesceScrollEvents) {
+  int count = 0;
+  scroll_->on_scroll.Connect([&count](nu::Scroll*) {
+    ++count;
+    return false;
+  });
+  scroll_->SetEventCoalescing(nu::Responder::EventCoalescing::Frame);
+  // The first event is delivered immediately, and the rest are merged into
+  // one event at the end of frame.
+  for (int i = 0; i < 10; ++i)
+    scroll_->DispatchScroll();
+  EXPECT_EQ(count, 1);
+  nu::MessageLoop::PostDelayedTask(100, []() {
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+  EXPECT_EQ(count, 2);
+}
+
+TEST_F(ScrollTest, DisableEventCoalescingFlushesPendingScroll) {
+  int count = 0;
+  scroll_->on_scroll.Connect([&count](nu::Scroll*) {
+    ++count;
+    return false;
+  });
+  scroll_->SetEventCoalescing(nu::Responder::EventCoalescing::Frame);
+  for (int i = 0; i < 10; ++i)
+    scroll_->DispatchScroll();
+  EXPECT_EQ(count, 1);
+  scroll_->SetEventCoalescing(nu::Responder::EventCoalescing::None);
+  EXPECT_EQ(count, 2);
+  // Nothing is delivered at the end of frame.
+  nu::MessageLoop::PostDelayedTask(100, []() {
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+  EXPECT_EQ(count, 2);
+}
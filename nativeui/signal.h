@@ -11,7 +11,9 @@
 #include <vector>
 
 #include "base/check.h"
+#include "base/memory/ref_counted.h"
 #include "nativeui/nativeui_export.h"
+#include "nativeui/util/trace_event.h"
 
 namespace nu {
 
@@ -22,6 +24,10 @@ class SignalDelegate {
 };
 
 // A simple signal/slot implementation.
+//
+// The slots are stored in a copy-on-write list: emitting only holds a
+// reference to current list, and changing slots during emission creates a
+// new list, so emitting does not allocate memory.
 template<typename Sig> class SignalBase {
  public:
   using Slot = std::function<Sig>;
@@ -33,35 +39,63 @@ template<typename Sig> class SignalBase {
 
   int Connect(Slot slot) {
     CHECK(slot);
-    if (delegate_ && slots_.empty())
+    if (delegate_ && IsEmpty())
       delegate_->OnConnect(identifier_);
-    slots_.push_back(std::make_pair(++next_id_, std::move(slot)));
+    GetMutableSlots()->push_back(std::make_pair(++next_id_, std::move(slot)));
     return next_id_;
   }
 
   void Disconnect(int id) {
-    auto iter = std::lower_bound(slots_.begin(), slots_.end(),
+    if (!slots_)
+      return;
+    auto iter = std::lower_bound(slots_->slots.begin(), slots_->slots.end(),
                                  id, TupleCompare);
-    if (iter != slots_.end() && std::get<0>(*iter) == id)
-      slots_.erase(iter);
+    if (iter == slots_->slots.end() || std::get<0>(*iter) != id)
+      return;
+    // The list might be copied, so erase by index.
+    size_t index = iter - slots_->slots.begin();
+    auto* slots = GetMutableSlots();
+    slots->erase(slots->begin() + index);
   }
 
   void DisconnectAll() {
-    slots_.clear();
+    // Do not touch the list that is being emitted.
+    slots_ = nullptr;
   }
 
   bool IsEmpty() const {
-    return slots_.empty();
+    return !slots_ || slots_->slots.empty();
   }
 
  protected:
+  struct SlotList : public base::RefCounted<SlotList> {
+    SlotList() = default;
+    explicit SlotList(const std::vector<std::pair<int, Slot>>& slots)
+        : slots(slots) {}
+
+    std::vector<std::pair<int, Slot>> slots;
+
+   private:
+    friend class base::RefCounted<SlotList>;
+    ~SlotList() = default;
+  };
+
   // Use the first element of tuple as comparing key.
   static bool TupleCompare(const std::pair<int, Slot>& element, int key) {
     return element.first < key;
   }
 
+  // Return the list for modifying, which is copied if it is being emitted.
+  std::vector<std::pair<int, Slot>>* GetMutableSlots() {
+    if (!slots_)
+      slots_ = new SlotList;
+    else if (!slots_->HasOneRef())
+      slots_ = new SlotList(slots_->slots);
+    return &slots_->slots;
+  }
+
   int next_id_ = 0;
-  std::vector<std::pair<int, Slot>> slots_;
+  scoped_refptr<SlotList> slots_;
 
   int identifier_ = 0;
   SignalDelegate* delegate_ = nullptr;
@@ -77,10 +111,14 @@ class Signal<void(Args...)> : public SignalBase<void(Args...)> {
 
   template<typename... EmitArgs>
   void Emit(EmitArgs&&... args) {
-    // Copy the list before iterating, since it is possible that user removes
-    // elements from the list when iterating.
-    auto slots = this->slots_;
-    for (auto& slot : slots)
+    // Hold a reference to the list, so it is copied instead of modified when
+    // user changes slots when iterating.
+    scoped_refptr<typename Base::SlotList> slots = this->slots_;
+    if (!slots)
+      return;
+    // Most slots are script callbacks, trace them as a whole.
+    NU_TRACE_EVENT("callback", "Signal::Emit");
+    for (auto& slot : slots->slots)
       slot.second(std::forward<EmitArgs>(args)...);
   }
 };
@@ -93,10 +131,13 @@ class Signal<bool(Args...)> : public SignalBase<bool(Args...)> {
 
   template<typename... EmitArgs>
   bool Emit(EmitArgs&&... args) {
-    // Copy the list before iterating, since it is possible that user removes
-    // elements from the list when iterating.
-    auto slots = this->slots_;
-    for (auto& slot : slots) {
+    // Hold a reference to the list, so it is copied instead of modified when
+    // user changes slots when iterating.
+    scoped_refptr<typename Base::SlotList> slots = this->slots_;
+    if (!slots)
+      return false;
+    NU_TRACE_EVENT("callback", "Signal::Emit");
+    for (auto& slot : slots->slots) {
       if (slot.second(std::forward<EmitArgs>(args)...))
         return true;
     }
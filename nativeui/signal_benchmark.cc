@@ -0,0 +1,30 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/signal.h"
+#include "nativeui/test/benchmark.h"
+
+namespace {
+
+void BM_SignalEmit(nu::BenchmarkState* state) {
+  nu::Signal<void(int)> signal;
+  int sum = 0;
+  for (int64_t i = 0; i < state->range(0); ++i)
+    signal.Connect([&sum](int value) { sum += value; });
+  while (state->KeepRunning())
+    signal.Emit(1);
+  state->SetItemsProcessed(sum);
+}
+NU_BENCHMARK(BM_SignalEmit)->Arg(1)->Arg(4)->Arg(16);
+
+void BM_SignalEmitWithResult(nu::BenchmarkState* state) {
+  nu::Signal<bool(int)> signal;
+  for (int64_t i = 0; i < state->range(0); ++i)
+    signal.Connect([](int value) { return value < 0; });
+  while (state->KeepRunning())
+    signal.Emit(1);
+}
+NU_BENCHMARK(BM_SignalEmitWithResult)->Arg(1)->Arg(4)->Arg(16);
+
+}  // namespace
@@ -29,3 +29,41 @@ TEST_F(SignalTest, ZeroCopy) {
   });
   signal.Emit(Copiable());
 }
+
+TEST_F(SignalTest, DisconnectWhenEmitting) {
+  nu::Signal<void()> signal;
+  int first = 0, second = 0;
+  int id = 0;
+  id = signal.Connect([&]() {
+    ++first;
+    signal.Disconnect(id);
+  });
+  signal.Connect([&]() {
+    ++second;
+    signal.DisconnectAll();
+  });
+  // Changes made when emitting only affect next emission.
+  signal.Emit();
+  EXPECT_EQ(first, 1);
+  EXPECT_EQ(second, 1);
+  EXPECT_TRUE(signal.IsEmpty());
+  signal.Emit();
+  EXPECT_EQ(first, 1);
+}
+
+TEST_F(SignalTest, ConnectWhenEmitting) {
+  nu::Signal<bool()> signal;
+  int count = 0;
+  signal.Connect([&]() {
+    ++count;
+    signal.Connect([&]() {
+      ++count;
+      return false;
+    });
+    return false;
+  });
+  EXPECT_FALSE(signal.Emit());
+  EXPECT_EQ(count, 1);
+  EXPECT_FALSE(signal.Emit());
+  EXPECT_EQ(count, 3);
+}
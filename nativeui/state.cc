@@ -8,6 +8,7 @@
 
 #include "base/lazy_instance.h"
 #include "base/threading/thread_local.h"
+#include "nativeui/animator.h"
 #include "nativeui/appearance.h"
 #include "nativeui/gfx/font.h"
 #include "nativeui/global_shortcut.h"
@@ -122,6 +123,12 @@ Appearance* State::GetAppearance() {
   return appearance_.get();
 }
 
+Animator* State::GetAnimator() {
+  if (!animator_)
+    animator_.reset(new Animator);
+  return animator_.get();
+}
+
 GlobalShortcut* State::GetGlobalShortcut() {
   if (!global_shortcut_)
     global_shortcut_.reset(new GlobalShortcut);
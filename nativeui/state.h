@@ -24,6 +24,7 @@ class ScopedCOMInitializer;
 
 namespace nu {
 
+class Animator;
 class Appearance;
 class Font;
 class GlobalShortcut;
@@ -82,6 +83,9 @@ class NATIVEUI_EXPORT State {
   // Internal: Return the appearance object
   Appearance* GetAppearance();
 
+  // Internal: Return the animator object
+  Animator* GetAnimator();
+
   // Internal: Return the globalShortcut object
   GlobalShortcut* GetGlobalShortcut();
 
@@ -126,6 +130,7 @@ class NATIVEUI_EXPORT State {
   std::unique_ptr<Appearance> appearance_;
   std::unique_ptr<GlobalShortcut> global_shortcut_;
   std::unique_ptr<NotificationCenter> notification_center_;
+  std::unique_ptr<Animator> animator_;
   scoped_refptr<Font> default_font_;
 
   // The app instance.
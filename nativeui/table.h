@@ -40,6 +40,10 @@ class NATIVEUI_EXPORT Table : public View {
     int column = -1;
     // Initial width.
     int width = -1;
+    // How many drawn cells to cache when type is Custom, the on_draw is not
+    // called again for cached cells until their values change. 0 disables
+    // the cache.
+    int cache_size = 0;
   };
 
   Table();
@@ -85,9 +89,11 @@ class NATIVEUI_EXPORT Table : public View {
   friend class TableModel;
 
   // Called by TableModel.
-  void NotifyRowInsertion(uint32_t row);
-  void NotifyRowDeletion(uint32_t row);
+  void NotifyRowsInsertion(uint32_t start, uint32_t count);
+  void NotifyRowsDeletion(uint32_t start, uint32_t count);
+  void NotifyRowsChange(uint32_t start, uint32_t count);
   void NotifyValueChange(uint32_t column, uint32_t row);
+  void NotifyReset();
 
   scoped_refptr<TableModel> model_;
 };
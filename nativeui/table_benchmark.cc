@@ -0,0 +1,118 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <utility>
+#include <vector>
+
+#include "base/strings/string_number_conversions.h"
+#include "nativeui/nativeui.h"
+#include "nativeui/test/benchmark.h"
+
+#if defined(OS_LINUX)
+#include <gtk/gtk.h>
+#endif
+
+namespace {
+
+using ColumnType = nu::ColumnarTableModel::ColumnType;
+
+scoped_refptr<nu::ColumnarTableModel> CreateColumnarModel(uint32_t rows) {
+  scoped_refptr<nu::ColumnarTableModel> model = new nu::ColumnarTableModel(
+      {ColumnType::String, ColumnType::Integer, ColumnType::Double});
+  model->Reserve(rows);
+  std::vector<base::Value> row(3);
+  for (uint32_t i = 0; i < rows; ++i) {
+    row[0] = base::Value("row " + base::NumberToString(i));
+    // A deterministic shuffle of the order.
+    row[1] = base::Value(static_cast<int>((i * 2654435761u) % rows));
+    row[2] = base::Value(i * 0.5);
+    model->AddRow(row);
+  }
+  return model;
+}
+
+void BM_SimpleTableModelGetValue(nu::BenchmarkState* state) {
+  uint32_t rows = static_cast<uint32_t>(state->range(0));
+  scoped_refptr<nu::SimpleTableModel> model = new nu::SimpleTableModel(2);
+  for (uint32_t i = 0; i < rows; ++i) {
+    std::vector<base::Value> row;
+    row.emplace_back("row " + base::NumberToString(i));
+    row.emplace_back(static_cast<int>(i));
+    model->AddRow(std::move(row));
+  }
+  uint32_t row = 0;
+  while (state->KeepRunning()) {
+    model->GetValue(0, row);
+    row = (row + 1) % rows;
+  }
+}
+NU_BENCHMARK(BM_SimpleTableModelGetValue)->Arg(10000);
+
+void BM_ColumnarTableModelGetValueView(nu::BenchmarkState* state) {
+  uint32_t rows = static_cast<uint32_t>(state->range(0));
+  scoped_refptr<nu::ColumnarTableModel> model = CreateColumnarModel(rows);
+  nu::TableValueView view;
+  uint32_t row = 0;
+  while (state->KeepRunning()) {
+    model->GetValueView(0, row, &view);
+    row = (row + 1) % rows;
+  }
+}
+NU_BENCHMARK(BM_ColumnarTableModelGetValueView)->Arg(10000);
+
+// Sort a large model by its integer column, alternating the direction.
+void BM_SortFilterTableModelSort(nu::BenchmarkState* state) {
+  scoped_refptr<nu::ColumnarTableModel> source =
+      CreateColumnarModel(static_cast<uint32_t>(state->range(0)));
+  scoped_refptr<nu::SortFilterTableModel> model =
+      new nu::SortFilterTableModel(source);
+  nu::SortFilterTableModel::SortKey key;
+  key.column = 1;
+  while (state->KeepRunning()) {
+    key.ascending = !key.ascending;
+    model->SetSortKeys({key});
+  }
+  state->SetItemsProcessed(state->iterations() * state->range(0));
+}
+NU_BENCHMARK(BM_SortFilterTableModelSort)->Arg(1000000)->Iterations(5);
+
+#if defined(OS_LINUX)
+// Scroll a table with a large model page by page, and draw the visible rows
+// into an offscreen surface like a frame would do.
+void BM_TableScroll(nu::BenchmarkState* state) {
+  scoped_refptr<nu::Window> window = new nu::Window(nu::Window::Options());
+  window->SetContentSize(nu::SizeF(400, 400));
+  scoped_refptr<nu::Table> table = new nu::Table;
+  table->AddColumn("Name");
+  table->AddColumn("Order");
+  table->AddColumn("Value");
+  table->SetModel(CreateColumnarModel(static_cast<uint32_t>(state->range(0))));
+  window->SetContentView(table.get());
+  window->SetVisible(true);
+  while (gtk_events_pending())
+    gtk_main_iteration();
+
+  GtkWidget* tree_view = GTK_WIDGET(g_object_get_data(
+      G_OBJECT(table->GetNative()), "widget"));
+  GtkAdjustment* adjustment =
+      gtk_scrollable_get_vadjustment(GTK_SCROLLABLE(tree_view));
+  cairo_surface_t* surface =
+      cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 400, 400);
+  cairo_t* cr = cairo_create(surface);
+  double value = 0;
+  while (state->KeepRunning()) {
+    value += gtk_adjustment_get_page_size(adjustment);
+    if (value >= gtk_adjustment_get_upper(adjustment))
+      value = 0;
+    gtk_adjustment_set_value(adjustment, value);
+    gtk_widget_draw(tree_view, cr);
+  }
+  cairo_destroy(cr);
+  cairo_surface_destroy(surface);
+  window->Close();
+}
+NU_BENCHMARK(BM_TableScroll)->Arg(1000000);
+#endif
+
+}  // namespace
@@ -4,13 +4,199 @@
 
 #include "nativeui/table_model.h"
 
+#include <algorithm>
+#include <iterator>
 #include <utility>
 
+#include "base/auto_reset.h"
 #include "base/logging.h"
+#include "base/strings/string_util.h"
 #include "nativeui/table.h"
 
 namespace nu {
 
+namespace {
+
+// Changes with more rows are applied by rebuilding the whole index.
+const uint32_t kMaxIncrementalRows = 1000;
+
+// Typed key of a cell used for comparing, the string is borrowed.
+struct CellKey {
+  // The order of kinds is the order of sorting.
+  enum class Kind {
+    Null,
+    Bool,
+    Number,
+    String,
+    Other,
+  };
+
+  Kind kind = Kind::Null;
+  double number = 0;
+  base::StringPiece string;
+};
+
+CellKey ValueToKey(const base::Value& value) {
+  CellKey key;
+  if (value.is_bool()) {
+    key.kind = CellKey::Kind::Bool;
+    key.number = value.GetBool();
+  } else if (value.is_int() || value.is_double()) {
+    key.kind = CellKey::Kind::Number;
+    key.number = value.GetDouble();
+  } else if (value.is_string()) {
+    key.kind = CellKey::Kind::String;
+    key.string = value.GetString();
+  } else if (!value.is_none()) {
+    key.kind = CellKey::Kind::Other;
+  }
+  return key;
+}
+
+CellKey ViewToKey(const TableValueView& view) {
+  CellKey key;
+  switch (view.type) {
+    case TableValueView::Type::Null:
+      break;
+    case TableValueView::Type::Bool:
+      key.kind = CellKey::Kind::Bool;
+      key.number = view.bool_value;
+      break;
+    case TableValueView::Type::Integer:
+      key.kind = CellKey::Kind::Number;
+      key.number = view.int_value;
+      break;
+    case TableValueView::Type::Double:
+      key.kind = CellKey::Kind::Number;
+      key.number = view.double_value;
+      break;
+    case TableValueView::Type::String:
+      key.kind = CellKey::Kind::String;
+      key.string = view.string_value;
+      break;
+    case TableValueView::Type::Value:
+      key = ValueToKey(*view.value);
+      break;
+  }
+  return key;
+}
+
+int CompareKeys(const CellKey& a, const CellKey& b, bool ignore_case = false) {
+  if (a.kind != b.kind)
+    return a.kind < b.kind ? -1 : 1;
+  switch (a.kind) {
+    case CellKey::Kind::Bool:
+    case CellKey::Kind::Number:
+      if (a.number == b.number)
+        return 0;
+      return a.number < b.number ? -1 : 1;
+    case CellKey::Kind::String:
+      return ignore_case ? base::CompareCaseInsensitiveASCII(a.string, b.string)
+                         : a.string.compare(b.string);
+    default:
+      return 0;
+  }
+}
+
+bool ContainsString(base::StringPiece str, base::StringPiece sub,
+                    bool ignore_case) {
+  if (!ignore_case)
+    return str.find(sub) != base::StringPiece::npos;
+  return std::search(str.begin(), str.end(), sub.begin(), sub.end(),
+                     [](char a, char b) {
+                       return base::ToLowerASCII(a) == base::ToLowerASCII(b);
+                     }) != str.end();
+}
+
+// Read a cell as view, the data is copied to |storage| if the model does not
+// support views.
+void ReadCell(const TableModel* model, uint32_t column, uint32_t row,
+              TableValueView* view, base::Value* storage) {
+  if (!model->GetValueView(column, row, view)) {
+    *storage = model->GetValue(column, row);
+    *view = TableValueView(storage);
+  }
+}
+
+// The keys of one column copied from cells, so sorting does not read model.
+class SortColumn {
+ public:
+  SortColumn(const TableModel* model, uint32_t column,
+             const std::vector<uint32_t>& rows) {
+    keys_.reserve(rows.size());
+    // The pool may be reallocated, record the positions and fix up later.
+    std::vector<std::pair<size_t, size_t>> strings;
+    strings.reserve(rows.size());
+    TableValueView view;
+    base::Value storage;
+    for (uint32_t row : rows) {
+      ReadCell(model, column, row, &view, &storage);
+      CellKey key = ViewToKey(view);
+      strings.emplace_back(pool_.size(), key.string.size());
+      pool_.insert(pool_.end(), key.string.begin(), key.string.end());
+      key.string = base::StringPiece();
+      keys_.push_back(key);
+    }
+    for (size_t i = 0; i < keys_.size(); ++i) {
+      if (keys_[i].kind == CellKey::Kind::String) {
+        keys_[i].string = base::StringPiece(pool_.data() + strings[i].first,
+                                            strings[i].second);
+      }
+    }
+  }
+
+  const CellKey& operator[](size_t i) const { return keys_[i]; }
+
+ private:
+  std::vector<CellKey> keys_;
+  std::vector<char> pool_;
+};
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+// TableValueView implementation.
+
+TableValueView::TableValueView() = default;
+
+TableValueView::TableValueView(const base::Value* value)
+    : type(Type::Value), value(value) {}
+
+bool TableValueView::is_bool() const {
+  return type == Type::Bool || (type == Type::Value && value->is_bool());
+}
+
+bool TableValueView::is_string() const {
+  return type == Type::String || (type == Type::Value && value->is_string());
+}
+
+bool TableValueView::GetBool() const {
+  return type == Type::Value ? value->GetBool() : bool_value;
+}
+
+const char* TableValueView::GetCString() const {
+  return type == Type::Value ? value->GetString().c_str()
+                             : string_value.data();
+}
+
+base::Value TableValueView::ToValue() const {
+  switch (type) {
+    case Type::Null:
+      return base::Value();
+    case Type::Bool:
+      return base::Value(bool_value);
+    case Type::Integer:
+      return base::Value(int_value);
+    case Type::Double:
+      return base::Value(double_value);
+    case Type::String:
+      return base::Value(string_value);
+    case Type::Value:
+      return value->Clone();
+  }
+  return base::Value();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // TableModel implementation.
 
@@ -18,19 +204,62 @@ TableModel::TableModel() {}
 
 TableModel::~TableModel() {}
 
+bool TableModel::CanReadAllRows() const {
+  return true;
+}
+
+bool TableModel::GetValueView(uint32_t column, uint32_t row,
+                              TableValueView* view) const {
+  return false;
+}
+
 void TableModel::NotifyRowInsertion(uint32_t row) {
-  for (Table* table : tables_)
-    table->NotifyRowInsertion(row);
+  NotifyRowsInserted(row, 1);
 }
 
 void TableModel::NotifyRowDeletion(uint32_t row) {
-  for (Table* table : tables_)
-    table->NotifyRowDeletion(row);
+  NotifyRowsDeleted(row, 1);
 }
 
 void TableModel::NotifyValueChange(uint32_t column, uint32_t row) {
   for (Table* table : tables_)
     table->NotifyValueChange(column, row);
+  for (SortFilterTableModel* proxy : proxies_)
+    proxy->OnRowsChanged(row, 1);
+}
+
+void TableModel::NotifyRowsInserted(uint32_t start, uint32_t count) {
+  if (count == 0)
+    return;
+  for (Table* table : tables_)
+    table->NotifyRowsInsertion(start, count);
+  for (SortFilterTableModel* proxy : proxies_)
+    proxy->OnRowsInserted(start, count);
+}
+
+void TableModel::NotifyRowsDeleted(uint32_t start, uint32_t count) {
+  if (count == 0)
+    return;
+  for (Table* table : tables_)
+    table->NotifyRowsDeletion(start, count);
+  for (SortFilterTableModel* proxy : proxies_)
+    proxy->OnRowsDeleted(start, count);
+}
+
+void TableModel::NotifyRowsChanged(uint32_t start, uint32_t count) {
+  if (count == 0)
+    return;
+  for (Table* table : tables_)
+    table->NotifyRowsChange(start, count);
+  for (SortFilterTableModel* proxy : proxies_)
+    proxy->OnRowsChanged(start, count);
+}
+
+void TableModel::NotifyReset() {
+  for (Table* table : tables_)
+    table->NotifyReset();
+  for (SortFilterTableModel* proxy : proxies_)
+    proxy->OnReset();
 }
 
 void TableModel::Subscribe(Table* view) {
@@ -41,6 +270,14 @@ void TableModel::Unsubscribe(Table* view) {
   tables_.remove(view);
 }
 
+void TableModel::AddProxy(SortFilterTableModel* proxy) {
+  proxies_.push_back(proxy);
+}
+
+void TableModel::RemoveProxy(SortFilterTableModel* proxy) {
+  proxies_.remove(proxy);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // AbstractTableModel implementation.
 
@@ -104,6 +341,35 @@ void SimpleTableModel::RemoveRowAt(uint32_t row) {
   }
 }
 
+void SimpleTableModel::AddRows(std::vector<Row> rows) {
+  for (const Row& data : rows) {
+    if (data.size() < columns_) {
+      LOG(ERROR) << "AddRows failed because row length is less than column "
+                    "size.";
+      return;
+    }
+  }
+  uint32_t start = static_cast<uint32_t>(rows_.size());
+  rows_.insert(rows_.end(),
+               std::make_move_iterator(rows.begin()),
+               std::make_move_iterator(rows.end()));
+  NotifyRowsInserted(start, static_cast<uint32_t>(rows.size()));
+}
+
+void SimpleTableModel::RemoveRows(uint32_t start, uint32_t count) {
+  if (start > rows_.size() || count > rows_.size() - start) {
+    LOG(ERROR) << "RemoveRows failed because row index is not in model.";
+    return;
+  }
+  rows_.erase(rows_.begin() + start, rows_.begin() + start + count);
+  NotifyRowsDeleted(start, count);
+}
+
+void SimpleTableModel::Clear() {
+  rows_.clear();
+  NotifyReset();
+}
+
 uint32_t SimpleTableModel::GetRowCount() const {
   return static_cast<uint32_t>(rows_.size());
 }
@@ -115,6 +381,15 @@ base::Value SimpleTableModel::GetValue(
   return base::Value();
 }
 
+bool SimpleTableModel::GetValueView(uint32_t column, uint32_t row,
+                                    TableValueView* view) const {
+  if (column < columns_ && row < rows_.size())
+    *view = TableValueView(&rows_[row][column]);
+  else
+    *view = TableValueView();
+  return true;
+}
+
 void SimpleTableModel::SetValue(uint32_t column, uint32_t row,
                                 base::Value value) {
   if (columns_ >= 0 && column < columns_ && row >= 0 && row < rows_.size()) {
@@ -123,4 +398,852 @@ void SimpleTableModel::SetValue(uint32_t column, uint32_t row,
   }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// ColumnarTableModel implementation.
+
+ColumnarTableModel::Column::Column(ColumnType type) : type(type) {}
+
+ColumnarTableModel::Column::Column(Column&&) = default;
+
+ColumnarTableModel::Column::~Column() = default;
+
+ColumnarTableModel::ColumnarTableModel(std::vector<ColumnType> types) {
+  columns_.reserve(types.size());
+  for (ColumnType type : types)
+    columns_.emplace_back(type);
+}
+
+ColumnarTableModel::~ColumnarTableModel() {}
+
+void ColumnarTableModel::Reserve(uint32_t rows) {
+  for (Column& column : columns_) {
+    switch (column.type) {
+      case ColumnType::Bool:
+        column.bools.reserve(rows);
+        break;
+      case ColumnType::Integer:
+        column.integers.reserve(rows);
+        break;
+      case ColumnType::Double:
+        column.doubles.reserve(rows);
+        break;
+      case ColumnType::String:
+        column.strings.reserve(rows);
+        break;
+    }
+  }
+}
+
+void ColumnarTableModel::AddRow(const std::vector<base::Value>& data) {
+  if (data.size() < columns_.size()) {
+    LOG(ERROR) << "AddRow failed because row length is less than column size.";
+    return;
+  }
+  for (size_t i = 0; i < columns_.size(); ++i)
+    AppendValue(&columns_[i], data[i]);
+  NotifyRowInsertion(rows_++);
+}
+
+void ColumnarTableModel::RemoveRowAt(uint32_t row) {
+  RemoveRows(row, 1);
+}
+
+void ColumnarTableModel::AddRows(
+    const std::vector<std::vector<base::Value>>& rows) {
+  for (const std::vector<base::Value>& data : rows) {
+    if (data.size() < columns_.size()) {
+      LOG(ERROR) << "AddRows failed because row length is less than column "
+                    "size.";
+      return;
+    }
+  }
+  Reserve(rows_ + static_cast<uint32_t>(rows.size()));
+  for (const std::vector<base::Value>& data : rows) {
+    for (size_t i = 0; i < columns_.size(); ++i)
+      AppendValue(&columns_[i], data[i]);
+  }
+  uint32_t start = rows_;
+  rows_ += static_cast<uint32_t>(rows.size());
+  NotifyRowsInserted(start, static_cast<uint32_t>(rows.size()));
+}
+
+void ColumnarTableModel::RemoveRows(uint32_t start, uint32_t count) {
+  if (start > rows_ || count > rows_ - start) {
+    LOG(ERROR) << "RemoveRows failed because row index is not in model.";
+    return;
+  }
+  uint32_t end = start + count;
+  for (Column& column : columns_) {
+    switch (column.type) {
+      case ColumnType::Bool:
+        column.bools.erase(column.bools.begin() + start,
+                           column.bools.begin() + end);
+        break;
+      case ColumnType::Integer:
+        column.integers.erase(column.integers.begin() + start,
+                              column.integers.begin() + end);
+        break;
+      case ColumnType::Double:
+        column.doubles.erase(column.doubles.begin() + start,
+                             column.doubles.begin() + end);
+        break;
+      case ColumnType::String:
+        for (uint32_t i = start; i < end; ++i)
+          column.garbage += column.strings[i].size + 1;
+        column.strings.erase(column.strings.begin() + start,
+                             column.strings.begin() + end);
+        CompactPool(&column);
+        break;
+    }
+  }
+  rows_ -= count;
+  NotifyRowsDeleted(start, count);
+}
+
+void ColumnarTableModel::Clear() {
+  for (Column& column : columns_) {
+    column.bools.clear();
+    column.integers.clear();
+    column.doubles.clear();
+    column.strings.clear();
+    column.pool.clear();
+    column.garbage = 0;
+  }
+  rows_ = 0;
+  NotifyReset();
+}
+
+bool ColumnarTableModel::GetBool(uint32_t column, uint32_t row) const {
+  if (!IsValidCell(column, row, ColumnType::Bool))
+    return false;
+  return columns_[column].bools[row];
+}
+
+int ColumnarTableModel::GetInteger(uint32_t column, uint32_t row) const {
+  if (!IsValidCell(column, row, ColumnType::Integer))
+    return 0;
+  return columns_[column].integers[row];
+}
+
+double ColumnarTableModel::GetDouble(uint32_t column, uint32_t row) const {
+  if (!IsValidCell(column, row, ColumnType::Double))
+    return 0;
+  return columns_[column].doubles[row];
+}
+
+base::StringPiece ColumnarTableModel::GetString(uint32_t column,
+                                                uint32_t row) const {
+  if (!IsValidCell(column, row, ColumnType::String))
+    return base::StringPiece();
+  const Column& c = columns_[column];
+  StringRef ref = c.strings[row];
+  return base::StringPiece(&c.pool[ref.offset], ref.size);
+}
+
+void ColumnarTableModel::SetBool(uint32_t column, uint32_t row, bool value) {
+  if (!IsValidCell(column, row, ColumnType::Bool))
+    return;
+  columns_[column].bools[row] = value;
+  NotifyValueChange(column, row);
+}
+
+void ColumnarTableModel::SetInteger(uint32_t column, uint32_t row, int value) {
+  if (!IsValidCell(column, row, ColumnType::Integer))
+    return;
+  columns_[column].integers[row] = value;
+  NotifyValueChange(column, row);
+}
+
+void ColumnarTableModel::SetDouble(uint32_t column, uint32_t row,
+                                   double value) {
+  if (!IsValidCell(column, row, ColumnType::Double))
+    return;
+  columns_[column].doubles[row] = value;
+  NotifyValueChange(column, row);
+}
+
+void ColumnarTableModel::SetString(uint32_t column, uint32_t row,
+                                   base::StringPiece value) {
+  if (!IsValidCell(column, row, ColumnType::String))
+    return;
+  Column* c = &columns_[column];
+  c->garbage += c->strings[row].size + 1;
+  c->strings[row] = AddToPool(c, value);
+  CompactPool(c);
+  NotifyValueChange(column, row);
+}
+
+uint32_t ColumnarTableModel::GetColumnCount() const {
+  return static_cast<uint32_t>(columns_.size());
+}
+
+ColumnarTableModel::ColumnType ColumnarTableModel::GetColumnType(
+    uint32_t column) const {
+  DCHECK_LT(column, columns_.size());
+  return columns_[column].type;
+}
+
+uint32_t ColumnarTableModel::GetRowCount() const {
+  return rows_;
+}
+
+base::Value ColumnarTableModel::GetValue(uint32_t column, uint32_t row) const {
+  TableValueView view;
+  if (!GetValueView(column, row, &view))
+    return base::Value();
+  return view.ToValue();
+}
+
+bool ColumnarTableModel::GetValueView(uint32_t column, uint32_t row,
+                                      TableValueView* view) const {
+  if (column >= columns_.size() || row >= rows_) {
+    *view = TableValueView();
+    return true;
+  }
+  const Column& c = columns_[column];
+  switch (c.type) {
+    case ColumnType::Bool:
+      view->type = TableValueView::Type::Bool;
+      view->bool_value = c.bools[row];
+      break;
+    case ColumnType::Integer:
+      view->type = TableValueView::Type::Integer;
+      view->int_value = c.integers[row];
+      break;
+    case ColumnType::Double:
+      view->type = TableValueView::Type::Double;
+      view->double_value = c.doubles[row];
+      break;
+    case ColumnType::String:
+      view->type = TableValueView::Type::String;
+      view->string_value = GetString(column, row);
+      break;
+  }
+  return true;
+}
+
+void ColumnarTableModel::SetValue(uint32_t column, uint32_t row,
+                                  base::Value value) {
+  if (column >= columns_.size() || row >= rows_)
+    return;
+  switch (columns_[column].type) {
+    case ColumnType::Bool:
+      if (value.is_bool())
+        SetBool(column, row, value.GetBool());
+      break;
+    case ColumnType::Integer:
+      if (value.is_int())
+        SetInteger(column, row, value.GetInt());
+      break;
+    case ColumnType::Double:
+      if (value.is_int() || value.is_double())
+        SetDouble(column, row, value.GetDouble());
+      break;
+    case ColumnType::String:
+      if (value.is_string())
+        SetString(column, row, value.GetString());
+      break;
+  }
+}
+
+bool ColumnarTableModel::IsValidCell(uint32_t column, uint32_t row,
+                                     ColumnType type) const {
+  return column < columns_.size() && row < rows_ &&
+         columns_[column].type == type;
+}
+
+void ColumnarTableModel::AppendValue(Column* column, const base::Value& value) {
+  switch (column->type) {
+    case ColumnType::Bool:
+      column->bools.push_back(value.is_bool() && value.GetBool());
+      break;
+    case ColumnType::Integer:
+      column->integers.push_back(value.is_int() ? value.GetInt() : 0);
+      break;
+    case ColumnType::Double:
+      column->doubles.push_back(value.is_int() || value.is_double() ?
+                                value.GetDouble() : 0);
+      break;
+    case ColumnType::String:
+      column->strings.push_back(AddToPool(
+          column,
+          value.is_string() ? base::StringPiece(value.GetString())
+                            : base::StringPiece()));
+      break;
+  }
+}
+
+ColumnarTableModel::StringRef ColumnarTableModel::AddToPool(
+    Column* column, base::StringPiece str) {
+  StringRef ref;
+  ref.offset = static_cast<uint32_t>(column->pool.size());
+  ref.size = static_cast<uint32_t>(str.size());
+  column->pool.insert(column->pool.end(), str.begin(), str.end());
+  column->pool.push_back('\0');
+  return ref;
+}
+
+void ColumnarTableModel::CompactPool(Column* column) {
+  // Only compact when more than half of the pool is garbage.
+  if (column->garbage * 2 < column->pool.size())
+    return;
+  std::vector<char> pool;
+  pool.reserve(column->pool.size() - column->garbage);
+  for (StringRef& ref : column->strings) {
+    uint32_t offset = static_cast<uint32_t>(pool.size());
+    pool.insert(pool.end(),
+                column->pool.begin() + ref.offset,
+                column->pool.begin() + ref.offset + ref.size + 1);
+    ref.offset = offset;
+  }
+  column->pool = std::move(pool);
+  column->garbage = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// PagedTableModel implementation.
+
+PagedTableModel::Block::Block(uint32_t index) : index(index) {}
+
+PagedTableModel::Block::Block(Block&&) = default;
+
+PagedTableModel::Block::~Block() = default;
+
+PagedTableModel::PagedTableModel(uint32_t block_size,
+                                 uint32_t max_cached_blocks,
+                                 bool index_starts_from_0)
+    : block_size_(std::max(block_size, 1u)),
+      max_cached_blocks_(std::max(max_cached_blocks, 1u)),
+      index_starts_from_0_(index_starts_from_0) {
+  SetPrefetchBlocks(prefetch_blocks_);
+}
+
+PagedTableModel::~PagedTableModel() {}
+
+void PagedTableModel::SetRowCount(uint32_t count) {
+  if (count == rows_)
+    return;
+  uint32_t old_count = rows_;
+  rows_ = count;
+  last_block_ = static_cast<uint32_t>(-1);
+  if (count > old_count) {
+    // The last block was requested with fewer rows, request it again.
+    if (old_count % block_size_ != 0)
+      RemoveBlock(old_count / block_size_);
+    NotifyRowsInserted(old_count, count - old_count);
+  } else {
+    for (auto it = blocks_.begin(); it != blocks_.end();) {
+      uint32_t start = it->index * block_size_;
+      if (start >= count) {
+        blocks_map_.erase(it->index);
+        it = blocks_.erase(it);
+      } else {
+        if (it->rows.size() > count - start)
+          it->rows.resize(count - start);
+        ++it;
+      }
+    }
+    NotifyRowsDeleted(count, old_count - count);
+  }
+}
+
+void PagedTableModel::SetRows(uint32_t start, std::vector<Row> rows) {
+  if (start >= rows_) {
+    LOG(ERROR) << "SetRows failed because row index is not in model.";
+    return;
+  }
+  uint32_t count = static_cast<uint32_t>(
+      std::min<size_t>(rows.size(), rows_ - start));
+  Block* block = nullptr;
+  for (uint32_t i = 0; i < count; ++i) {
+    uint32_t row = start + i;
+    uint32_t index = row / block_size_;
+    if (!block || block->index != index) {
+      block = FindBlock(index);
+      if (!block)
+        block = AddBlock(index);
+    }
+    block->rows[row - index * block_size_] = std::move(rows[i]);
+  }
+  // Rows requested in get_rows are being read by the table, only notify the
+  // rows outside them.
+  uint32_t end = start + count;
+  uint32_t requesting_end = requesting_start_ + requesting_count_;
+  if (requesting_count_ == 0 ||
+      end <= requesting_start_ || start >= requesting_end) {
+    NotifyRowsChanged(start, count);
+    return;
+  }
+  if (start < requesting_start_)
+    NotifyRowsChanged(start, requesting_start_ - start);
+  if (end > requesting_end)
+    NotifyRowsChanged(requesting_end, end - requesting_end);
+}
+
+bool PagedTableModel::IsRowLoaded(uint32_t row) const {
+  if (row >= rows_)
+    return false;
+  uint32_t index = row / block_size_;
+  auto it = blocks_map_.find(index);
+  if (it == blocks_map_.end())
+    return false;
+  return !it->second->rows[row - index * block_size_].empty();
+}
+
+void PagedTableModel::Prefetch(uint32_t start, uint32_t count) {
+  if (start >= rows_ || count == 0)
+    return;
+  uint32_t end = start + std::min(count, rows_ - start) - 1;
+  for (uint32_t i = start / block_size_; i <= end / block_size_; ++i)
+    RequestBlock(i);
+}
+
+void PagedTableModel::InvalidateRows(uint32_t start, uint32_t count) {
+  if (start >= rows_ || count == 0)
+    return;
+  count = std::min(count, rows_ - start);
+  uint32_t end = start + count - 1;
+  for (uint32_t i = start / block_size_; i <= end / block_size_; ++i)
+    RemoveBlock(i);
+  last_block_ = static_cast<uint32_t>(-1);
+  NotifyRowsChanged(start, count);
+}
+
+void PagedTableModel::InvalidateAll() {
+  blocks_.clear();
+  blocks_map_.clear();
+  last_block_ = static_cast<uint32_t>(-1);
+  NotifyReset();
+}
+
+void PagedTableModel::SetPlaceholder(base::Value value) {
+  placeholder_ = std::move(value);
+}
+
+void PagedTableModel::SetPrefetchBlocks(uint32_t blocks) {
+  // Make sure the read block is not evicted by its neighbors.
+  prefetch_blocks_ = std::min(blocks, (max_cached_blocks_ - 1) / 2);
+}
+
+uint32_t PagedTableModel::GetRowCount() const {
+  return rows_;
+}
+
+base::Value PagedTableModel::GetValue(uint32_t column, uint32_t row) const {
+  if (row >= rows_)
+    return base::Value();
+  const Row* data = ReadRow(row);
+  if (!data)
+    return placeholder_.Clone();
+  if (column < data->size())
+    return (*data)[column].Clone();
+  return base::Value();
+}
+
+bool PagedTableModel::GetValueView(uint32_t column, uint32_t row,
+                                   TableValueView* view) const {
+  const Row* data = nullptr;
+  if (row < rows_)
+    data = ReadRow(row);
+  if (row >= rows_)
+    *view = TableValueView();
+  else if (!data)
+    *view = TableValueView(&placeholder_);
+  else if (column < data->size())
+    *view = TableValueView(&(*data)[column]);
+  else
+    *view = TableValueView();
+  return true;
+}
+
+bool PagedTableModel::CanReadAllRows() const {
+  return false;
+}
+
+void PagedTableModel::SetValue(uint32_t column, uint32_t row,
+                               base::Value value) {
+  if (row >= rows_)
+    return;
+  uint32_t index = row / block_size_;
+  auto it = blocks_map_.find(index);
+  if (it != blocks_map_.end()) {
+    Row& data = it->second->rows[row - index * block_size_];
+    if (column < data.size())
+      data[column] = value.Clone();
+  }
+  if (set_value) {
+    uint32_t offset = index_starts_from_0_ ? 0 : 1;
+    set_value(this, column + offset, row + offset, std::move(value));
+  }
+  NotifyValueChange(column, row);
+}
+
+const PagedTableModel::Row* PagedTableModel::ReadRow(uint32_t row) const {
+  uint32_t index = row / block_size_;
+  if (index != last_block_) {
+    last_block_ = index;
+    RequestBlock(index);
+    uint32_t blocks = GetBlockCount();
+    for (uint32_t i = 1; i <= prefetch_blocks_; ++i) {
+      if (index + i < blocks)
+        RequestBlock(index + i);
+      if (index >= i)
+        RequestBlock(index - i);
+    }
+  }
+  Block* block = FindBlock(index);
+  if (!block) {
+    // The block might have been evicted by rows provided for other blocks.
+    RequestBlock(index);
+    block = FindBlock(index);
+    if (!block)
+      return nullptr;
+  }
+  const Row& data = block->rows[row - index * block_size_];
+  return data.empty() ? nullptr : &data;
+}
+
+PagedTableModel::Block* PagedTableModel::FindBlock(uint32_t index) const {
+  auto it = blocks_map_.find(index);
+  if (it == blocks_map_.end())
+    return nullptr;
+  if (it->second != blocks_.begin())
+    blocks_.splice(blocks_.begin(), blocks_, it->second);
+  return &blocks_.front();
+}
+
+PagedTableModel::Block* PagedTableModel::AddBlock(uint32_t index) const {
+  DCHECK_EQ(blocks_map_.count(index), 0u);
+  uint32_t start = index * block_size_;
+  blocks_.emplace_front(index);
+  blocks_.front().rows.resize(std::min(block_size_, rows_ - start));
+  blocks_map_[index] = blocks_.begin();
+  EvictBlocks();
+  return &blocks_.front();
+}
+
+void PagedTableModel::RequestBlock(uint32_t index) const {
+  if (blocks_map_.find(index) != blocks_map_.end())
+    return;
+  // Add the block before requesting, so it is only requested once.
+  Block* block = AddBlock(index);
+  if (!get_rows)
+    return;
+  uint32_t start = index * block_size_;
+  uint32_t count = static_cast<uint32_t>(block->rows.size());
+  base::AutoReset<uint32_t> auto_reset_start(&requesting_start_, start);
+  base::AutoReset<uint32_t> auto_reset_count(&requesting_count_, count);
+  // The delegate provides rows through the non-const SetRows.
+  get_rows(const_cast<PagedTableModel*>(this),
+           index_starts_from_0_ ? start : start + 1, count);
+}
+
+void PagedTableModel::RemoveBlock(uint32_t index) {
+  auto it = blocks_map_.find(index);
+  if (it == blocks_map_.end())
+    return;
+  blocks_.erase(it->second);
+  blocks_map_.erase(it);
+}
+
+void PagedTableModel::EvictBlocks() const {
+  while (blocks_.size() > max_cached_blocks_) {
+    blocks_map_.erase(blocks_.back().index);
+    blocks_.pop_back();
+  }
+}
+
+uint32_t PagedTableModel::GetBlockCount() const {
+  return (rows_ + block_size_ - 1) / block_size_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// SortFilterTableModel implementation.
+
+SortFilterTableModel::Filter::Filter() = default;
+
+SortFilterTableModel::Filter::Filter(Filter&&) = default;
+
+SortFilterTableModel::Filter::Filter(const Filter& other)
+    : type(other.type),
+      column(other.column),
+      value(other.value.Clone()),
+      min(other.min.Clone()),
+      max(other.max.Clone()),
+      ignore_case(other.ignore_case) {}
+
+SortFilterTableModel::Filter::~Filter() = default;
+
+SortFilterTableModel::Filter& SortFilterTableModel::Filter::operator=(
+    Filter&&) = default;
+
+SortFilterTableModel::SortFilterTableModel(scoped_refptr<TableModel> source)
+    : source_(std::move(source)) {
+  source_->AddProxy(this);
+  Rebuild();
+}
+
+SortFilterTableModel::~SortFilterTableModel() {
+  source_->RemoveProxy(this);
+}
+
+void SortFilterTableModel::SetSortKeys(std::vector<SortKey> keys) {
+  if (!keys.empty() && !source_->CanReadAllRows()) {
+    LOG(ERROR) << "Can not sort a model whose rows are loaded lazily.";
+    return;
+  }
+  sort_keys_ = std::move(keys);
+  Rebuild();
+}
+
+void SortFilterTableModel::SetFilters(std::vector<Filter> filters) {
+  if (!filters.empty() && !source_->CanReadAllRows()) {
+    LOG(ERROR) << "Can not filter a model whose rows are loaded lazily.";
+    return;
+  }
+  filters_ = std::move(filters);
+  Rebuild();
+}
+
+void SortFilterTableModel::AddFilter(Filter filter) {
+  if (!source_->CanReadAllRows()) {
+    LOG(ERROR) << "Can not filter a model whose rows are loaded lazily.";
+    return;
+  }
+  filters_.push_back(std::move(filter));
+  Rebuild();
+}
+
+void SortFilterTableModel::ClearFilters() {
+  filters_.clear();
+  Rebuild();
+}
+
+int SortFilterTableModel::MapToSource(uint32_t row) const {
+  if (row >= index_.size())
+    return -1;
+  return index_[row];
+}
+
+int SortFilterTableModel::MapFromSource(uint32_t source_row) const {
+  if (reverse_index_dirty_) {
+    reverse_index_.assign(source_->GetRowCount(), -1);
+    for (size_t i = 0; i < index_.size(); ++i) {
+      if (index_[i] < reverse_index_.size())
+        reverse_index_[index_[i]] = static_cast<int>(i);
+    }
+    reverse_index_dirty_ = false;
+  }
+  if (source_row >= reverse_index_.size())
+    return -1;
+  return reverse_index_[source_row];
+}
+
+uint32_t SortFilterTableModel::GetRowCount() const {
+  return static_cast<uint32_t>(index_.size());
+}
+
+base::Value SortFilterTableModel::GetValue(uint32_t column,
+                                           uint32_t row) const {
+  if (row >= index_.size())
+    return base::Value();
+  return source_->GetValue(column, index_[row]);
+}
+
+bool SortFilterTableModel::GetValueView(uint32_t column, uint32_t row,
+                                        TableValueView* view) const {
+  if (row >= index_.size()) {
+    *view = TableValueView();
+    return true;
+  }
+  return source_->GetValueView(column, index_[row], view);
+}
+
+void SortFilterTableModel::SetValue(uint32_t column, uint32_t row,
+                                    base::Value value) {
+  // The source model notifies us and the row is moved if needed.
+  if (row < index_.size())
+    source_->SetValue(column, index_[row], std::move(value));
+}
+
+void SortFilterTableModel::OnRowsInserted(uint32_t start, uint32_t count) {
+  if (count > kMaxIncrementalRows) {
+    Rebuild();
+    return;
+  }
+  for (uint32_t& source_row : index_) {
+    if (source_row >= start)
+      source_row += count;
+  }
+  reverse_index_dirty_ = true;
+  for (uint32_t i = start; i < start + count; ++i)
+    InsertRow(i);
+}
+
+void SortFilterTableModel::OnRowsDeleted(uint32_t start, uint32_t count) {
+  if (count > kMaxIncrementalRows) {
+    Rebuild();
+    return;
+  }
+  // Remove the rows in one pass, and then notify from the last row so the
+  // indexes are still valid for tables.
+  std::vector<uint32_t> removed;
+  size_t j = 0;
+  for (size_t i = 0; i < index_.size(); ++i) {
+    uint32_t source_row = index_[i];
+    if (source_row >= start && source_row < start + count) {
+      removed.push_back(static_cast<uint32_t>(i));
+      continue;
+    }
+    index_[j++] = source_row >= start + count ? source_row - count
+                                              : source_row;
+  }
+  index_.resize(j);
+  reverse_index_dirty_ = true;
+  for (auto it = removed.rbegin(); it != removed.rend(); ++it)
+    NotifyRowDeletion(*it);
+}
+
+void SortFilterTableModel::OnRowsChanged(uint32_t start, uint32_t count) {
+  if (count > kMaxIncrementalRows) {
+    Rebuild();
+    return;
+  }
+  std::vector<uint32_t> changed;
+  std::vector<bool> shown(count, false);
+  for (size_t i = 0; i < index_.size(); ++i) {
+    if (index_[i] >= start && index_[i] < start + count) {
+      changed.push_back(static_cast<uint32_t>(i));
+      shown[index_[i] - start] = true;
+    }
+  }
+  // Rows still in order with unchanged neighbors are updated in place, others
+  // are removed and then inserted again. Neighbors that also changed may be
+  // moved, so they can not be used to check the order.
+  std::vector<uint32_t> moved;
+  for (size_t k = changed.size(); k-- > 0;) {
+    uint32_t row = changed[k];
+    uint32_t source_row = index_[row];
+    bool prev_changed = k > 0 && changed[k - 1] == row - 1;
+    bool next_changed = k + 1 < changed.size() && changed[k + 1] == row + 1;
+    if (!prev_changed && !next_changed && Accepts(source_row) &&
+        (row == 0 || Less(index_[row - 1], source_row)) &&
+        (row + 1 == index_.size() || Less(source_row, index_[row + 1]))) {
+      NotifyRowsChanged(row, 1);
+    } else {
+      RemoveRowAt(row);
+      moved.push_back(source_row);
+    }
+  }
+  // All moved rows are out, the index is sorted again.
+  for (uint32_t source_row : moved)
+    InsertRow(source_row);
+  // Rows that were filtered out may pass filters now.
+  for (uint32_t i = 0; i < count; ++i) {
+    if (!shown[i])
+      InsertRow(start + i);
+  }
+}
+
+void SortFilterTableModel::OnReset() {
+  Rebuild();
+}
+
+void SortFilterTableModel::Rebuild() {
+  uint32_t rows = source_->GetRowCount();
+  index_.clear();
+  index_.reserve(rows);
+  for (uint32_t i = 0; i < rows; ++i) {
+    if (Accepts(i))
+      index_.push_back(i);
+  }
+  if (!sort_keys_.empty()) {
+    // Read the cells once instead of reading them in every comparison.
+    std::vector<SortColumn> columns;
+    columns.reserve(sort_keys_.size());
+    for (const SortKey& key : sort_keys_)
+      columns.emplace_back(source_.get(), key.column, index_);
+    std::vector<uint32_t> order(index_.size());
+    for (uint32_t i = 0; i < order.size(); ++i)
+      order[i] = i;
+    std::stable_sort(order.begin(), order.end(),
+                     [this, &columns](uint32_t a, uint32_t b) {
+      for (size_t i = 0; i < sort_keys_.size(); ++i) {
+        int result = CompareKeys(columns[i][a], columns[i][b]);
+        if (result != 0)
+          return sort_keys_[i].ascending ? result < 0 : result > 0;
+      }
+      return false;
+    });
+    std::vector<uint32_t> index(order.size());
+    for (size_t i = 0; i < order.size(); ++i)
+      index[i] = index_[order[i]];
+    index_ = std::move(index);
+  }
+  reverse_index_dirty_ = true;
+  NotifyReset();
+}
+
+void SortFilterTableModel::InsertRow(uint32_t source_row) {
+  if (!Accepts(source_row))
+    return;
+  auto it = std::lower_bound(index_.begin(), index_.end(), source_row,
+                             [this](uint32_t a, uint32_t b) {
+                               return Less(a, b);
+                             });
+  uint32_t row = static_cast<uint32_t>(it - index_.begin());
+  index_.insert(it, source_row);
+  reverse_index_dirty_ = true;
+  NotifyRowInsertion(row);
+}
+
+void SortFilterTableModel::RemoveRowAt(uint32_t row) {
+  index_.erase(index_.begin() + row);
+  reverse_index_dirty_ = true;
+  NotifyRowDeletion(row);
+}
+
+bool SortFilterTableModel::Accepts(uint32_t source_row) const {
+  TableValueView view;
+  base::Value storage;
+  for (const Filter& filter : filters_) {
+    ReadCell(source_.get(), filter.column, source_row, &view, &storage);
+    CellKey key = ViewToKey(view);
+    switch (filter.type) {
+      case Filter::Type::Equals:
+        if (CompareKeys(key, ValueToKey(filter.value), filter.ignore_case))
+          return false;
+        break;
+      case Filter::Type::Contains:
+        if (key.kind != CellKey::Kind::String || !filter.value.is_string() ||
+            !ContainsString(key.string, filter.value.GetString(),
+                            filter.ignore_case))
+          return false;
+        break;
+      case Filter::Type::Range:
+        if (!filter.min.is_none() &&
+            CompareKeys(key, ValueToKey(filter.min), filter.ignore_case) < 0)
+          return false;
+        if (!filter.max.is_none() &&
+            CompareKeys(key, ValueToKey(filter.max), filter.ignore_case) > 0)
+          return false;
+        break;
+    }
+  }
+  return true;
+}
+
+bool SortFilterTableModel::Less(uint32_t a, uint32_t b) const {
+  TableValueView view_a, view_b;
+  base::Value storage_a, storage_b;
+  for (const SortKey& key : sort_keys_) {
+    ReadCell(source_.get(), key.column, a, &view_a, &storage_a);
+    ReadCell(source_.get(), key.column, b, &view_b, &storage_b);
+    int result = CompareKeys(ViewToKey(view_a), ViewToKey(view_b));
+    if (result != 0)
+      return key.ascending ? result < 0 : result > 0;
+  }
+  return a < b;
+}
+
 }  // namespace nu
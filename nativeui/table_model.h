@@ -7,16 +7,57 @@
 
 #include <functional>
 #include <list>
+#include <unordered_map>
 #include <vector>
 
 #include "base/memory/ref_counted.h"
+#include "base/strings/string_piece.h"
 #include "base/values.h"
 #include "nativeui/nativeui_export.h"
 
 namespace nu {
 
+class SortFilterTableModel;
 class Table;
 
+// A borrowed view of a cell in TableModel, which is used by tables to read
+// data without copying it.
+//
+// The view does not own any data, and it is only valid until the model is
+// changed.
+struct NATIVEUI_EXPORT TableValueView {
+  enum class Type {
+    Null,
+    Bool,
+    Integer,
+    Double,
+    String,
+    Value,
+  };
+
+  TableValueView();
+  explicit TableValueView(const base::Value* value);
+
+  bool is_bool() const;
+  bool is_string() const;
+
+  // Only valid when is_bool() returns true.
+  bool GetBool() const;
+  // Only valid when is_string() returns true, the result is NUL-terminated.
+  const char* GetCString() const;
+
+  // Copy the data into a new Value.
+  base::Value ToValue() const;
+
+  Type type = Type::Null;
+  bool bool_value = false;
+  int int_value = 0;
+  double double_value = 0;
+  // The string data is guaranteed to be NUL-terminated.
+  base::StringPiece string_value;
+  const base::Value* value = nullptr;
+};
+
 // Users should sublcass TableModel to provide their own implementation.
 class NATIVEUI_EXPORT TableModel : public base::RefCounted<TableModel> {
  public:
@@ -26,6 +67,12 @@ class NATIVEUI_EXPORT TableModel : public base::RefCounted<TableModel> {
   // Return the reference to the data in the model.
   virtual base::Value GetValue(uint32_t column, uint32_t row) const = 0;
 
+  // Read the data without copying, return false if the model does not support
+  // it, and the caller should fallback to GetValue. Models supporting it
+  // return true with a Null view for out of range cells.
+  virtual bool GetValueView(uint32_t column, uint32_t row,
+                            TableValueView* view) const;
+
   // Change the value.
   virtual void SetValue(uint32_t column, uint32_t row, base::Value value) = 0;
 
@@ -34,19 +81,37 @@ class NATIVEUI_EXPORT TableModel : public base::RefCounted<TableModel> {
   void NotifyRowDeletion(uint32_t row);
   void NotifyValueChange(uint32_t column, uint32_t row);
 
+  // Batched versions of notifications, tables may choose to reload all data
+  // when the range is large, which is much faster than updating row by row.
+  void NotifyRowsInserted(uint32_t start, uint32_t count);
+  void NotifyRowsDeleted(uint32_t start, uint32_t count);
+  void NotifyRowsChanged(uint32_t start, uint32_t count);
+  // Called when all data of model has been changed.
+  void NotifyReset();
+
  protected:
   TableModel();
   virtual ~TableModel();
 
+  // Whether reading every row is cheap, models loading rows lazily return
+  // false so they are not sorted or filtered by proxies.
+  virtual bool CanReadAllRows() const;
+
  private:
   friend class base::RefCounted<TableModel>;
+  friend class SortFilterTableModel;
   friend class Table;
 
   // Called by table.
   void Subscribe(Table* view);
   void Unsubscribe(Table* view);
 
+  // Called by proxy models that wrap this model.
+  void AddProxy(SortFilterTableModel* proxy);
+  void RemoveProxy(SortFilterTableModel* proxy);
+
   std::list<Table*> tables_;
+  std::list<SortFilterTableModel*> proxies_;
 };
 
 // Used by language bindings.
@@ -84,9 +149,16 @@ class NATIVEUI_EXPORT SimpleTableModel : public TableModel {
   void AddRow(Row data);
   void RemoveRowAt(uint32_t row);
 
+  // Batched operations that only send one notification.
+  void AddRows(std::vector<Row> rows);
+  void RemoveRows(uint32_t start, uint32_t count);
+  void Clear();
+
   // TableModel:
   uint32_t GetRowCount() const override;
   base::Value GetValue(uint32_t column, uint32_t row) const override;
+  bool GetValueView(uint32_t column, uint32_t row,
+                    TableValueView* view) const override;
   void SetValue(uint32_t column, uint32_t row, base::Value value) override;
 
  protected:
@@ -97,6 +169,292 @@ class NATIVEUI_EXPORT SimpleTableModel : public TableModel {
   std::vector<Row> rows_;
 };
 
+// A TableModel that stores data in typed columns, which is designed for large
+// datasets.
+//
+// Each column stores its data in one contiguous array, and strings are stored
+// in a per-column pool, so reading a cell never allocates.
+class NATIVEUI_EXPORT ColumnarTableModel : public TableModel {
+ public:
+  enum class ColumnType {
+    Bool,
+    Integer,
+    Double,
+    String,
+  };
+
+  explicit ColumnarTableModel(std::vector<ColumnType> types);
+
+  // Reserve memory for |rows| rows.
+  void Reserve(uint32_t rows);
+
+  // Add a row, values of mismatched types are stored as default values.
+  void AddRow(const std::vector<base::Value>& data);
+  void RemoveRowAt(uint32_t row);
+
+  // Batched operations that only send one notification.
+  void AddRows(const std::vector<std::vector<base::Value>>& rows);
+  void RemoveRows(uint32_t start, uint32_t count);
+  void Clear();
+
+  // Typed accessors, the |column| must have the matching type.
+  bool GetBool(uint32_t column, uint32_t row) const;
+  int GetInteger(uint32_t column, uint32_t row) const;
+  double GetDouble(uint32_t column, uint32_t row) const;
+  base::StringPiece GetString(uint32_t column, uint32_t row) const;
+  void SetBool(uint32_t column, uint32_t row, bool value);
+  void SetInteger(uint32_t column, uint32_t row, int value);
+  void SetDouble(uint32_t column, uint32_t row, double value);
+  void SetString(uint32_t column, uint32_t row, base::StringPiece value);
+
+  uint32_t GetColumnCount() const;
+  ColumnType GetColumnType(uint32_t column) const;
+
+  // TableModel:
+  uint32_t GetRowCount() const override;
+  base::Value GetValue(uint32_t column, uint32_t row) const override;
+  bool GetValueView(uint32_t column, uint32_t row,
+                    TableValueView* view) const override;
+  void SetValue(uint32_t column, uint32_t row, base::Value value) override;
+
+ protected:
+  ~ColumnarTableModel() override;
+
+ private:
+  // Position of a string in the pool.
+  struct StringRef {
+    uint32_t offset = 0;
+    uint32_t size = 0;
+  };
+
+  struct Column {
+    explicit Column(ColumnType type);
+    Column(Column&&);
+    ~Column();
+
+    ColumnType type;
+    // Only the array matching |type| is used.
+    std::vector<uint8_t> bools;
+    std::vector<int> integers;
+    std::vector<double> doubles;
+    std::vector<StringRef> strings;
+    // Strings are appended to the pool with a NUL terminator, replaced strings
+    // are left as garbage until the pool is compacted.
+    std::vector<char> pool;
+    size_t garbage = 0;
+  };
+
+  bool IsValidCell(uint32_t column, uint32_t row, ColumnType type) const;
+  void AppendValue(Column* column, const base::Value& value);
+  StringRef AddToPool(Column* column, base::StringPiece str);
+  void CompactPool(Column* column);
+
+  std::vector<Column> columns_;
+  uint32_t rows_ = 0;
+};
+
+// A TableModel that loads rows from the delegate in blocks, which is designed
+// for script-backed tables with lots of rows.
+//
+// Rows are requested from the |get_rows| delegate one block at a time, and the
+// delegate can provide them either immediately or later by calling SetRows.
+// Loaded blocks are kept in a LRU cache, and rows that are still loading are
+// shown with the placeholder value.
+class NATIVEUI_EXPORT PagedTableModel : public TableModel {
+ public:
+  using Row = std::vector<base::Value>;
+
+  // The |index_starts_from_0| only affects the indexes passed to delegates.
+  explicit PagedTableModel(uint32_t block_size = 256,
+                           uint32_t max_cached_blocks = 64,
+                           bool index_starts_from_0 = true);
+
+  // Change the number of rows, rows beyond the new count are dropped.
+  void SetRowCount(uint32_t count);
+
+  // Provide the data of rows starting from |start|, usually called in or after
+  // the |get_rows| delegate.
+  void SetRows(uint32_t start, std::vector<Row> rows);
+
+  // Return whether the data of |row| has been provided.
+  bool IsRowLoaded(uint32_t row) const;
+
+  // Request the blocks covering the rows if they are not cached.
+  void Prefetch(uint32_t start, uint32_t count);
+
+  // Drop cached data, the rows are requested again when they are read.
+  void InvalidateRows(uint32_t start, uint32_t count);
+  void InvalidateAll();
+
+  // The value shown for rows that are still loading.
+  void SetPlaceholder(base::Value value);
+  const base::Value& GetPlaceholder() const { return placeholder_; }
+
+  // How many blocks before and after the read block are requested together.
+  void SetPrefetchBlocks(uint32_t blocks);
+  uint32_t GetPrefetchBlocks() const { return prefetch_blocks_; }
+
+  uint32_t GetBlockSize() const { return block_size_; }
+
+  // TableModel:
+  uint32_t GetRowCount() const override;
+  base::Value GetValue(uint32_t column, uint32_t row) const override;
+  bool GetValueView(uint32_t column, uint32_t row,
+                    TableValueView* view) const override;
+  void SetValue(uint32_t column, uint32_t row, base::Value value) override;
+
+  // Delegate methods.
+  std::function<void(PagedTableModel*, uint32_t, uint32_t)> get_rows;
+  std::function<void(PagedTableModel*,
+                     uint32_t, uint32_t, base::Value)> set_value;
+
+ protected:
+  ~PagedTableModel() override;
+
+  // TableModel:
+  bool CanReadAllRows() const override;
+
+ private:
+  struct Block {
+    explicit Block(uint32_t index);
+    Block(Block&&);
+    ~Block();
+
+    uint32_t index;
+    // A row without data is still loading.
+    std::vector<Row> rows;
+  };
+
+  // Return the cached row, or nullptr if it is not loaded. Requesting the
+  // block and its neighbors if they are not cached, which runs the |get_rows|
+  // delegate, so this is const only to serve the const getters of TableModel.
+  const Row* ReadRow(uint32_t row) const;
+  // Return the block with |index| and mark it as recently used.
+  Block* FindBlock(uint32_t index) const;
+  Block* AddBlock(uint32_t index) const;
+  void RequestBlock(uint32_t index) const;
+  void RemoveBlock(uint32_t index);
+  void EvictBlocks() const;
+  uint32_t GetBlockCount() const;
+
+  const uint32_t block_size_;
+  const uint32_t max_cached_blocks_;
+  const bool index_starts_from_0_;
+  uint32_t prefetch_blocks_ = 1;
+  uint32_t rows_ = 0;
+  base::Value placeholder_;
+
+  // The cache is filled lazily when reading values, so it is mutable.
+  // The front is the most recently used block.
+  mutable std::list<Block> blocks_;
+  mutable std::unordered_map<uint32_t, std::list<Block>::iterator> blocks_map_;
+
+  // The block last read, prefetching only happens when it changes.
+  mutable uint32_t last_block_ = static_cast<uint32_t>(-1);
+  // The rows being requested in get_rows, they are being read by the table so
+  // providing them synchronously does not need to notify the table.
+  mutable uint32_t requesting_start_ = 0;
+  mutable uint32_t requesting_count_ = 0;
+};
+
+// A TableModel that sorts and filters rows of another TableModel.
+//
+// Only a permutation index of rows is stored, the data is read from the source
+// model. Changes of the source model are applied incrementally.
+class NATIVEUI_EXPORT SortFilterTableModel : public TableModel {
+ public:
+  struct NATIVEUI_EXPORT SortKey {
+    uint32_t column = 0;
+    bool ascending = true;
+  };
+
+  struct NATIVEUI_EXPORT Filter {
+    enum class Type {
+      // The cell equals |value|.
+      Equals,
+      // The cell is a string that contains |value|.
+      Contains,
+      // The cell is within [min, max], null means no limit.
+      Range,
+    };
+
+    Filter();
+    Filter(Filter&&);
+    Filter(const Filter& other);
+    ~Filter();
+    Filter& operator=(Filter&&);
+
+    Type type = Type::Equals;
+    uint32_t column = 0;
+    base::Value value;
+    base::Value min;
+    base::Value max;
+    // Compare strings ignoring ASCII case.
+    bool ignore_case = false;
+  };
+
+  explicit SortFilterTableModel(scoped_refptr<TableModel> source);
+
+  TableModel* GetSource() const { return source_.get(); }
+
+  // Sort rows by |keys| in order, rows with equal keys keep the order of
+  // source model.
+  //
+  // Sorting and filtering are ignored for sources that load rows lazily like
+  // PagedTableModel, as they would read every row including placeholders.
+  void SetSortKeys(std::vector<SortKey> keys);
+  const std::vector<SortKey>& GetSortKeys() const { return sort_keys_; }
+
+  // Only show rows that match all filters.
+  void SetFilters(std::vector<Filter> filters);
+  void AddFilter(Filter filter);
+  void ClearFilters();
+
+  // Convert row indexes between this model and source model, -1 is returned
+  // if the row is filtered out.
+  int MapToSource(uint32_t row) const;
+  int MapFromSource(uint32_t source_row) const;
+
+  // TableModel:
+  uint32_t GetRowCount() const override;
+  base::Value GetValue(uint32_t column, uint32_t row) const override;
+  bool GetValueView(uint32_t column, uint32_t row,
+                    TableValueView* view) const override;
+  void SetValue(uint32_t column, uint32_t row, base::Value value) override;
+
+ protected:
+  ~SortFilterTableModel() override;
+
+ private:
+  friend class TableModel;
+
+  // Called by source model.
+  void OnRowsInserted(uint32_t start, uint32_t count);
+  void OnRowsDeleted(uint32_t start, uint32_t count);
+  void OnRowsChanged(uint32_t start, uint32_t count);
+  void OnReset();
+
+  // Recompute the index and reload tables.
+  void Rebuild();
+  // Insert |source_row| to its sorted position if it passes filters.
+  void InsertRow(uint32_t source_row);
+  void RemoveRowAt(uint32_t row);
+
+  bool Accepts(uint32_t source_row) const;
+  // Strict weak ordering of source rows, falls back to source order.
+  bool Less(uint32_t a, uint32_t b) const;
+
+  scoped_refptr<TableModel> source_;
+  std::vector<SortKey> sort_keys_;
+  std::vector<Filter> filters_;
+  // Maps rows of this model to rows of source model.
+  std::vector<uint32_t> index_;
+  // Maps rows of source model to rows of this model, -1 for filtered rows.
+  // It is rebuilt on first use after |index_| changes.
+  mutable std::vector<int> reverse_index_;
+  mutable bool reverse_index_dirty_ = true;
+};
+
 }  // namespace nu
 
 #endif  // NATIVEUI_TABLE_MODEL_H_
@@ -48,6 +48,31 @@ class TestTableModel : public nu::TableModel {
   ~TestTableModel() override {}
 };
 
+// A model whose values can be changed without notifications.
+class AgesTableModel : public nu::TableModel {
+ public:
+  explicit AgesTableModel(std::vector<int> ages) : ages_(std::move(ages)) {}
+
+  uint32_t GetRowCount() const override {
+    return static_cast<uint32_t>(ages_.size());
+  }
+
+  base::Value GetValue(uint32_t column, uint32_t row) const override {
+    return base::Value(ages_[row]);
+  }
+
+  void SetValue(uint32_t column, uint32_t row, base::Value value) override {
+    ages_[row] = value.GetInt();
+  }
+
+  std::vector<int>& ages() { return ages_; }
+
+ private:
+  ~AgesTableModel() override {}
+
+  std::vector<int> ages_;
+};
+
 TEST_F(TableTest, SelectSingleRow) {
   table_->SetModel(new TestTableModel);
   table_->SelectRow(1989);
@@ -70,3 +95,299 @@ TEST_F(TableTest, SelectMultipleRows) {
   table_->SelectRows({});
   EXPECT_EQ(table_->GetSelectedRows(), std::set<int>());
 }
+
+TEST_F(TableTest, ColumnarTableModel) {
+  using ColumnType = nu::ColumnarTableModel::ColumnType;
+  scoped_refptr<nu::ColumnarTableModel> model = new nu::ColumnarTableModel(
+      {ColumnType::String, ColumnType::Integer, ColumnType::Bool});
+  std::vector<base::Value> row;
+  row.emplace_back("first");
+  row.emplace_back(1989);
+  row.emplace_back(true);
+  model->AddRow(row);
+  EXPECT_EQ(model->GetRowCount(), 1u);
+  EXPECT_EQ(model->GetString(0, 0), "first");
+  EXPECT_EQ(model->GetInteger(1, 0), 1989);
+  EXPECT_EQ(model->GetValue(2, 0), base::Value(true));
+  // Values of mismatched types are ignored.
+  model->SetValue(1, 0, base::Value("string"));
+  EXPECT_EQ(model->GetInteger(1, 0), 1989);
+  // Replacing strings should keep other rows intact.
+  model->AddRow(row);
+  for (int i = 0; i < 100; ++i)
+    model->SetString(0, 0, base::StringPrintf("string %d", i));
+  EXPECT_EQ(model->GetString(0, 0), "string 99");
+  EXPECT_EQ(model->GetString(0, 1), "first");
+  model->RemoveRowAt(0);
+  EXPECT_EQ(model->GetRowCount(), 1u);
+  EXPECT_EQ(model->GetString(0, 0), "first");
+  table_->SetModel(model);
+}
+
+TEST_F(TableTest, GetValueView) {
+  using ColumnType = nu::ColumnarTableModel::ColumnType;
+  scoped_refptr<nu::ColumnarTableModel> model = new nu::ColumnarTableModel(
+      {ColumnType::String, ColumnType::Double});
+  std::vector<base::Value> row;
+  row.emplace_back("cell");
+  row.emplace_back(0.5);
+  model->AddRow(row);
+  nu::TableValueView view;
+  ASSERT_TRUE(model->GetValueView(0, 0, &view));
+  ASSERT_TRUE(view.is_string());
+  EXPECT_STREQ(view.GetCString(), "cell");
+  ASSERT_TRUE(model->GetValueView(1, 0, &view));
+  EXPECT_EQ(view.ToValue(), base::Value(0.5));
+  // Out of range cells are Null.
+  ASSERT_TRUE(model->GetValueView(2, 0, &view));
+  EXPECT_TRUE(view.ToValue().is_none());
+  ASSERT_TRUE(model->GetValueView(0, 1, &view));
+  EXPECT_TRUE(view.ToValue().is_none());
+
+  scoped_refptr<nu::SimpleTableModel> simple = new nu::SimpleTableModel(1);
+  std::vector<base::Value> simple_row;
+  simple_row.emplace_back(true);
+  simple->AddRow(std::move(simple_row));
+  ASSERT_TRUE(simple->GetValueView(0, 0, &view));
+  ASSERT_TRUE(view.is_bool());
+  EXPECT_TRUE(view.GetBool());
+
+  scoped_refptr<TestTableModel> test = new TestTableModel;
+  EXPECT_FALSE(test->GetValueView(0, 0, &view));
+}
+
+TEST_F(TableTest, BatchedRowsChange) {
+  scoped_refptr<nu::SimpleTableModel> model = new nu::SimpleTableModel(1);
+  table_->AddColumn("A");
+  table_->SetModel(model);
+  // Large ranges take the path of reloading model.
+  for (uint32_t count : {10u, 10000u}) {
+    std::vector<nu::SimpleTableModel::Row> rows;
+    for (uint32_t i = 0; i < count; ++i) {
+      nu::SimpleTableModel::Row row;
+      row.emplace_back(base::StringPrintf("%u", i));
+      rows.push_back(std::move(row));
+    }
+    model->AddRows(std::move(rows));
+    EXPECT_EQ(model->GetRowCount(), count);
+    table_->SelectRow(count - 1);
+    model->RemoveRows(0, count / 2);
+    EXPECT_EQ(model->GetRowCount(), count - count / 2);
+    EXPECT_EQ(model->GetValue(0, 0),
+              base::Value(base::StringPrintf("%u", count / 2)));
+    EXPECT_EQ(table_->GetSelectedRow(),
+              static_cast<int>(count - count / 2 - 1));
+    model->Clear();
+    EXPECT_EQ(model->GetRowCount(), 0u);
+    EXPECT_EQ(table_->GetSelectedRow(), -1);
+  }
+}
+
+TEST_F(TableTest, PagedTableModel) {
+  scoped_refptr<nu::PagedTableModel> model = new nu::PagedTableModel(10, 4);
+  model->SetPlaceholder(base::Value("loading"));
+  std::vector<std::pair<uint32_t, uint32_t>> requests;
+  model->get_rows = [&requests](nu::PagedTableModel*,
+                                uint32_t start, uint32_t count) {
+    requests.emplace_back(start, count);
+  };
+  model->SetRowCount(95);
+  // Rows not provided yet show the placeholder, and neighbors are prefetched.
+  EXPECT_EQ(model->GetValue(0, 25), base::Value("loading"));
+  EXPECT_FALSE(model->IsRowLoaded(25));
+  ASSERT_EQ(requests.size(), 3u);
+  EXPECT_EQ(requests[0], std::make_pair(20u, 10u));
+  // Each block is only requested once.
+  model->GetValue(0, 26);
+  EXPECT_EQ(requests.size(), 3u);
+  // Provide rows later.
+  std::vector<nu::PagedTableModel::Row> rows;
+  for (uint32_t i = 20; i < 30; ++i) {
+    nu::PagedTableModel::Row row;
+    row.emplace_back(base::StringPrintf("%u", i));
+    rows.push_back(std::move(row));
+  }
+  model->SetRows(20, std::move(rows));
+  EXPECT_TRUE(model->IsRowLoaded(25));
+  EXPECT_EQ(model->GetValue(0, 25), base::Value("25"));
+  // The last block only has 5 rows.
+  model->GetValue(0, 94);
+  EXPECT_EQ(requests.back(), std::make_pair(80u, 10u));
+  EXPECT_EQ(requests[requests.size() - 2], std::make_pair(90u, 5u));
+  // Old blocks are evicted.
+  model->GetValue(0, 60);
+  EXPECT_FALSE(model->IsRowLoaded(25));
+  model->InvalidateAll();
+  requests.clear();
+  model->GetValue(0, 94);
+  EXPECT_EQ(requests.size(), 2u);
+}
+
+TEST_F(TableTest, PagedTableModelSyncRows) {
+  scoped_refptr<nu::PagedTableModel> model = new nu::PagedTableModel(100);
+  model->get_rows = [](nu::PagedTableModel* self,
+                       uint32_t start, uint32_t count) {
+    std::vector<nu::PagedTableModel::Row> rows(count);
+    for (uint32_t i = 0; i < count; ++i)
+      rows[i].emplace_back(static_cast<int>(start + i));
+    self->SetRows(start, std::move(rows));
+  };
+  model->SetRowCount(1000000);
+  table_->AddColumn("A");
+  table_->SetModel(model);
+  nu::TableValueView view;
+  ASSERT_TRUE(model->GetValueView(0, 999999, &view));
+  EXPECT_EQ(view.ToValue(), base::Value(999999));
+  model->SetRowCount(10);
+  EXPECT_FALSE(model->IsRowLoaded(999999));
+  EXPECT_EQ(model->GetValue(0, 9), base::Value(9));
+}
+
+namespace {
+
+scoped_refptr<nu::SimpleTableModel> CreateNamesModel() {
+  scoped_refptr<nu::SimpleTableModel> model = new nu::SimpleTableModel(2);
+  const char* names[] = {"carol", "alice", "bob", "Dave", "alice"};
+  int ages[] = {30, 25, 30, 40, 20};
+  for (size_t i = 0; i < 5; ++i) {
+    nu::SimpleTableModel::Row row;
+    row.emplace_back(names[i]);
+    row.emplace_back(ages[i]);
+    model->AddRow(std::move(row));
+  }
+  return model;
+}
+
+}  // namespace
+
+TEST_F(TableTest, SortFilterTableModelSort) {
+  scoped_refptr<nu::SimpleTableModel> source = CreateNamesModel();
+  scoped_refptr<nu::SortFilterTableModel> model =
+      new nu::SortFilterTableModel(source);
+  EXPECT_EQ(model->GetRowCount(), 5u);
+  EXPECT_EQ(model->MapToSource(3), 3);
+  // Sort by age descending, and then name.
+  nu::SortFilterTableModel::SortKey age;
+  age.column = 1;
+  age.ascending = false;
+  nu::SortFilterTableModel::SortKey name;
+  name.column = 0;
+  model->SetSortKeys({age, name});
+  std::vector<int> expected = {3, 2, 0, 1, 4};
+  for (uint32_t i = 0; i < expected.size(); ++i)
+    EXPECT_EQ(model->MapToSource(i), expected[i]);
+  // Equal keys keep the order of source.
+  model->SetSortKeys({name});
+  expected = {3, 1, 4, 2, 0};
+  for (uint32_t i = 0; i < expected.size(); ++i)
+    EXPECT_EQ(model->MapToSource(i), expected[i]);
+  EXPECT_EQ(model->MapFromSource(0), 4);
+}
+
+TEST_F(TableTest, SortFilterTableModelFilter) {
+  scoped_refptr<nu::SimpleTableModel> source = CreateNamesModel();
+  scoped_refptr<nu::SortFilterTableModel> model =
+      new nu::SortFilterTableModel(source);
+  nu::SortFilterTableModel::Filter contains;
+  contains.type = nu::SortFilterTableModel::Filter::Type::Contains;
+  contains.value = base::Value("A");
+  contains.ignore_case = true;
+  model->AddFilter(contains);
+  EXPECT_EQ(model->GetRowCount(), 4u);
+  EXPECT_EQ(model->MapFromSource(2), -1);
+  nu::SortFilterTableModel::Filter range;
+  range.type = nu::SortFilterTableModel::Filter::Type::Range;
+  range.column = 1;
+  range.min = base::Value(21);
+  range.max = base::Value(35);
+  model->AddFilter(range);
+  EXPECT_EQ(model->GetRowCount(), 2u);
+  EXPECT_EQ(model->GetValue(0, 1), base::Value("alice"));
+  model->ClearFilters();
+  nu::SortFilterTableModel::Filter equals;
+  equals.value = base::Value("alice");
+  model->AddFilter(equals);
+  EXPECT_EQ(model->GetRowCount(), 2u);
+}
+
+TEST_F(TableTest, SortFilterTableModelIncremental) {
+  scoped_refptr<nu::SimpleTableModel> source = CreateNamesModel();
+  scoped_refptr<nu::SortFilterTableModel> model =
+      new nu::SortFilterTableModel(source);
+  nu::SortFilterTableModel::SortKey age;
+  age.column = 1;
+  model->SetSortKeys({age});
+  nu::SortFilterTableModel::Filter range;
+  range.type = nu::SortFilterTableModel::Filter::Type::Range;
+  range.column = 1;
+  range.max = base::Value(35);
+  model->AddFilter(range);
+  table_->AddColumn("Name");
+  table_->SetModel(model);
+  EXPECT_EQ(model->GetRowCount(), 4u);
+  // Insertion.
+  nu::SimpleTableModel::Row row;
+  row.emplace_back("eve");
+  row.emplace_back(22);
+  source->AddRow(std::move(row));
+  EXPECT_EQ(model->GetRowCount(), 5u);
+  EXPECT_EQ(model->GetValue(0, 1), base::Value("eve"));
+  // Changing value moves the row.
+  source->SetValue(1, 5, base::Value(50));
+  EXPECT_EQ(model->GetRowCount(), 4u);
+  source->SetValue(1, 3, base::Value(10));
+  EXPECT_EQ(model->GetValue(0, 0), base::Value("Dave"));
+  // Setting value through the proxy.
+  model->SetValue(1, 0, base::Value(31));
+  EXPECT_EQ(model->GetValue(0, 4), base::Value("Dave"));
+  // Deletion shifts the rows of source.
+  source->RemoveRowAt(0);
+  EXPECT_EQ(model->GetRowCount(), 4u);
+  EXPECT_EQ(model->MapToSource(0), 3);
+  EXPECT_EQ(model->GetValue(0, 0), base::Value("alice"));
+  // The reverse mapping follows the incremental changes.
+  for (uint32_t i = 0; i < model->GetRowCount(); ++i)
+    EXPECT_EQ(model->MapFromSource(model->MapToSource(i)),
+              static_cast<int>(i));
+  EXPECT_EQ(model->MapFromSource(4), -1);
+}
+
+TEST_F(TableTest, SortFilterTableModelPagedSource) {
+  scoped_refptr<nu::PagedTableModel> source = new nu::PagedTableModel(10);
+  int requests = 0;
+  source->get_rows = [&requests](nu::PagedTableModel*, uint32_t, uint32_t) {
+    ++requests;
+  };
+  source->SetRowCount(1000);
+  scoped_refptr<nu::SortFilterTableModel> model =
+      new nu::SortFilterTableModel(source);
+  // Sorting would read every row, so it is ignored for lazily loaded rows.
+  nu::SortFilterTableModel::SortKey key;
+  model->SetSortKeys({key});
+  EXPECT_TRUE(model->GetSortKeys().empty());
+  model->AddFilter(nu::SortFilterTableModel::Filter());
+  EXPECT_EQ(requests, 0);
+  EXPECT_EQ(model->GetRowCount(), 1000u);
+  EXPECT_EQ(model->MapFromSource(999), 999);
+}
+
+TEST_F(TableTest, SortFilterTableModelRowsChanged) {
+  scoped_refptr<AgesTableModel> source = new AgesTableModel({3, 5, 6, 7});
+  scoped_refptr<nu::SortFilterTableModel> model =
+      new nu::SortFilterTableModel(source);
+  nu::SortFilterTableModel::SortKey age;
+  age.column = 0;
+  model->SetSortKeys({age});
+  table_->AddColumn("Age");
+  table_->SetModel(model);
+  // Change adjacent rows in one notification, the second one is still in
+  // order with its neighbors before the first one is moved.
+  source->ages()[1] = 1;
+  source->ages()[2] = 2;
+  source->NotifyRowsChanged(1, 2);
+  ASSERT_EQ(model->GetRowCount(), 4u);
+  EXPECT_EQ(model->GetValue(0, 0), base::Value(1));
+  EXPECT_EQ(model->GetValue(0, 1), base::Value(2));
+  EXPECT_EQ(model->GetValue(0, 2), base::Value(3));
+  EXPECT_EQ(model->GetValue(0, 3), base::Value(7));
+}
@@ -0,0 +1,157 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/task_runner.h"
+
+#include <utility>
+
+#include "nativeui/state.h"
+#include "nativeui/thread_pool.h"
+
+namespace nu {
+
+struct TaskHandle::Status : public base::RefCountedThreadSafe<Status> {
+  enum State {
+    kPending,
+    kRunning,
+    kReplyPending,
+    kReplyRunning,
+    kDone,
+    kCancelled,
+  };
+
+  explicit Status(bool has_reply) : has_reply(has_reply) {}
+
+  // Move to |to| state if current state is |from|.
+  bool Transit(int from, int to) {
+    return state.compare_exchange_strong(from, to, std::memory_order_acq_rel);
+  }
+
+  const bool has_reply;
+  std::atomic<int> state{kPending};
+
+ private:
+  friend class base::RefCountedThreadSafe<Status>;
+
+  ~Status() {}
+};
+
+TaskHandle::TaskHandle() {}
+
+TaskHandle::TaskHandle(scoped_refptr<Status> status)
+    : status_(std::move(status)) {}
+
+TaskHandle::~TaskHandle() {}
+
+TaskHandle::TaskHandle(const TaskHandle&) = default;
+
+TaskHandle& TaskHandle::operator=(const TaskHandle&) = default;
+
+bool TaskHandle::Cancel() {
+  if (!status_)
+    return false;
+  int state = status_->state.load(std::memory_order_acquire);
+  while (true) {
+    // The reply can still be cancelled when the task is running in worker.
+    bool cancellable = state == Status::kPending ||
+                       state == Status::kReplyPending ||
+                       (state == Status::kRunning && status_->has_reply);
+    if (!cancellable)
+      return false;
+    if (status_->state.compare_exchange_weak(state, Status::kCancelled,
+                                             std::memory_order_acq_rel))
+      return true;
+  }
+}
+
+bool TaskHandle::IsPending() const {
+  if (!status_)
+    return false;
+  int state = status_->state.load(std::memory_order_acquire);
+  return state != Status::kDone && state != Status::kCancelled;
+}
+
+// static
+TaskRunner* TaskRunner::GetMain() {
+  // Intentionally leaked, tasks can be posted until the process exits.
+  static TaskRunner* runner = []() {
+    auto* runner = new TaskRunner;
+    runner->AddRef();
+    return runner;
+  }();
+  return runner;
+}
+
+TaskRunner::TaskRunner(MessageLoop::Priority priority)
+    : priority_(priority) {}
+
+TaskRunner::~TaskRunner() {}
+
+TaskHandle TaskRunner::PostTask(Task task) {
+  auto status = base::MakeRefCounted<TaskHandle::Status>(false);
+  MessageLoop::PostTaskWithPriority(
+      priority_,
+      [status, task = std::move(task)]() {
+        if (!status->Transit(TaskHandle::Status::kPending,
+                             TaskHandle::Status::kRunning))
+          return;
+        task();
+        status->Transit(TaskHandle::Status::kRunning,
+                        TaskHandle::Status::kDone);
+      });
+  return TaskHandle(std::move(status));
+}
+
+TaskHandle TaskRunner::PostDelayedTask(int ms, Task task) {
+  auto status = base::MakeRefCounted<TaskHandle::Status>(false);
+  MessageLoop::PostDelayedTask(
+      ms,
+      [status, task = std::move(task)]() {
+        if (!status->Transit(TaskHandle::Status::kPending,
+                             TaskHandle::Status::kRunning))
+          return;
+        task();
+        status->Transit(TaskHandle::Status::kRunning,
+                        TaskHandle::Status::kDone);
+      });
+  return TaskHandle(std::move(status));
+}
+
+TaskHandle TaskRunner::PostTaskAndReply(Task task, Task reply,
+                                        ThreadPool* pool) {
+  if (!pool)
+    pool = ThreadPool::GetDefault();
+  auto status = base::MakeRefCounted<TaskHandle::Status>(true);
+  scoped_refptr<TaskRunner> self(this);
+  pool->PostTask(
+      [self, status, task = std::move(task),
+       reply = std::move(reply)]() mutable {
+        if (status->Transit(TaskHandle::Status::kPending,
+                            TaskHandle::Status::kRunning)) {
+          task();
+          // The handle might be cancelled while the task is running.
+          status->Transit(TaskHandle::Status::kRunning,
+                          TaskHandle::Status::kReplyPending);
+        }
+        // The reply may hold objects bound to the GUI thread, so it is always
+        // moved to the GUI thread to be released there, even if cancelled.
+        MessageLoop::PostTaskWithPriority(
+            self->priority_, [status, reply = std::move(reply)]() {
+          if (!status->Transit(TaskHandle::Status::kReplyPending,
+                               TaskHandle::Status::kReplyRunning))
+            return;
+          reply();
+          status->Transit(TaskHandle::Status::kReplyRunning,
+                          TaskHandle::Status::kDone);
+        });
+      });
+  return TaskHandle(std::move(status));
+}
+
+bool TaskRunner::RunsTasksOnCurrentThread() const {
+  State* state = State::GetCurrent();
+  return state && state == State::GetMain();
+}
+
+}  // namespace nu
@@ -0,0 +1,91 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_TASK_RUNNER_H_
+#define NATIVEUI_TASK_RUNNER_H_
+
+#include <atomic>
+
+#include "base/memory/ref_counted.h"
+#include "nativeui/message_loop.h"
+
+namespace nu {
+
+class ThreadPool;
+
+// Handle of a task posted by TaskRunner, which can be used to cancel the task.
+//
+// Unlike timer IDs, a handle is always safe to use, even after the task has
+// run. All methods are thread-safe.
+class NATIVEUI_EXPORT TaskHandle {
+ public:
+  TaskHandle();
+  ~TaskHandle();
+
+  TaskHandle(const TaskHandle&);
+  TaskHandle& operator=(const TaskHandle&);
+
+  // Prevent the task from running, returns false if the task has already
+  // started or finished. For tasks posted with PostTaskAndReply, the reply is
+  // still cancellable while the task is running.
+  bool Cancel();
+
+  // Whether the task or its reply is still going to run.
+  bool IsPending() const;
+
+ private:
+  friend class TaskRunner;
+
+  struct Status;
+
+  explicit TaskHandle(scoped_refptr<Status> status);
+
+  scoped_refptr<Status> status_;
+};
+
+// Posts tasks to the GUI thread.
+//
+// Tasks posted to the same TaskRunner run in the order they are posted. All
+// methods are thread-safe.
+class NATIVEUI_EXPORT TaskRunner
+    : public base::RefCountedThreadSafe<TaskRunner> {
+ public:
+  using Task = MessageLoop::Task;
+
+  // Return the runner of GUI thread with the default priority.
+  static TaskRunner* GetMain();
+
+  explicit TaskRunner(
+      MessageLoop::Priority priority = MessageLoop::Priority::Input);
+
+  TaskRunner& operator=(const TaskRunner&) = delete;
+  TaskRunner(const TaskRunner&) = delete;
+
+  TaskHandle PostTask(Task task);
+
+  // Delayed tasks run after |ms| milliseconds, they are not ordered with other
+  // tasks.
+  TaskHandle PostDelayedTask(int ms, Task task);
+
+  // Run |task| in the |pool|, and then run |reply| with this runner. The
+  // default thread pool is used if |pool| is null.
+  TaskHandle PostTaskAndReply(Task task, Task reply,
+                              ThreadPool* pool = nullptr);
+
+  // Whether current thread is the GUI thread.
+  bool RunsTasksOnCurrentThread() const;
+
+  MessageLoop::Priority GetPriority() const { return priority_; }
+
+ private:
+  friend class base::RefCountedThreadSafe<TaskRunner>;
+
+  ~TaskRunner();
+
+  MessageLoop::Priority priority_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_TASK_RUNNER_H_
@@ -0,0 +1,167 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// Records whether it is destroyed on the GUI thread.
+class DestructionRecorder
+    : public base::RefCountedThreadSafe<DestructionRecorder> {
+ public:
+  explicit DestructionRecorder(std::atomic<int>* on_main)
+      : on_main_(on_main) {}
+
+ private:
+  friend class base::RefCountedThreadSafe<DestructionRecorder>;
+
+  ~DestructionRecorder() {
+    *on_main_ = nu::TaskRunner::GetMain()->RunsTasksOnCurrentThread() ? 1 : 0;
+  }
+
+  std::atomic<int>* on_main_;
+};
+
+}  // namespace
+
+class TaskRunnerTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    runner_ = nu::TaskRunner::GetMain();
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  nu::TaskRunner* runner_;
+};
+
+TEST_F(TaskRunnerTest, Sequence) {
+  std::vector<int> order;
+  for (int i = 0; i < 1000; ++i)
+    runner_->PostTask([&order, i]() { order.push_back(i); });
+  runner_->PostTask([]() { nu::MessageLoop::Quit(); });
+  nu::MessageLoop::Run();
+  ASSERT_EQ(order.size(), 1000u);
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(order[i], i);
+}
+
+TEST_F(TaskRunnerTest, Cancel) {
+  bool ran = false;
+  nu::TaskHandle handle = runner_->PostTask([&ran]() { ran = true; });
+  EXPECT_TRUE(handle.IsPending());
+  EXPECT_TRUE(handle.Cancel());
+  EXPECT_FALSE(handle.IsPending());
+  EXPECT_FALSE(handle.Cancel());
+  nu::TaskHandle done = runner_->PostTask([]() { nu::MessageLoop::Quit(); });
+  nu::MessageLoop::Run();
+  EXPECT_FALSE(ran);
+  EXPECT_FALSE(done.IsPending());
+  EXPECT_FALSE(done.Cancel());
+}
+
+TEST_F(TaskRunnerTest, CancelDelayedTask) {
+  bool ran = false;
+  nu::TaskHandle handle = runner_->PostDelayedTask(10, [&ran]() {
+    ran = true;
+  });
+  handle.Cancel();
+  runner_->PostDelayedTask(50, []() { nu::MessageLoop::Quit(); });
+  nu::MessageLoop::Run();
+  EXPECT_FALSE(ran);
+}
+
+TEST_F(TaskRunnerTest, PostTaskAndReply) {
+  bool task_on_main = true;
+  bool reply_on_main = false;
+  runner_->PostTaskAndReply(
+      [this, &task_on_main]() {
+        task_on_main = runner_->RunsTasksOnCurrentThread();
+      },
+      [this, &reply_on_main]() {
+        reply_on_main = runner_->RunsTasksOnCurrentThread();
+        nu::MessageLoop::Quit();
+      });
+  nu::MessageLoop::Run();
+  EXPECT_FALSE(task_on_main);
+  EXPECT_TRUE(reply_on_main);
+}
+
+TEST_F(TaskRunnerTest, CancelReplyWhenTaskIsRunning) {
+  std::atomic<bool> started(false);
+  std::atomic<bool> cancelled(false);
+  bool replied = false;
+  nu::TaskHandle handle = runner_->PostTaskAndReply(
+      [&started, &cancelled]() {
+        started = true;
+        while (!cancelled)
+          std::this_thread::yield();
+      },
+      [&replied]() { replied = true; });
+  while (!started)
+    std::this_thread::yield();
+  EXPECT_TRUE(handle.Cancel());
+  cancelled = true;
+  runner_->PostDelayedTask(50, []() { nu::MessageLoop::Quit(); });
+  nu::MessageLoop::Run();
+  EXPECT_FALSE(replied);
+  EXPECT_FALSE(handle.IsPending());
+}
+
+TEST_F(TaskRunnerTest, CancelledReplyReleasedOnMainThread) {
+  std::atomic<bool> started(false);
+  std::atomic<bool> cancelled(false);
+  std::atomic<int> on_main(-1);
+  auto recorder = base::MakeRefCounted<DestructionRecorder>(&on_main);
+  nu::TaskHandle handle = runner_->PostTaskAndReply(
+      [&started, &cancelled]() {
+        started = true;
+        while (!cancelled)
+          std::this_thread::yield();
+      },
+      [recorder = std::move(recorder)]() {});
+  while (!started)
+    std::this_thread::yield();
+  EXPECT_TRUE(handle.Cancel());
+  cancelled = true;
+  runner_->PostDelayedTask(50, []() { nu::MessageLoop::Quit(); });
+  nu::MessageLoop::Run();
+  EXPECT_EQ(on_main, 1);
+}
+
+TEST_F(TaskRunnerTest, StressFromThreads) {
+  const int kThreads = 8;
+  const int kTasks = 5000;
+  int ran = 0;
+  std::vector<int> last(kThreads, -1);
+  bool ordered = true;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < kTasks; ++i) {
+        nu::TaskHandle handle = runner_->PostTask([&, t, i]() {
+          // Tasks from the same thread must keep their order.
+          if (last[t] >= i)
+            ordered = false;
+          last[t] = i;
+          ++ran;
+        });
+        // Cancel every other task.
+        if (i % 2 == 1)
+          handle.Cancel();
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+  runner_->PostTask([]() { nu::MessageLoop::Quit(); });
+  nu::MessageLoop::Run();
+  EXPECT_TRUE(ordered);
+  EXPECT_EQ(ran, kThreads * kTasks / 2);
+}
@@ -0,0 +1,213 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/test/asar_util.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_util.h"
+#include "base/json/json_writer.h"
+#include "base/pickle.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "base/values.h"
+#include "nativeui/util/aes.h"
+#include "nativeui/util/sha256.h"
+
+namespace nu {
+
+namespace {
+
+// Base values of deflate length and distance symbols.
+const uint16_t kLengthBase[29] = {
+    3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+    31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+const uint8_t kLengthExtra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+    2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+const uint16_t kDistanceBase[30] = {
+    1,    2,    3,    4,    5,    7,     9,     13,    17,  25,
+    33,   49,   65,   97,   129,  193,   257,   385,   513, 769,
+    1025, 1537, 2049, 3073, 4097, 6145,  8193,  12289, 16385, 24577};
+const uint8_t kDistanceExtra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+    6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+// Writes bits in the order of deflate streams.
+class BitWriter {
+ public:
+  explicit BitWriter(std::string* out) : out_(out) {}
+
+  void Write(uint32_t bits, int count) {
+    buffer_ |= bits << count_;
+    count_ += count;
+    while (count_ >= 8) {
+      out_->push_back(static_cast<char>(buffer_ & 0xff));
+      buffer_ >>= 8;
+      count_ -= 8;
+    }
+  }
+
+  // Huffman codes are written from the most significant bit.
+  void WriteCode(uint32_t code, int count) {
+    uint32_t reversed = 0;
+    for (int i = 0; i < count; ++i)
+      reversed |= ((code >> i) & 1) << (count - 1 - i);
+    Write(reversed, count);
+  }
+
+  void Flush() {
+    if (count_ > 0)
+      out_->push_back(static_cast<char>(buffer_ & 0xff));
+    buffer_ = count_ = 0;
+  }
+
+ private:
+  std::string* out_;
+  uint32_t buffer_ = 0;
+  int count_ = 0;
+};
+
+// Write |symbol| with the fixed literal/length code.
+void WriteFixedLiteral(BitWriter* writer, int symbol) {
+  if (symbol < 144)
+    writer->WriteCode(0x30 + symbol, 8);
+  else if (symbol < 256)
+    writer->WriteCode(0x190 + symbol - 144, 9);
+  else if (symbol < 280)
+    writer->WriteCode(symbol - 256, 7);
+  else
+    writer->WriteCode(0xc0 + symbol - 280, 8);
+}
+
+std::string HashToHex(const void* data, size_t size) {
+  uint8_t hash[SHA256_LENGTH];
+  SHA256::Hash(data, size, hash);
+  return base::ToLowerASCII(base::HexEncode(hash, SHA256_LENGTH));
+}
+
+}  // namespace
+
+bool WriteAsarArchive(
+    const base::FilePath& path,
+    const std::map<std::string, std::string>& files,
+    uint32_t integrity_block_size,
+    const std::map<std::string, size_t>& uncompressed_sizes) {
+  base::Value::Dict root;
+  std::string content;
+  for (const auto& [name, data] : files) {
+    std::vector<std::string> components = base::SplitString(
+        name, "/", base::KEEP_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    if (components.empty())
+      return false;
+    base::Value::Dict* dir = &root;
+    for (size_t i = 0; i < components.size() - 1; ++i) {
+      base::Value::Dict* files_dict = dir->EnsureDict("files");
+      dir = files_dict->EnsureDict(components[i]);
+    }
+    base::Value::Dict entry;
+    entry.Set("size", static_cast<int>(data.size()));
+    entry.Set("offset", base::NumberToString(content.size()));
+    if (integrity_block_size > 0) {
+      base::Value::List blocks;
+      for (size_t i = 0; i < data.size(); i += integrity_block_size) {
+        blocks.Append(HashToHex(data.data() + i,
+                                std::min<size_t>(integrity_block_size,
+                                                 data.size() - i)));
+      }
+      base::Value::Dict integrity;
+      integrity.Set("algorithm", "SHA256");
+      integrity.Set("hash", HashToHex(data.data(), data.size()));
+      integrity.Set("blockSize", static_cast<int>(integrity_block_size));
+      integrity.Set("blocks", std::move(blocks));
+      entry.Set("integrity", std::move(integrity));
+    }
+    auto it = uncompressed_sizes.find(name);
+    if (it != uncompressed_sizes.end()) {
+      entry.Set("compression", "deflate");
+      entry.Set("uncompressedSize", static_cast<int>(it->second));
+    }
+    dir->EnsureDict("files")->Set(components.back(), std::move(entry));
+    content += data;
+  }
+
+  std::string json;
+  if (!base::JSONWriter::Write(root, &json))
+    return false;
+  base::Pickle header;
+  header.WriteString(json);
+  base::Pickle size;
+  size.WriteUInt32(static_cast<uint32_t>(header.size()));
+
+  std::string archive(static_cast<const char*>(size.data()), size.size());
+  archive.append(static_cast<const char*>(header.data()), header.size());
+  archive += content;
+  return base::WriteFile(path, archive);
+}
+
+std::string CompressAsarContent(const std::string& content) {
+  // A single block of fixed Huffman codes, with matches found greedily by
+  // remembering the last position of each 3-byte hash.
+  std::string result;
+  BitWriter writer(&result);
+  writer.Write(1, 1);  // final block
+  writer.Write(1, 2);  // fixed Huffman codes
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(content.data());
+  const size_t size = content.size();
+  std::vector<int64_t> last(1 << 15, -1);
+  size_t pos = 0;
+  while (pos < size) {
+    size_t length = 0;
+    size_t distance = 0;
+    if (pos + 3 <= size) {
+      uint32_t hash = ((data[pos] << 10) ^ (data[pos + 1] << 5) ^
+                       data[pos + 2]) & 0x7fff;
+      int64_t candidate = last[hash];
+      last[hash] = pos;
+      if (candidate >= 0 && pos - candidate <= 32768) {
+        size_t max = std::min<size_t>(258, size - pos);
+        while (length < max && data[candidate + length] == data[pos + length])
+          ++length;
+        distance = pos - candidate;
+      }
+    }
+    if (length < 3) {
+      WriteFixedLiteral(&writer, data[pos++]);
+      continue;
+    }
+    int symbol = 28;
+    while (kLengthBase[symbol] > length)
+      --symbol;
+    WriteFixedLiteral(&writer, 257 + symbol);
+    writer.Write(length - kLengthBase[symbol], kLengthExtra[symbol]);
+    symbol = 29;
+    while (kDistanceBase[symbol] > distance)
+      --symbol;
+    writer.WriteCode(symbol, 5);
+    writer.Write(distance - kDistanceBase[symbol], kDistanceExtra[symbol]);
+    pos += length;
+  }
+  WriteFixedLiteral(&writer, 256);  // end of block
+  writer.Flush();
+  return result;
+}
+
+std::string EncryptAsarContent(const std::string& content,
+                               const std::string& key,
+                               const std::string& iv) {
+  AES aes;
+  if (!aes.Init(key, iv))
+    return std::string();
+  size_t paddings = AES_BLOCKLEN - content.size() % AES_BLOCKLEN;
+  std::string result =
+      content + std::string(paddings, static_cast<char>(paddings));
+  aes.CBCEncryptBuffer(reinterpret_cast<uint8_t*>(&result[0]),
+                       static_cast<uint32_t>(result.size()));
+  return result;
+}
+
+}  // namespace nu
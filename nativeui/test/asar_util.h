@@ -0,0 +1,39 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_TEST_ASAR_UTIL_H_
+#define NATIVEUI_TEST_ASAR_UTIL_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <string>
+
+#include "base/files/file_path.h"
+
+namespace nu {
+
+// Write an asar archive at |path| with |files|, which maps paths like
+// "dir/file.txt" to file contents. When |integrity_block_size| is not 0, the
+// integrity info is written with hashes of blocks of that size. Files in
+// |uncompressed_sizes| are marked as deflate compressed with the sizes.
+bool WriteAsarArchive(
+    const base::FilePath& path,
+    const std::map<std::string, std::string>& files,
+    uint32_t integrity_block_size = 0,
+    const std::map<std::string, size_t>& uncompressed_sizes = {});
+
+// Compress |content| into raw deflate data, in the same way with compressed
+// asar archives.
+std::string CompressAsarContent(const std::string& content);
+
+// Encrypt |content| with AES-128 CBC and PKCS#7 padding, in the same way
+// with encrypted asar archives.
+std::string EncryptAsarContent(const std::string& content,
+                               const std::string& key,
+                               const std::string& iv);
+
+}  // namespace nu
+
+#endif  // NATIVEUI_TEST_ASAR_UTIL_H_
@@ -0,0 +1,213 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/test/benchmark.h"
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "base/command_line.h"
+#include "base/files/file_util.h"
+#include "base/json/json_writer.h"
+#include "base/no_destructor.h"
+#include "base/strings/pattern.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/system/sys_info.h"
+#include "base/values.h"
+
+namespace nu {
+
+namespace {
+
+// Never run more iterations than this.
+const int64_t kMaxIterations = 1000000000;
+
+struct Result {
+  std::string name;
+  int64_t iterations;
+  double real_time;  // nanoseconds per iteration
+  double cpu_time;
+  int64_t items_processed;
+  int64_t bytes_processed;
+  std::string label;
+};
+
+std::vector<std::unique_ptr<Benchmark>>& GetBenchmarks() {
+  static base::NoDestructor<std::vector<std::unique_ptr<Benchmark>>> list;
+  return *list;
+}
+
+Result RunOne(const Benchmark& benchmark,
+              const std::string& name,
+              std::vector<int64_t> ranges,
+              base::TimeDelta min_time) {
+  int64_t iterations = benchmark.iterations() > 0 ? benchmark.iterations() : 1;
+  while (true) {
+    BenchmarkState state(iterations, ranges);
+    benchmark.function()(&state);
+    base::TimeDelta elapsed = state.real_time();
+    // Stop when the run is long enough, otherwise predict the iterations
+    // needed from this run.
+    if (benchmark.iterations() > 0 || elapsed >= min_time ||
+        iterations >= kMaxIterations) {
+      Result result;
+      result.name = name;
+      result.iterations = state.iterations();
+      double count = std::max<int64_t>(state.iterations(), 1);
+      result.real_time = elapsed.InNanosecondsF() / count;
+      result.cpu_time = state.cpu_time().InNanosecondsF() / count;
+      result.items_processed = state.items_processed();
+      result.bytes_processed = state.bytes_processed();
+      result.label = state.label();
+      return result;
+    }
+    double multiplier = min_time.InSecondsF() * 1.4 /
+                        std::max(elapsed.InSecondsF(), 1e-9);
+    multiplier = std::clamp(multiplier, 2.0, 100.0);
+    iterations = std::min(static_cast<int64_t>(iterations * multiplier),
+                          kMaxIterations);
+  }
+}
+
+base::Value::Dict ResultToValue(const Result& result) {
+  base::Value::Dict dict;
+  dict.Set("name", result.name);
+  dict.Set("run_name", result.name);
+  dict.Set("run_type", "iteration");
+  dict.Set("iterations", static_cast<double>(result.iterations));
+  dict.Set("real_time", result.real_time);
+  dict.Set("cpu_time", result.cpu_time);
+  dict.Set("time_unit", "ns");
+  if (result.items_processed > 0 && result.real_time > 0) {
+    dict.Set("items_per_second",
+             result.items_processed * 1e9 /
+                 (result.real_time * result.iterations));
+  }
+  if (result.bytes_processed > 0 && result.real_time > 0) {
+    dict.Set("bytes_per_second",
+             result.bytes_processed * 1e9 /
+                 (result.real_time * result.iterations));
+  }
+  if (!result.label.empty())
+    dict.Set("label", result.label);
+  return dict;
+}
+
+}  // namespace
+
+BenchmarkState::BenchmarkState(int64_t max_iterations,
+                               std::vector<int64_t> ranges)
+    : max_iterations_(max_iterations), ranges_(std::move(ranges)) {}
+
+BenchmarkState::~BenchmarkState() {}
+
+void BenchmarkState::PauseTiming() {
+  if (!running_)
+    return;
+  running_ = false;
+  real_time_ += base::TimeTicks::Now() - start_;
+  if (base::ThreadTicks::IsSupported())
+    cpu_time_ += base::ThreadTicks::Now() - cpu_start_;
+}
+
+void BenchmarkState::ResumeTiming() {
+  if (running_)
+    return;
+  running_ = true;
+  if (base::ThreadTicks::IsSupported())
+    cpu_start_ = base::ThreadTicks::Now();
+  start_ = base::TimeTicks::Now();
+}
+
+Benchmark::Benchmark(const char* name, Function function)
+    : name_(name), function_(function) {}
+
+Benchmark::~Benchmark() {}
+
+Benchmark* Benchmark::Arg(int64_t arg) {
+  args_.push_back(arg);
+  return this;
+}
+
+Benchmark* Benchmark::Iterations(int64_t iterations) {
+  iterations_ = iterations;
+  return this;
+}
+
+Benchmark* RegisterBenchmark(const char* name, Benchmark::Function function) {
+  GetBenchmarks().push_back(std::make_unique<Benchmark>(name, function));
+  return GetBenchmarks().back().get();
+}
+
+int RunBenchmarks() {
+  const base::CommandLine* cmd = base::CommandLine::ForCurrentProcess();
+  std::string filter = cmd->GetSwitchValueASCII("benchmark_filter");
+  double min_time_secs = 0.5;
+  if (cmd->HasSwitch("benchmark_min_time") &&
+      !base::StringToDouble(cmd->GetSwitchValueASCII("benchmark_min_time"),
+                            &min_time_secs)) {
+    fprintf(stderr, "Invalid --benchmark_min_time\n");
+    return 1;
+  }
+  base::TimeDelta min_time = base::Seconds(min_time_secs);
+
+  std::vector<Result> results;
+  printf("%-48s %14s %14s %12s\n", "Benchmark", "Time(ns)", "CPU(ns)",
+         "Iterations");
+  for (const auto& benchmark : GetBenchmarks()) {
+    std::vector<std::pair<std::string, std::vector<int64_t>>> runs;
+    if (benchmark->args().empty()) {
+      runs.emplace_back(benchmark->name(), std::vector<int64_t>());
+    } else {
+      for (int64_t arg : benchmark->args()) {
+        runs.emplace_back(
+            benchmark->name() + "/" + base::NumberToString(arg),
+            std::vector<int64_t>{arg});
+      }
+    }
+    for (auto& run : runs) {
+      if (!filter.empty() && !base::MatchPattern(run.first, filter))
+        continue;
+      Result result = RunOne(*benchmark, run.first, std::move(run.second),
+                             min_time);
+      printf("%-48s %14.0f %14.0f %12lld %s\n", result.name.c_str(),
+             result.real_time, result.cpu_time,
+             static_cast<long long>(result.iterations),  // NOLINT
+             result.label.c_str());
+      fflush(stdout);
+      results.push_back(std::move(result));
+    }
+  }
+
+  base::FilePath out = cmd->GetSwitchValuePath("benchmark_out");
+  if (out.empty())
+    return 0;
+  base::Value::Dict context;
+  context.Set("executable", cmd->GetProgram().AsUTF8Unsafe());
+  context.Set("num_cpus", base::SysInfo::NumberOfProcessors());
+#if defined(NDEBUG)
+  context.Set("library_build_type", "release");
+#else
+  context.Set("library_build_type", "debug");
+#endif
+  base::Value::List list;
+  for (const Result& result : results)
+    list.Append(ResultToValue(result));
+  base::Value::Dict root;
+  root.Set("context", std::move(context));
+  root.Set("benchmarks", std::move(list));
+  std::string json;
+  if (!base::JSONWriter::WriteWithOptions(
+          root, base::JSONWriter::OPTIONS_PRETTY_PRINT, &json) ||
+      !base::WriteFile(out, json)) {
+    fprintf(stderr, "Failed to write %s\n", out.AsUTF8Unsafe().c_str());
+    return 1;
+  }
+  return 0;
+}
+
+}  // namespace nu
@@ -0,0 +1,126 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_TEST_BENCHMARK_H_
+#define NATIVEUI_TEST_BENCHMARK_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/time/time.h"
+
+namespace nu {
+
+// A minimal benchmark harness modeled after Google Benchmark, the output of
+// --benchmark_out is in the same JSON format so existing tools can read it.
+//
+//   void BM_Something(BenchmarkState* state) {
+//     Setup(state->range(0));
+//     while (state->KeepRunning())
+//       DoSomething();
+//   }
+//   NU_BENCHMARK(BM_Something)->Arg(10)->Arg(1000);
+class BenchmarkState {
+ public:
+  BenchmarkState(int64_t max_iterations, std::vector<int64_t> ranges);
+  ~BenchmarkState();
+
+  BenchmarkState& operator=(const BenchmarkState&) = delete;
+  BenchmarkState(const BenchmarkState&) = delete;
+
+  // Return true until the loop has run for max iterations, the time between
+  // the first and last call is measured.
+  bool KeepRunning() {
+    if (iterations_ < max_iterations_) {
+      if (iterations_++ == 0)
+        ResumeTiming();
+      return true;
+    }
+    if (running_)
+      PauseTiming();
+    return false;
+  }
+
+  // Exclude the setup code inside the loop from measurement.
+  void PauseTiming();
+  void ResumeTiming();
+
+  void SetItemsProcessed(int64_t items) { items_processed_ = items; }
+  void SetBytesProcessed(int64_t bytes) { bytes_processed_ = bytes; }
+  void SetLabel(std::string label) { label_ = std::move(label); }
+
+  int64_t range(size_t index = 0) const { return ranges_.at(index); }
+  int64_t iterations() const { return iterations_; }
+
+  base::TimeDelta real_time() const { return real_time_; }
+  base::TimeDelta cpu_time() const { return cpu_time_; }
+  int64_t items_processed() const { return items_processed_; }
+  int64_t bytes_processed() const { return bytes_processed_; }
+  const std::string& label() const { return label_; }
+
+ private:
+  const int64_t max_iterations_;
+  const std::vector<int64_t> ranges_;
+  int64_t iterations_ = 0;
+  int64_t items_processed_ = 0;
+  int64_t bytes_processed_ = 0;
+  std::string label_;
+
+  bool running_ = false;
+  base::TimeTicks start_;
+  base::ThreadTicks cpu_start_;
+  base::TimeDelta real_time_;
+  base::TimeDelta cpu_time_;
+};
+
+class Benchmark {
+ public:
+  using Function = void (*)(BenchmarkState* state);
+
+  Benchmark(const char* name, Function function);
+  ~Benchmark();
+
+  Benchmark& operator=(const Benchmark&) = delete;
+  Benchmark(const Benchmark&) = delete;
+
+  // Run the benchmark once for each argument.
+  Benchmark* Arg(int64_t arg);
+  // Run the benchmark with a fixed number of iterations, which is useful for
+  // expensive benchmarks.
+  Benchmark* Iterations(int64_t iterations);
+
+  const std::string& name() const { return name_; }
+  Function function() const { return function_; }
+  const std::vector<int64_t>& args() const { return args_; }
+  int64_t iterations() const { return iterations_; }
+
+ private:
+  std::string name_;
+  Function function_;
+  std::vector<int64_t> args_;
+  int64_t iterations_ = 0;
+};
+
+Benchmark* RegisterBenchmark(const char* name, Benchmark::Function function);
+
+// Run the benchmarks selected by command line switches:
+// --benchmark_filter=<pattern>  Only run benchmarks matching the wildcards.
+// --benchmark_min_time=<secs>   Minimum time to run each benchmark.
+// --benchmark_out=<file>        Write results to |file| in JSON.
+int RunBenchmarks();
+
+}  // namespace nu
+
+#define NU_BENCHMARK(function)                      \
+  static nu::Benchmark* NU_BENCHMARK_UID(benchmark_) = \
+      nu::RegisterBenchmark(#function, function)
+
+#define NU_BENCHMARK_UID(prefix) NU_BENCHMARK_UID2(prefix, __LINE__)
+#define NU_BENCHMARK_UID2(prefix, line) NU_BENCHMARK_UID3(prefix, line)
+#define NU_BENCHMARK_UID3(prefix, line) prefix##line
+
+#endif  // NATIVEUI_TEST_BENCHMARK_H_
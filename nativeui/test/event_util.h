@@ -0,0 +1,20 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_TEST_EVENT_UTIL_H_
+#define NATIVEUI_TEST_EVENT_UTIL_H_
+
+#include "nativeui/gfx/geometry/point_f.h"
+
+namespace nu {
+
+class View;
+
+// Create a native mouse move event at |point| of |view|, and deliver it with
+// View::DispatchMouseMove.
+void DispatchMouseMove(View* view, const PointF& point);
+
+}  // namespace nu
+
+#endif  // NATIVEUI_TEST_EVENT_UTIL_H_
@@ -0,0 +1,22 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/test/event_util.h"
+
+#include <gtk/gtk.h>
+
+#include "nativeui/events/event.h"
+#include "nativeui/view.h"
+
+namespace nu {
+
+void DispatchMouseMove(View* view, const PointF& point) {
+  GdkEvent* event = gdk_event_new(GDK_MOTION_NOTIFY);
+  event->motion.x = point.x();
+  event->motion.y = point.y();
+  view->DispatchMouseMove(MouseEvent(event, view->GetNative()));
+  gdk_event_free(event);
+}
+
+}  // namespace nu
@@ -0,0 +1,32 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/test/event_util.h"
+
+#import <Cocoa/Cocoa.h>
+
+#include "nativeui/events/event.h"
+#include "nativeui/view.h"
+
+namespace nu {
+
+void DispatchMouseMove(View* view, const PointF& point) {
+  NSView* native = view->GetNative();
+  NSPoint location = NSMakePoint(point.x(), point.y());
+  if (![native isFlipped])
+    location.y = NSHeight([native frame]) - location.y;
+  location = [native convertPoint:location toView:nil];
+  NSEvent* event = [NSEvent mouseEventWithType:NSEventTypeMouseMoved
+                                      location:location
+                                 modifierFlags:0
+                                     timestamp:0
+                                  windowNumber:[[native window] windowNumber]
+                                       context:nil
+                                   eventNumber:0
+                                    clickCount:0
+                                      pressure:0];
+  view->DispatchMouseMove(MouseEvent(event, native));
+}
+
+}  // namespace nu
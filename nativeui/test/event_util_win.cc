@@ -0,0 +1,23 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/test/event_util.h"
+
+#include "nativeui/events/event.h"
+#include "nativeui/events/win/event_win.h"
+#include "nativeui/gfx/geometry/point_conversions.h"
+#include "nativeui/view.h"
+#include "nativeui/win/view_win.h"
+
+namespace nu {
+
+void DispatchMouseMove(View* view, const PointF& point) {
+  ViewImpl* native = view->GetNative();
+  Point pos = ToFlooredPoint(ScalePoint(point, native->scale_factor()));
+  pos += native->size_allocation().OffsetFromOrigin();
+  Win32Message message = {WM_MOUSEMOVE, 0, MAKELPARAM(pos.x(), pos.y())};
+  view->DispatchMouseMove(MouseEvent(&message, native));
+}
+
+}  // namespace nu
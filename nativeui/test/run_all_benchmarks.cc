@@ -0,0 +1,14 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "base/command_line.h"
+#include "nativeui/nativeui.h"
+#include "nativeui/test/benchmark.h"
+
+int main(int argc, char** argv) {
+  base::CommandLine::Init(argc, argv);
+  nu::Lifetime lifetime;
+  nu::State state;
+  return nu::RunBenchmarks();
+}
@@ -0,0 +1,238 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/thread_pool.h"
+
+#include <utility>
+
+#include "base/containers/circular_deque.h"
+#include "base/files/file_util.h"
+#include "base/hash/sha1.h"
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/system/sys_info.h"
+#include "base/threading/platform_thread.h"
+#include "nativeui/gfx/image.h"
+#include "nativeui/message_loop.h"
+
+#if defined(OS_MAC)
+#include "base/apple/scoped_nsautorelease_pool.h"
+#elif defined(OS_WIN)
+#include "nativeui/gfx/win/gdiplus.h"
+#endif
+
+namespace nu {
+
+namespace {
+
+// The worker running on current thread.
+thread_local void* g_current_worker = nullptr;
+
+}  // namespace
+
+class ThreadPool::Worker : public base::PlatformThread::Delegate {
+ public:
+  Worker(ThreadPool* pool, size_t index) : pool_(pool), index_(index) {}
+
+  ~Worker() override {
+    if (!handle_.is_null())
+      base::PlatformThread::Join(handle_);
+  }
+
+  void Start() {
+    if (!base::PlatformThread::Create(0, this, &handle_))
+      LOG(ERROR) << "Failed to create worker thread";
+  }
+
+  // The owner works on the back of queue, while thieves take from front, so
+  // tasks posted recently by the owner are likely still in cache.
+  void Push(Task task) {
+    base::AutoLock auto_lock(lock_);
+    tasks_.push_back(std::move(task));
+  }
+
+  bool Pop(Task* task) {
+    base::AutoLock auto_lock(lock_);
+    if (tasks_.empty())
+      return false;
+    *task = std::move(tasks_.back());
+    tasks_.pop_back();
+    return true;
+  }
+
+  bool Steal(Task* task) {
+    base::AutoLock auto_lock(lock_);
+    if (tasks_.empty())
+      return false;
+    *task = std::move(tasks_.front());
+    tasks_.pop_front();
+    return true;
+  }
+
+  void Clear() {
+    base::AutoLock auto_lock(lock_);
+    tasks_.clear();
+  }
+
+  ThreadPool* pool() const { return pool_; }
+  size_t index() const { return index_; }
+
+  // base::PlatformThread::Delegate:
+  void ThreadMain() override {
+    base::PlatformThread::SetName("YueWorker");
+    g_current_worker = this;
+    Task task;
+    while (pool_->GetTask(this, &task)) {
+      task();
+      task = nullptr;
+    }
+    g_current_worker = nullptr;
+  }
+
+ private:
+  ThreadPool* pool_;
+  size_t index_;
+  base::PlatformThreadHandle handle_;
+
+  base::Lock lock_;
+  base::circular_deque<Task> tasks_;
+};
+
+// static
+ThreadPool* ThreadPool::GetDefault() {
+  // Intentionally leaked, worker threads may still be running on exit.
+  static ThreadPool* pool = new ThreadPool;
+  return pool;
+}
+
+// static
+void ThreadPool::ReadFile(
+    const base::FilePath& path,
+    std::function<void(std::optional<std::string>)> callback) {
+  GetDefault()->PostTask([path, callback = std::move(callback)]() mutable {
+    std::optional<std::string> content(std::in_place);
+    if (!base::ReadFileToString(path, &*content))
+      content.reset();
+    // Move the callback to GUI thread, it can only be destroyed there.
+    MessageLoop::PostTask([callback = std::move(callback),
+                           content = std::move(content)]() mutable {
+      callback(std::move(content));
+    });
+  });
+}
+
+// static
+void ThreadPool::DecodeImage(
+    const base::FilePath& path,
+    std::function<void(scoped_refptr<Image>)> callback) {
+  GetDefault()->PostTask([path, callback = std::move(callback)]() mutable {
+    scoped_refptr<Image> image;
+    {
+#if defined(OS_MAC)
+      // Workers have no autorelease pool, release the Cocoa objects created
+      // when decoding.
+      base::apple::ScopedNSAutoreleasePool autorelease_pool;
+#endif
+      image = new Image(path);
+#if defined(OS_WIN)
+      // Gdiplus decodes lazily, draw the image once so the decoding happens on
+      // the worker instead of the first paint.
+      Gdiplus::Bitmap bitmap(1, 1, PixelFormat32bppPARGB);
+      Gdiplus::Graphics graphics(&bitmap);
+      graphics.DrawImage(image->GetNative(), 0, 0, 1, 1);
+#endif
+    }
+    // The image is only moved on the worker, its reference count is not
+    // touched until the GUI thread receives it.
+    MessageLoop::PostTask([callback = std::move(callback),
+                           image = std::move(image)]() mutable {
+      callback(std::move(image));
+    });
+  });
+}
+
+// static
+void ThreadPool::SHA1(std::string data,
+                      std::function<void(std::string)> callback) {
+  GetDefault()->PostTask([data = std::move(data),
+                          callback = std::move(callback)]() mutable {
+    std::string hash = base::ToLowerASCII(
+        base::HexEncode(base::SHA1HashString(data)));
+    MessageLoop::PostTask([callback = std::move(callback),
+                           hash = std::move(hash)]() mutable {
+      callback(std::move(hash));
+    });
+  });
+}
+
+ThreadPool::ThreadPool(int size) : has_task_(&lock_) {
+  if (size <= 0)
+    size = base::SysInfo::NumberOfProcessors();
+  // Create all workers before starting them, as workers read |workers_| when
+  // stealing tasks.
+  for (int i = 0; i < size; ++i)
+    workers_.push_back(std::make_unique<Worker>(this, i));
+  for (auto& worker : workers_)
+    worker->Start();
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    base::AutoLock auto_lock(lock_);
+    shutting_down_ = true;
+  }
+  has_task_.Broadcast();
+  for (auto& worker : workers_)
+    worker->Clear();
+  // Join the threads.
+  workers_.clear();
+}
+
+void ThreadPool::PostTask(Task task) {
+  // Count the task before pushing it, otherwise a worker may take the task and
+  // decrease the counter first. A worker seeing the count before the task is
+  // pushed just polls the queues again.
+  pending_tasks_.fetch_add(1);
+  auto* current = static_cast<Worker*>(g_current_worker);
+  if (current && current->pool() == this) {
+    current->Push(std::move(task));
+  } else {
+    size_t i = next_worker_.fetch_add(1, std::memory_order_relaxed);
+    workers_[i % workers_.size()]->Push(std::move(task));
+  }
+  // Wake up a sleeping worker. Since the waiters re-check |pending_tasks_|
+  // after increasing |idle_workers_|, either the waiter sees the task or we
+  // see the waiter.
+  if (idle_workers_.load() > 0) {
+    base::AutoLock auto_lock(lock_);
+    has_task_.Signal();
+  }
+}
+
+bool ThreadPool::GetTask(Worker* worker, Task* task) {
+  while (!shutting_down_) {
+    if (worker->Pop(task) || StealTask(worker, task)) {
+      pending_tasks_.fetch_sub(1);
+      return true;
+    }
+    base::AutoLock auto_lock(lock_);
+    idle_workers_.fetch_add(1);
+    while (pending_tasks_.load() == 0 && !shutting_down_)
+      has_task_.Wait();
+    idle_workers_.fetch_sub(1);
+  }
+  return false;
+}
+
+bool ThreadPool::StealTask(Worker* thief, Task* task) {
+  size_t size = workers_.size();
+  for (size_t i = 1; i < size; ++i) {
+    if (workers_[(thief->index() + i) % size]->Steal(task))
+      return true;
+  }
+  return false;
+}
+
+}  // namespace nu
@@ -0,0 +1,90 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_THREAD_POOL_H_
+#define NATIVEUI_THREAD_POOL_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "nativeui/nativeui_export.h"
+
+namespace nu {
+
+class Image;
+
+// A pool of worker threads for running tasks off the GUI thread.
+//
+// Each worker has its own queue of tasks, and idle workers steal tasks from
+// the others. Tasks posted from a worker go to the worker's own queue, tasks
+// posted from other threads are spread among the workers.
+//
+// All methods are thread-safe.
+class NATIVEUI_EXPORT ThreadPool {
+ public:
+  using Task = std::function<void()>;
+
+  // Return the pool shared by the process, which has one thread for each
+  // core.
+  static ThreadPool* GetDefault();
+
+  // Native jobs that run in the default pool, the |callback| is called on the
+  // GUI thread with the result.
+  static void ReadFile(
+      const base::FilePath& path,
+      std::function<void(std::optional<std::string>)> callback);
+  static void DecodeImage(const base::FilePath& path,
+                          std::function<void(scoped_refptr<Image>)> callback);
+  static void SHA1(std::string data,
+                   std::function<void(std::string)> callback);
+
+  // Create a pool with |size| threads, or one thread for each core if |size|
+  // is not positive.
+  explicit ThreadPool(int size = 0);
+  // Wait for running tasks to finish, pending tasks are discarded.
+  ~ThreadPool();
+
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ThreadPool(const ThreadPool&) = delete;
+
+  void PostTask(Task task);
+
+  int GetSize() const { return static_cast<int>(workers_.size()); }
+
+ private:
+  class Worker;
+
+  // Wait for a task for |worker|, returns false when the pool is shutting
+  // down.
+  bool GetTask(Worker* worker, Task* task);
+
+  // Take a task from other workers' queues.
+  bool StealTask(Worker* thief, Task* task);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  // Where to put next task posted from outside the pool.
+  std::atomic<size_t> next_worker_{0};
+
+  // Number of tasks in all queues.
+  std::atomic<int> pending_tasks_{0};
+
+  // Used for putting idle workers to sleep.
+  base::Lock lock_;
+  base::ConditionVariable has_task_;
+  std::atomic<int> idle_workers_{0};
+  std::atomic<bool> shutting_down_{false};
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_THREAD_POOL_H_
@@ -0,0 +1,76 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <atomic>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class ThreadPoolTest : public testing::Test {
+ protected:
+  void SetUp() override {
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+};
+
+TEST_F(ThreadPoolTest, RunTasks) {
+  const int kTasks = 10000;
+  std::atomic<int> count(0);
+  {
+    nu::ThreadPool pool(4);
+    EXPECT_EQ(pool.GetSize(), 4);
+    for (int i = 0; i < kTasks; ++i) {
+      pool.PostTask([&count]() {
+        if (++count == kTasks)
+          nu::MessageLoop::PostTask([]() { nu::MessageLoop::Quit(); });
+      });
+    }
+    nu::MessageLoop::Run();
+  }
+  EXPECT_EQ(count, kTasks);
+}
+
+TEST_F(ThreadPoolTest, PostTaskFromWorker) {
+  nu::ThreadPool pool(2);
+  std::atomic<int> count(0);
+  // Tasks posted from workers go to their own queues and get stolen.
+  pool.PostTask([&pool, &count]() {
+    for (int i = 0; i < 100; ++i) {
+      pool.PostTask([&count]() {
+        if (++count == 100)
+          nu::MessageLoop::PostTask([]() { nu::MessageLoop::Quit(); });
+      });
+    }
+  });
+  nu::MessageLoop::Run();
+  EXPECT_EQ(count, 100);
+}
+
+TEST_F(ThreadPoolTest, ReadFile) {
+  base::ScopedTempDir dir;
+  ASSERT_TRUE(dir.CreateUniqueTempDir());
+  base::FilePath path = dir.GetPath().AppendASCII("file");
+  ASSERT_EQ(base::WriteFile(path, "content", 7), 7);
+  std::optional<std::string> result;
+  nu::ThreadPool::ReadFile(path, [&result](std::optional<std::string> c) {
+    result = std::move(c);
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+  EXPECT_EQ(result, "content");
+}
+
+TEST_F(ThreadPoolTest, SHA1) {
+  std::string result;
+  nu::ThreadPool::SHA1("abc", [&result](std::string hash) {
+    result = std::move(hash);
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+  EXPECT_EQ(result, "a9993e364706816aba3e25717850c26c9cd0d89d");
+}
@@ -32,6 +32,8 @@
 
 #include <string.h>
 
+#include "nativeui/util/aes_hw.h"
+
 // The number of columns comprising a state in AES.
 // This is a constant in AES. Value=4.
 #define Nb 4
@@ -363,11 +365,17 @@ void XorWithIv(uint8_t* buf, uint8_t* iv) {
 
 }  // namespace
 
-bool AES::Init(const std::string& key, const std::string& iv) {
+bool AES::Init(const std::string& key,
+               const std::string& iv,
+               bool allow_hardware) {
   if (key.size() != AES_BLOCKLEN || iv.size() != AES_BLOCKLEN)
     return false;
   KeyExpansion(round_key_, (uint8_t*)(key.data()));
   memcpy(iv_, (uint8_t*)(iv.data()), AES_BLOCKLEN);
+  // The hardware path only implements AES-128.
+  use_hardware_ = allow_hardware && AES_KEYLEN == 16 && HasHardwareAES();
+  if (use_hardware_)
+    HardwareAESExpandDecryptKey(round_key_, dec_key_);
   is_valid_ = true;
   return true;
 }
@@ -385,6 +393,10 @@ void AES::CBCEncryptBuffer(uint8_t* buf, uint32_t len) {
 }
 
 void AES::CBCDecryptBuffer(uint8_t* buf, uint32_t len) {
+  if (use_hardware_) {
+    HardwareAESCBCDecrypt(dec_key_, iv_, buf, len);
+    return;
+  }
   uint8_t storeNextIv[AES_BLOCKLEN];
   for (uint32_t i = 0; i < len; i += AES_BLOCKLEN) {
     memcpy(storeNextIv, buf, AES_BLOCKLEN);
@@ -8,6 +8,8 @@
 
 #include <string>
 
+#include "nativeui/nativeui_export.h"
+
 #define AES128 1
 #define AES_BLOCKLEN 16
 
@@ -24,19 +26,27 @@
 
 namespace nu {
 
-class AES {
+class NATIVEUI_EXPORT AES {
  public:
-  bool Init(const std::string& key, const std::string& iv);
+  // Decryption uses AES instructions of CPU when available, unless
+  // |allow_hardware| is false.
+  bool Init(const std::string& key,
+            const std::string& iv,
+            bool allow_hardware = true);
   bool IsValid() const { return is_valid_; }
+  bool IsHardwareAccelerated() const { return use_hardware_; }
 
   void CBCEncryptBuffer(uint8_t* buf, uint32_t len);
   void CBCDecryptBuffer(uint8_t* buf, uint32_t len);
 
  private:
   bool is_valid_ = false;
+  bool use_hardware_ = false;
 
   uint8_t round_key_[AES_KEYEXPSIZE];
   uint8_t iv_[AES_BLOCKLEN];
+  // Round keys of the equivalent inverse cipher used by hardware.
+  uint8_t dec_key_[AES_KEYEXPSIZE];
 };
 
 }  // namespace nu
@@ -0,0 +1,201 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/aes_hw.h"
+
+#include "build/build_config.h"
+
+#if defined(ARCH_CPU_X86_FAMILY)
+#include <wmmintrin.h>
+#include "base/cpu.h"
+#elif defined(ARCH_CPU_ARM64)
+#include <arm_neon.h>
+#if defined(OS_LINUX)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#elif defined(OS_WIN)
+#include <windows.h>
+#endif
+#endif
+
+#include "base/logging.h"
+
+// Functions using the instructions must be compiled for them, they are only
+// called after checking the CPU.
+#if defined(COMPILER_MSVC) && !defined(__clang__)
+#define NU_TARGET_AES
+#elif defined(ARCH_CPU_X86_FAMILY)
+#define NU_TARGET_AES __attribute__((target("aes,sse2")))
+#else
+#define NU_TARGET_AES __attribute__((target("aes")))
+#endif
+
+namespace nu {
+
+namespace {
+
+// AES-128 has 10 rounds and 11 round keys.
+const int kRounds = 10;
+
+// Number of blocks decrypted in one iteration, CBC decryption has no
+// dependency between blocks so the instructions can be pipelined.
+const size_t kParallelBlocks = 8;
+
+}  // namespace
+
+#if defined(ARCH_CPU_X86_FAMILY)
+
+bool HasHardwareAES() {
+  static const bool has_aes = base::CPU().has_aesni();
+  return has_aes;
+}
+
+NU_TARGET_AES
+void HardwareAESExpandDecryptKey(const uint8_t* round_key, uint8_t* dec_key) {
+  // The equivalent inverse cipher uses the round keys in reverse order, with
+  // InvMixColumns applied to the middle ones.
+  const __m128i* in = reinterpret_cast<const __m128i*>(round_key);
+  __m128i* out = reinterpret_cast<__m128i*>(dec_key);
+  _mm_storeu_si128(out, _mm_loadu_si128(in + kRounds));
+  for (int i = 1; i < kRounds; ++i) {
+    _mm_storeu_si128(out + i,
+                     _mm_aesimc_si128(_mm_loadu_si128(in + kRounds - i)));
+  }
+  _mm_storeu_si128(out + kRounds, _mm_loadu_si128(in));
+}
+
+NU_TARGET_AES
+void HardwareAESCBCDecrypt(const uint8_t* dec_key,
+                           uint8_t* iv,
+                           uint8_t* buf,
+                           size_t len) {
+  DCHECK_EQ(len % 16, 0u);
+  __m128i keys[kRounds + 1];
+  for (int i = 0; i <= kRounds; ++i)
+    keys[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dec_key) + i);
+  __m128i prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iv));
+  __m128i* data = reinterpret_cast<__m128i*>(buf);
+  size_t blocks = len / 16;
+
+  size_t i = 0;
+  for (; i + kParallelBlocks <= blocks; i += kParallelBlocks) {
+    __m128i in[kParallelBlocks];
+    __m128i x[kParallelBlocks];
+    for (size_t j = 0; j < kParallelBlocks; ++j) {
+      in[j] = _mm_loadu_si128(data + i + j);
+      x[j] = _mm_xor_si128(in[j], keys[0]);
+    }
+    for (int r = 1; r < kRounds; ++r) {
+      for (size_t j = 0; j < kParallelBlocks; ++j)
+        x[j] = _mm_aesdec_si128(x[j], keys[r]);
+    }
+    for (size_t j = 0; j < kParallelBlocks; ++j) {
+      x[j] = _mm_aesdeclast_si128(x[j], keys[kRounds]);
+      _mm_storeu_si128(data + i + j,
+                       _mm_xor_si128(x[j], j == 0 ? prev : in[j - 1]));
+    }
+    prev = in[kParallelBlocks - 1];
+  }
+  for (; i < blocks; ++i) {
+    __m128i in = _mm_loadu_si128(data + i);
+    __m128i x = _mm_xor_si128(in, keys[0]);
+    for (int r = 1; r < kRounds; ++r)
+      x = _mm_aesdec_si128(x, keys[r]);
+    x = _mm_aesdeclast_si128(x, keys[kRounds]);
+    _mm_storeu_si128(data + i, _mm_xor_si128(x, prev));
+    prev = in;
+  }
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(iv), prev);
+}
+
+#elif defined(ARCH_CPU_ARM64)
+
+bool HasHardwareAES() {
+#if defined(OS_MAC)
+  return true;
+#elif defined(OS_LINUX)
+  static const bool has_aes = getauxval(AT_HWCAP) & HWCAP_AES;
+  return has_aes;
+#elif defined(OS_WIN)
+  static const bool has_aes =
+      IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE);
+  return has_aes;
+#else
+  return false;
+#endif
+}
+
+NU_TARGET_AES
+void HardwareAESExpandDecryptKey(const uint8_t* round_key, uint8_t* dec_key) {
+  vst1q_u8(dec_key, vld1q_u8(round_key + kRounds * 16));
+  for (int i = 1; i < kRounds; ++i) {
+    vst1q_u8(dec_key + i * 16,
+             vaesimcq_u8(vld1q_u8(round_key + (kRounds - i) * 16)));
+  }
+  vst1q_u8(dec_key + kRounds * 16, vld1q_u8(round_key));
+}
+
+NU_TARGET_AES
+void HardwareAESCBCDecrypt(const uint8_t* dec_key,
+                           uint8_t* iv,
+                           uint8_t* buf,
+                           size_t len) {
+  DCHECK_EQ(len % 16, 0u);
+  uint8x16_t keys[kRounds + 1];
+  for (int i = 0; i <= kRounds; ++i)
+    keys[i] = vld1q_u8(dec_key + i * 16);
+  uint8x16_t prev = vld1q_u8(iv);
+  size_t blocks = len / 16;
+
+  // AESD does AddRoundKey before InvShiftRows and InvSubBytes, so the last
+  // round key is added separately.
+  size_t i = 0;
+  for (; i + kParallelBlocks <= blocks; i += kParallelBlocks) {
+    uint8x16_t in[kParallelBlocks];
+    uint8x16_t x[kParallelBlocks];
+    for (size_t j = 0; j < kParallelBlocks; ++j)
+      x[j] = in[j] = vld1q_u8(buf + (i + j) * 16);
+    for (int r = 0; r < kRounds - 1; ++r) {
+      for (size_t j = 0; j < kParallelBlocks; ++j)
+        x[j] = vaesimcq_u8(vaesdq_u8(x[j], keys[r]));
+    }
+    for (size_t j = 0; j < kParallelBlocks; ++j) {
+      x[j] = veorq_u8(vaesdq_u8(x[j], keys[kRounds - 1]), keys[kRounds]);
+      vst1q_u8(buf + (i + j) * 16,
+               veorq_u8(x[j], j == 0 ? prev : in[j - 1]));
+    }
+    prev = in[kParallelBlocks - 1];
+  }
+  for (; i < blocks; ++i) {
+    uint8x16_t in = vld1q_u8(buf + i * 16);
+    uint8x16_t x = in;
+    for (int r = 0; r < kRounds - 1; ++r)
+      x = vaesimcq_u8(vaesdq_u8(x, keys[r]));
+    x = veorq_u8(vaesdq_u8(x, keys[kRounds - 1]), keys[kRounds]);
+    vst1q_u8(buf + i * 16, veorq_u8(x, prev));
+    prev = in;
+  }
+  vst1q_u8(iv, prev);
+}
+
+#else
+
+bool HasHardwareAES() {
+  return false;
+}
+
+void HardwareAESExpandDecryptKey(const uint8_t* round_key, uint8_t* dec_key) {
+  NOTREACHED();
+}
+
+void HardwareAESCBCDecrypt(const uint8_t* dec_key,
+                           uint8_t* iv,
+                           uint8_t* buf,
+                           size_t len) {
+  NOTREACHED();
+}
+
+#endif
+
+}  // namespace nu
@@ -0,0 +1,32 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_UTIL_AES_HW_H_
+#define NATIVEUI_UTIL_AES_HW_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace nu {
+
+// AES-128 decryption with the AES-NI instructions on x86 and the ARMv8
+// Cryptography Extensions on arm64.
+
+// Return whether current CPU supports the instructions.
+bool HasHardwareAES();
+
+// Compute the round keys used for decryption from the 176 bytes |round_key|
+// of AES-128 key expansion.
+void HardwareAESExpandDecryptKey(const uint8_t* round_key, uint8_t* dec_key);
+
+// Decrypt |buf| of |len| bytes in place with CBC mode, the |len| must be a
+// multiple of 16. The |iv| is updated for the next call.
+void HardwareAESCBCDecrypt(const uint8_t* dec_key,
+                           uint8_t* iv,
+                           uint8_t* buf,
+                           size_t len);
+
+}  // namespace nu
+
+#endif  // NATIVEUI_UTIL_AES_HW_H_
@@ -6,9 +6,12 @@
 #ifndef NATIVEUI_UTIL_FUNCTION_CALLER_H_
 #define NATIVEUI_UTIL_FUNCTION_CALLER_H_
 
+#include <stdint.h>
+
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "base/values.h"
 
@@ -107,6 +110,13 @@ inline void GetArgument(CallContext* context, base::Value* arg, int* value) {
   context->current_arg++;
 }
 
+inline void GetArgument(CallContext* context, base::Value* arg,
+                        std::vector<uint8_t>* value) {
+  if (arg->is_blob())
+    *value = arg->GetBlob();
+  context->current_arg++;
+}
+
 // Class template for extracting and storing single argument for callback
 // at position |index|.
 template<size_t index, typename ArgType>
@@ -0,0 +1,380 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/inflater.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "base/no_destructor.h"
+
+namespace nu {
+
+namespace {
+
+// Size of compressed data pulled from reader at once.
+const size_t kInputSize = 16 * 1024;
+
+// Base lengths and extra bits of length symbols 257..285.
+const uint16_t kLengthBase[29] = {
+    3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+    31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+const uint8_t kLengthExtra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+    2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+
+// Base distances and extra bits of distance symbols 0..29.
+const uint16_t kDistanceBase[30] = {
+    1,    2,    3,    4,    5,    7,     9,     13,    17,  25,
+    33,   49,   65,   97,   129,  193,   257,   385,   513, 769,
+    1025, 1537, 2049, 3073, 4097, 6145,  8193,  12289, 16385, 24577};
+const uint8_t kDistanceExtra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+    6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+// Order of code length code lengths in dynamic block header.
+const uint8_t kCodeLengthOrder[19] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+}  // namespace
+
+Inflater::Inflater(Reader reader)
+    : reader_(std::move(reader)), input_(kInputSize), window_(kWindowSize) {}
+
+Inflater::~Inflater() {}
+
+size_t Inflater::Read(uint8_t* out, size_t size) {
+  size_t pos = 0;
+  while (pos < size) {
+    // Finish the pending back reference first.
+    if (copy_length_ > 0) {
+      size_t n = std::min<size_t>(copy_length_, size - pos);
+      for (size_t i = 0; i < n; ++i) {
+        Emit(window_[(window_pos_ - copy_distance_) & (kWindowSize - 1)],
+             out, &pos);
+      }
+      copy_length_ -= n;
+      continue;
+    }
+
+    switch (state_) {
+      case State::BlockHeader:
+        if (final_block_) {
+          state_ = State::Done;
+          return pos;
+        }
+        if (!ReadBlockHeader())
+          return pos + Fail();
+        break;
+
+      case State::Stored: {
+        if (stored_left_ == 0) {
+          state_ = State::BlockHeader;
+          break;
+        }
+        if (bit_count_ > 0) {
+          // Drain the bytes left in bit buffer.
+          uint32_t byte;
+          if (!GetBits(8, &byte))
+            return pos + Fail();
+          Emit(static_cast<uint8_t>(byte), out, &pos);
+          stored_left_--;
+          break;
+        }
+        if (input_pos_ == input_end_ && !NeedBits(8))
+          return pos + Fail();
+        // NeedBits moved one byte into bit buffer, drain it next time.
+        if (bit_count_ > 0)
+          break;
+        size_t n = std::min<size_t>({stored_left_, size - pos,
+                                     input_end_ - input_pos_});
+        for (size_t i = 0; i < n; ++i)
+          Emit(input_[input_pos_ + i], out, &pos);
+        input_pos_ += n;
+        stored_left_ -= n;
+        break;
+      }
+
+      case State::Huffman: {
+        int symbol;
+        if (!Decode(*length_code_, &symbol))
+          return pos + Fail();
+        if (symbol < 256) {
+          Emit(static_cast<uint8_t>(symbol), out, &pos);
+          break;
+        }
+        if (symbol == 256) {
+          state_ = State::BlockHeader;
+          break;
+        }
+        symbol -= 257;
+        uint32_t extra;
+        if (symbol >= 29 || !GetBits(kLengthExtra[symbol], &extra))
+          return pos + Fail();
+        copy_length_ = kLengthBase[symbol] + extra;
+        if (!Decode(*distance_code_, &symbol) || symbol >= 30 ||
+            !GetBits(kDistanceExtra[symbol], &extra))
+          return pos + Fail();
+        copy_distance_ = kDistanceBase[symbol] + extra;
+        if (copy_distance_ > total_out_)
+          return pos + Fail();
+        break;
+      }
+
+      case State::Done:
+      case State::Failed:
+        return pos;
+    }
+  }
+  return pos;
+}
+
+// static
+bool Inflater::BuildHuffman(Huffman* huffman,
+                            const uint8_t* lengths,
+                            int count) {
+  memset(huffman->count, 0, sizeof(huffman->count));
+  memset(huffman->fast, 0, sizeof(huffman->fast));
+  for (int i = 0; i < count; ++i)
+    huffman->count[lengths[i]]++;
+  if (huffman->count[0] == count)
+    return true;  // no codes, decoding would fail
+
+  // Check for over-subscribed code, incomplete code is allowed and fails
+  // when an unused code is met.
+  int left = 1;
+  for (int len = 1; len < 16; ++len) {
+    left <<= 1;
+    left -= huffman->count[len];
+    if (left < 0)
+      return false;
+  }
+
+  // Sort symbols by code length.
+  uint16_t offsets[16];
+  offsets[1] = 0;
+  for (int len = 1; len < 15; ++len)
+    offsets[len + 1] = offsets[len] + huffman->count[len];
+  for (int i = 0; i < count; ++i) {
+    if (lengths[i] != 0)
+      huffman->symbol[offsets[lengths[i]]++] = i;
+  }
+
+  // Fill lookup table with short codes, codes are read from stream in
+  // reversed bit order.
+  int code = 0;
+  int index = 0;
+  for (int len = 1; len <= Huffman::kFastBits; ++len) {
+    for (int i = 0; i < huffman->count[len]; ++i, ++code, ++index) {
+      int reversed = 0;
+      for (int bit = 0; bit < len; ++bit)
+        reversed |= ((code >> bit) & 1) << (len - 1 - bit);
+      uint16_t entry = (huffman->symbol[index] << 4) | len;
+      for (int fill = reversed; fill < (1 << Huffman::kFastBits);
+           fill += 1 << len)
+        huffman->fast[fill] = entry;
+    }
+    code <<= 1;
+  }
+  return true;
+}
+
+// static
+const Inflater::Huffman& Inflater::GetFixedLengthCode() {
+  static base::NoDestructor<Huffman> huffman([]() {
+    uint8_t lengths[288];
+    memset(lengths, 8, 144);
+    memset(lengths + 144, 9, 112);
+    memset(lengths + 256, 7, 24);
+    memset(lengths + 280, 8, 8);
+    Huffman result;
+    BuildHuffman(&result, lengths, 288);
+    return result;
+  }());
+  return *huffman;
+}
+
+// static
+const Inflater::Huffman& Inflater::GetFixedDistanceCode() {
+  static base::NoDestructor<Huffman> huffman([]() {
+    uint8_t lengths[30];
+    memset(lengths, 5, 30);
+    Huffman result;
+    BuildHuffman(&result, lengths, 30);
+    return result;
+  }());
+  return *huffman;
+}
+
+bool Inflater::NeedBits(int count) {
+  while (bit_count_ < count) {
+    if (input_pos_ == input_end_) {
+      if (input_eof_)
+        return false;
+      input_pos_ = 0;
+      input_end_ = reader_(input_.data(), input_.size());
+      if (input_end_ == 0) {
+        input_eof_ = true;
+        return false;
+      }
+    }
+    bit_buffer_ |= static_cast<uint64_t>(input_[input_pos_++]) << bit_count_;
+    bit_count_ += 8;
+  }
+  return true;
+}
+
+bool Inflater::GetBits(int count, uint32_t* bits) {
+  if (count == 0) {
+    *bits = 0;
+    return true;
+  }
+  if (!NeedBits(count))
+    return false;
+  *bits = static_cast<uint32_t>(bit_buffer_ & ((1ull << count) - 1));
+  bit_buffer_ >>= count;
+  bit_count_ -= count;
+  return true;
+}
+
+bool Inflater::Decode(const Huffman& huffman, int* symbol) {
+  // Try the lookup table first, which fails near the end of stream.
+  if (NeedBits(Huffman::kFastBits)) {
+    uint16_t entry =
+        huffman.fast[bit_buffer_ & ((1 << Huffman::kFastBits) - 1)];
+    if (entry != 0) {
+      int len = entry & 15;
+      bit_buffer_ >>= len;
+      bit_count_ -= len;
+      *symbol = entry >> 4;
+      return true;
+    }
+  }
+
+  // Decode bit by bit.
+  int code = 0;
+  int first = 0;
+  int index = 0;
+  for (int len = 1; len < 16; ++len) {
+    uint32_t bit;
+    if (!GetBits(1, &bit))
+      return false;
+    code |= bit;
+    int count = huffman.count[len];
+    if (code - count < first) {
+      *symbol = huffman.symbol[index + (code - first)];
+      return true;
+    }
+    index += count;
+    first += count;
+    first <<= 1;
+    code <<= 1;
+  }
+  return false;
+}
+
+bool Inflater::ReadBlockHeader() {
+  uint32_t header;
+  if (!GetBits(3, &header))
+    return false;
+  final_block_ = header & 1;
+  switch (header >> 1) {
+    case 0: {
+      // Stored block starts at byte boundary.
+      uint32_t length, complement;
+      if (!GetBits(bit_count_ % 8, &length) ||
+          !GetBits(16, &length) || !GetBits(16, &complement) ||
+          length != (~complement & 0xffff))
+        return false;
+      stored_left_ = length;
+      state_ = State::Stored;
+      return true;
+    }
+    case 1:
+      length_code_ = &GetFixedLengthCode();
+      distance_code_ = &GetFixedDistanceCode();
+      state_ = State::Huffman;
+      return true;
+    case 2:
+      if (!ReadDynamicTables())
+        return false;
+      length_code_ = &dynamic_length_code_;
+      distance_code_ = &dynamic_distance_code_;
+      state_ = State::Huffman;
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool Inflater::ReadDynamicTables() {
+  uint32_t hlit, hdist, hclen;
+  if (!GetBits(5, &hlit) || !GetBits(5, &hdist) || !GetBits(4, &hclen))
+    return false;
+  int length_count = hlit + 257;
+  int distance_count = hdist + 1;
+  if (length_count > 286 || distance_count > 30)
+    return false;
+
+  // Read the code of code lengths.
+  uint8_t lengths[286 + 30] = {0};
+  for (uint32_t i = 0; i < hclen + 4; ++i) {
+    uint32_t len;
+    if (!GetBits(3, &len))
+      return false;
+    lengths[kCodeLengthOrder[i]] = len;
+  }
+  Huffman code_length_code;
+  if (!BuildHuffman(&code_length_code, lengths, 19))
+    return false;
+
+  // Read code lengths of both codes.
+  memset(lengths, 0, sizeof(lengths));
+  int index = 0;
+  while (index < length_count + distance_count) {
+    int symbol;
+    if (!Decode(code_length_code, &symbol))
+      return false;
+    if (symbol < 16) {
+      lengths[index++] = symbol;
+      continue;
+    }
+    uint8_t len = 0;
+    uint32_t repeat;
+    if (symbol == 16) {
+      if (index == 0 || !GetBits(2, &repeat))
+        return false;
+      len = lengths[index - 1];
+      repeat += 3;
+    } else if (symbol == 17) {
+      if (!GetBits(3, &repeat))
+        return false;
+      repeat += 3;
+    } else {
+      if (!GetBits(7, &repeat))
+        return false;
+      repeat += 11;
+    }
+    if (index + repeat > static_cast<uint32_t>(length_count + distance_count))
+      return false;
+    while (repeat--)
+      lengths[index++] = len;
+  }
+
+  // The end of block code must exist.
+  if (lengths[256] == 0)
+    return false;
+  return BuildHuffman(&dynamic_length_code_, lengths, length_count) &&
+         BuildHuffman(&dynamic_distance_code_, lengths + length_count,
+                      distance_count);
+}
+
+size_t Inflater::Fail() {
+  state_ = State::Failed;
+  return 0;
+}
+
+}  // namespace nu
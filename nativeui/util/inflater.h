@@ -0,0 +1,120 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_UTIL_INFLATER_H_
+#define NATIVEUI_UTIL_INFLATER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+#include <vector>
+
+#include "nativeui/nativeui_export.h"
+
+namespace nu {
+
+// Streaming decompressor of raw deflate data as specified in RFC 1951.
+//
+// Compressed data is pulled from the reader when needed, and decompressed
+// data can be read in any size.
+class NATIVEUI_EXPORT Inflater {
+ public:
+  // Read compressed data into |buf|, returns 0 when there is no more data.
+  using Reader = std::function<size_t(uint8_t* buf, size_t size)>;
+
+  explicit Inflater(Reader reader);
+  ~Inflater();
+
+  Inflater& operator=(const Inflater&) = delete;
+  Inflater(const Inflater&) = delete;
+
+  // Decompress up to |size| bytes into |out| and return the bytes written,
+  // which is less than |size| only when the stream ends or fails.
+  size_t Read(uint8_t* out, size_t size);
+
+  bool IsFinished() const { return state_ == State::Done; }
+  bool IsFailed() const { return state_ == State::Failed; }
+
+ private:
+  // Canonical Huffman code.
+  struct Huffman {
+    static constexpr int kFastBits = 9;
+    // Number of codes of each length.
+    uint16_t count[16];
+    // Symbols ordered by code.
+    uint16_t symbol[288];
+    // Lookup table of codes not longer than kFastBits, indexed by the next
+    // bits of stream, each entry is |symbol << 4 | length|, 0 if not found.
+    uint16_t fast[1 << kFastBits];
+  };
+
+  enum class State {
+    BlockHeader,
+    Stored,
+    Huffman,
+    Done,
+    Failed,
+  };
+
+  // Build |huffman| from code lengths of |count| symbols, returns false if
+  // the code is over-subscribed.
+  static bool BuildHuffman(Huffman* huffman,
+                           const uint8_t* lengths,
+                           int count);
+  static const Huffman& GetFixedLengthCode();
+  static const Huffman& GetFixedDistanceCode();
+
+  // Fill bit buffer with at least |count| bits, returns false if there is
+  // not enough input.
+  bool NeedBits(int count);
+  bool GetBits(int count, uint32_t* bits);
+  bool Decode(const Huffman& huffman, int* symbol);
+  bool ReadBlockHeader();
+  bool ReadDynamicTables();
+
+  // Append |byte| to the output and the sliding window.
+  void Emit(uint8_t byte, uint8_t* out, size_t* pos) {
+    out[(*pos)++] = byte;
+    window_[window_pos_++ & (kWindowSize - 1)] = byte;
+    total_out_++;
+  }
+
+  size_t Fail();
+
+  static constexpr size_t kWindowSize = 32768;
+
+  Reader reader_;
+  State state_ = State::BlockHeader;
+  bool final_block_ = false;
+
+  // Buffered input.
+  std::vector<uint8_t> input_;
+  size_t input_pos_ = 0;
+  size_t input_end_ = 0;
+  bool input_eof_ = false;
+  uint64_t bit_buffer_ = 0;
+  int bit_count_ = 0;
+
+  // The last 32KB of output used for back references.
+  std::vector<uint8_t> window_;
+  size_t window_pos_ = 0;
+  uint64_t total_out_ = 0;
+
+  // Bytes left in current stored block.
+  uint32_t stored_left_ = 0;
+  // The back reference being copied.
+  uint32_t copy_length_ = 0;
+  uint32_t copy_distance_ = 0;
+
+  // Codes of current Huffman block, point to static tables for fixed codes.
+  const Huffman* length_code_ = nullptr;
+  const Huffman* distance_code_ = nullptr;
+  Huffman dynamic_length_code_;
+  Huffman dynamic_distance_code_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_UTIL_INFLATER_H_
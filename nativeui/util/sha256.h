@@ -0,0 +1,40 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_UTIL_SHA256_H_
+#define NATIVEUI_UTIL_SHA256_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "nativeui/nativeui_export.h"
+
+#define SHA256_LENGTH 32
+
+namespace nu {
+
+// Incremental SHA-256 as specified in FIPS 180-4.
+class NATIVEUI_EXPORT SHA256 {
+ public:
+  SHA256();
+
+  void Update(const void* data, size_t size);
+  // Write the digest to |out|, the object can not be updated afterwards.
+  void Finish(uint8_t out[SHA256_LENGTH]);
+
+  // Compute the digest of |data| in one call.
+  static void Hash(const void* data, size_t size, uint8_t out[SHA256_LENGTH]);
+
+ private:
+  void Transform(const uint8_t block[64]);
+
+  uint32_t state_[8];
+  uint64_t length_ = 0;
+  uint8_t buffer_[64];
+  size_t buffer_size_ = 0;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_UTIL_SHA256_H_
@@ -0,0 +1,116 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/task_queue.h"
+
+#include <memory>
+#include <utility>
+
+namespace nu {
+
+namespace {
+
+// Reading the clock for every task is wasteful when tasks are tiny, check the
+// budget after every batch of tasks instead.
+const int kBatchSize = 32;
+
+}  // namespace
+
+TaskQueue::MpscQueue::MpscQueue() : head_(&stub_), tail_(&stub_) {}
+
+TaskQueue::MpscQueue::~MpscQueue() {
+  while (Node* node = Pop())
+    delete node;
+}
+
+void TaskQueue::MpscQueue::Push(Node* node) {
+  // Count the node before linking it, so the consumer can tell a producer is
+  // in the middle of pushing.
+  size_.fetch_add(1, std::memory_order_release);
+  PushNode(node);
+}
+
+TaskQueue::MpscQueue::Node* TaskQueue::MpscQueue::Pop() {
+  Node* tail = tail_;
+  Node* next = tail->next.load(std::memory_order_acquire);
+  if (tail == &stub_) {
+    if (!next)
+      return nullptr;
+    tail_ = next;
+    tail = next;
+    next = next->next.load(std::memory_order_acquire);
+  }
+  if (!next) {
+    // The |tail| is the last node, put the stub back so it can be popped.
+    if (tail != head_.load(std::memory_order_acquire))
+      return nullptr;  // a producer is linking a new node
+    PushNode(&stub_);
+    next = tail->next.load(std::memory_order_acquire);
+    if (!next)
+      return nullptr;
+  }
+  tail_ = next;
+  size_.fetch_sub(1, std::memory_order_release);
+  return tail;
+}
+
+void TaskQueue::MpscQueue::PushNode(Node* node) {
+  node->next.store(nullptr, std::memory_order_relaxed);
+  Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+  prev->next.store(node, std::memory_order_release);
+}
+
+TaskQueue::TaskQueue(std::function<void(Priority)> wakeup)
+    : wakeup_(std::move(wakeup)) {
+  for (auto& scheduled : scheduled_)
+    scheduled.store(false, std::memory_order_relaxed);
+}
+
+TaskQueue::~TaskQueue() {}
+
+void TaskQueue::Push(Priority priority, Task task) {
+  int i = static_cast<int>(priority);
+  auto* node = new MpscQueue::Node;
+  node->task = std::move(task);
+  queues_[i].Push(node);
+  if (!scheduled_[i].exchange(true, std::memory_order_acq_rel))
+    wakeup_(priority);
+}
+
+bool TaskQueue::RunTasks(Priority priority, base::TimeDelta budget) {
+  int lowest = static_cast<int>(priority);
+  // Clear the flags before popping, so tasks pushed from now on will wake up
+  // the platform again.
+  for (int i = 0; i <= lowest; ++i)
+    scheduled_[i].store(false, std::memory_order_release);
+
+  base::TimeTicks deadline = base::TimeTicks::Now() + budget;
+  int count = 0;
+  while (true) {
+    // Always re-check higher priorities, as running a task may post new ones.
+    MpscQueue::Node* node = nullptr;
+    for (int i = 0; i <= lowest && !node; ++i)
+      node = queues_[i].Pop();
+    if (!node)
+      break;
+    std::unique_ptr<MpscQueue::Node> owned(node);
+    owned->task();
+    if (++count % kBatchSize == 0 && base::TimeTicks::Now() >= deadline)
+      break;
+  }
+
+  // Reschedule the queues that still have tasks, which happens when running
+  // out of budget or when a producer is in the middle of pushing.
+  bool has_pending_tasks = false;
+  for (int i = 0; i <= lowest; ++i) {
+    if (queues_[i].size() == 0)
+      continue;
+    has_pending_tasks = true;
+    if (!scheduled_[i].exchange(true, std::memory_order_acq_rel))
+      wakeup_(static_cast<Priority>(i));
+  }
+  return has_pending_tasks;
+}
+
+}  // namespace nu
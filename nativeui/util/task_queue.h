@@ -0,0 +1,84 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_UTIL_TASK_QUEUE_H_
+#define NATIVEUI_UTIL_TASK_QUEUE_H_
+
+#include <atomic>
+#include <functional>
+
+#include "base/time/time.h"
+#include "nativeui/message_loop.h"
+
+namespace nu {
+
+// The queue of tasks posted to the GUI thread.
+//
+// Tasks can be pushed from any thread without locking, and are run in batches
+// by the GUI thread. There is one queue for each priority, and the platform
+// is only woken up once for tasks pushed before the queue is drained.
+class TaskQueue {
+ public:
+  using Task = MessageLoop::Task;
+  using Priority = MessageLoop::Priority;
+
+  static constexpr int kPriorityCount = static_cast<int>(Priority::Idle) + 1;
+
+  // The |wakeup| is called with the priority of pushed task when the platform
+  // should schedule a call to RunTasks, it may be called from any thread.
+  explicit TaskQueue(std::function<void(Priority)> wakeup);
+  ~TaskQueue();
+
+  TaskQueue& operator=(const TaskQueue&) = delete;
+  TaskQueue(const TaskQueue&) = delete;
+
+  // Thread-safe.
+  void Push(Priority priority, Task task);
+
+  // Run tasks of |priority| and higher priorities, until the queues are empty
+  // or the |budget| has been used. Returns true if there are tasks left.
+  //
+  // Must be called on the GUI thread.
+  bool RunTasks(Priority priority, base::TimeDelta budget);
+
+ private:
+  // Intrusive multi-producer single-consumer queue, based on Dmitry Vyukov's
+  // algorithm.
+  class MpscQueue {
+   public:
+    struct Node {
+      std::atomic<Node*> next{nullptr};
+      Task task;
+    };
+
+    MpscQueue();
+    ~MpscQueue();
+
+    // Called from any thread.
+    void Push(Node* node);
+    // Called from the consumer thread. Returns nullptr if empty, or when a
+    // producer is in the middle of pushing, in which case |size()| is still
+    // larger than 0.
+    Node* Pop();
+
+    size_t size() const { return size_.load(std::memory_order_acquire); }
+
+   private:
+    void PushNode(Node* node);
+
+    std::atomic<Node*> head_;
+    Node* tail_;
+    Node stub_;
+    std::atomic<size_t> size_{0};
+  };
+
+  std::function<void(Priority)> wakeup_;
+
+  MpscQueue queues_[kPriorityCount];
+  std::atomic<bool> scheduled_[kPriorityCount];
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_UTIL_TASK_QUEUE_H_
@@ -0,0 +1,158 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/timer_wheel.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "base/bits.h"
+
+namespace nu {
+
+namespace {
+
+inline uint64_t SlotBit(int slot) {
+  return static_cast<uint64_t>(1) << slot;
+}
+
+// Bits of slots after |slot|, or including |slot| when |inclusive|.
+inline uint64_t SlotsAfter(uint64_t bits, int slot, bool inclusive) {
+  int first = inclusive ? slot : slot + 1;
+  if (first >= 64)
+    return 0;
+  return bits & (~static_cast<uint64_t>(0) << first);
+}
+
+}  // namespace
+
+TimerWheel::TimerWheel(int64_t now) : current_(now) {}
+
+TimerWheel::~TimerWheel() {}
+
+void TimerWheel::Add(TimerId id, int64_t deadline, int64_t tolerance) {
+  Remove(id);
+  Timer& timer = timers_[id];
+  timer.deadline = AlignDeadline(deadline, tolerance);
+  Insert(id, &timer);
+}
+
+bool TimerWheel::Remove(TimerId id) {
+  auto it = timers_.find(id);
+  if (it == timers_.end())
+    return false;
+  Unlink(it->second);
+  timers_.erase(it);
+  return true;
+}
+
+void TimerWheel::Advance(int64_t now, std::vector<TimerId>* expired) {
+  while (current_ <= now) {
+    int slot = static_cast<int>(current_ & kSlotMask);
+    if (occupied_[0] & SlotBit(slot)) {
+      // Timers in a level 0 slot all expire at current tick.
+      for (TimerId id : slots_[0][slot]) {
+        expired->push_back(id);
+        timers_.erase(id);
+      }
+      slots_[0][slot].clear();
+      occupied_[0] &= ~SlotBit(slot);
+    }
+    // Skip empty ticks, but stop at the start of next round to cascade timers
+    // from upper levels.
+    int64_t next = (current_ | kSlotMask) + 1;
+    uint64_t rest = SlotsAfter(occupied_[0], slot, false);
+    if (rest)
+      next = (current_ & ~kSlotMask) + base::bits::CountTrailingZeroBits(rest);
+    current_ = std::min(next, now + 1);
+    if ((current_ & kSlotMask) == 0)
+      Cascade(1);
+  }
+}
+
+int64_t TimerWheel::GetNextWakeup() const {
+  if (timers_.empty())
+    return -1;
+  int64_t result = std::numeric_limits<int64_t>::max();
+  for (int level = 0; level < kLevels; ++level) {
+    uint64_t bits = occupied_[level];
+    if (!bits)
+      continue;
+    int shift = kSlotBits * level;
+    int round_shift = shift + kSlotBits;
+    int index = static_cast<int>((current_ >> shift) & kSlotMask);
+    int64_t round_start = (current_ >> round_shift) << round_shift;
+    // The current slot of upper levels has been cascaded, so timers in it
+    // belong to next round.
+    uint64_t after = SlotsAfter(bits, index, level == 0);
+    int64_t time;
+    if (after) {
+      time = round_start +
+             (static_cast<int64_t>(base::bits::CountTrailingZeroBits(after))
+                  << shift);
+    } else {
+      time = round_start + (static_cast<int64_t>(1) << round_shift) +
+             (static_cast<int64_t>(base::bits::CountTrailingZeroBits(bits))
+                  << shift);
+    }
+    result = std::min(result, time);
+  }
+  return result;
+}
+
+// static
+int64_t TimerWheel::AlignDeadline(int64_t deadline, int64_t tolerance) {
+  if (tolerance <= 0)
+    return deadline;
+  // Round up to a multiple of the largest power of 2 within tolerance, so
+  // timers with close deadlines land on the same tick.
+  int64_t granularity = 1;
+  while (granularity * 2 <= tolerance)
+    granularity *= 2;
+  return (deadline + granularity - 1) & ~(granularity - 1);
+}
+
+void TimerWheel::Insert(TimerId id, Timer* timer) {
+  int64_t deadline = std::max(timer->deadline, current_);
+  int64_t delta = deadline - current_;
+  int level = 0;
+  while (level < kLevels - 1 &&
+         delta >= (static_cast<int64_t>(1) << (kSlotBits * (level + 1))))
+    ++level;
+  // Timers beyond the range of wheel are put at the end, and will be inserted
+  // again when cascaded.
+  int64_t max_delta = (static_cast<int64_t>(1) << (kSlotBits * kLevels)) - 1;
+  if (delta > max_delta)
+    deadline = current_ + max_delta;
+  int slot = static_cast<int>((deadline >> (kSlotBits * level)) & kSlotMask);
+  std::list<TimerId>& list = slots_[level][slot];
+  timer->level = level;
+  timer->slot = slot;
+  timer->it = list.insert(list.end(), id);
+  occupied_[level] |= SlotBit(slot);
+}
+
+void TimerWheel::Unlink(const Timer& timer) {
+  std::list<TimerId>& list = slots_[timer.level][timer.slot];
+  list.erase(timer.it);
+  if (list.empty())
+    occupied_[timer.level] &= ~SlotBit(timer.slot);
+}
+
+void TimerWheel::Cascade(int level) {
+  for (; level < kLevels; ++level) {
+    int slot = static_cast<int>(
+        (current_ >> (kSlotBits * level)) & kSlotMask);
+    std::list<TimerId> list;
+    list.swap(slots_[level][slot]);
+    occupied_[level] &= ~SlotBit(slot);
+    for (TimerId id : list)
+      Insert(id, &timers_[id]);
+    // Upper level only moves when this level starts a new round.
+    if (slot != 0)
+      break;
+  }
+}
+
+}  // namespace nu
@@ -0,0 +1,87 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_UTIL_TIMER_WHEEL_H_
+#define NATIVEUI_UTIL_TIMER_WHEEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "nativeui/nativeui_export.h"
+
+namespace nu {
+
+// Hierarchical timer wheel with millisecond ticks.
+//
+// Adding and removing timers are O(1), and finding the nearest deadline only
+// looks at one bitmap per level, so thousands of timers can be driven by a
+// single native timer. The wheel only stores IDs, the owner is responsible
+// for storing the tasks and for thread-safety.
+class NATIVEUI_EXPORT TimerWheel {
+ public:
+  using TimerId = uint32_t;
+
+  // Start the wheel at |now|, times are in milliseconds of a monotonic clock.
+  explicit TimerWheel(int64_t now);
+  ~TimerWheel();
+
+  TimerWheel& operator=(const TimerWheel&) = delete;
+  TimerWheel(const TimerWheel&) = delete;
+
+  // Add a timer expiring at |deadline|. With a positive |tolerance| the timer
+  // may fire up to |tolerance| late, which is used for aligning the deadline
+  // so timers with similar deadlines fire together.
+  void Add(TimerId id, int64_t deadline, int64_t tolerance = 0);
+
+  // Return false if the timer does not exist or has already expired.
+  bool Remove(TimerId id);
+
+  // Move the wheel to |now| and append expired timers to |expired|, timers
+  // with earlier deadlines come first.
+  void Advance(int64_t now, std::vector<TimerId>* expired);
+
+  // Return the time when the wheel should be advanced next, which may be
+  // earlier than the nearest deadline when timers need to be moved between
+  // levels. Returns -1 if there is no timer.
+  int64_t GetNextWakeup() const;
+
+  size_t size() const { return timers_.size(); }
+  bool empty() const { return timers_.empty(); }
+
+  // Return the deadline after applying |tolerance|.
+  static int64_t AlignDeadline(int64_t deadline, int64_t tolerance);
+
+ private:
+  static constexpr int kLevels = 4;
+  static constexpr int kSlotBits = 6;
+  static constexpr int kSlots = 1 << kSlotBits;
+  static constexpr int64_t kSlotMask = kSlots - 1;
+
+  struct Timer {
+    int64_t deadline;
+    int level;
+    int slot;
+    std::list<TimerId>::iterator it;
+  };
+
+  void Insert(TimerId id, Timer* timer);
+  void Unlink(const Timer& timer);
+  void Cascade(int level);
+
+  // The next tick to be processed, all timers before it have expired.
+  int64_t current_;
+
+  std::unordered_map<TimerId, Timer> timers_;
+  std::list<TimerId> slots_[kLevels][kSlots];
+  // Bitmap of non-empty slots for each level.
+  uint64_t occupied_[kLevels] = {0};
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_UTIL_TIMER_WHEEL_H_
@@ -0,0 +1,144 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/trace_event.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/json/json_writer.h"
+#include "base/no_destructor.h"
+#include "base/process/process_handle.h"
+#include "base/values.h"
+
+namespace nu {
+
+namespace {
+
+// Depth of nested ScopedFrameEvent on current thread.
+thread_local int g_frame_depth = 0;
+
+}  // namespace
+
+// static
+std::atomic<bool> TraceLog::enabled_{false};
+
+// static
+TraceLog* TraceLog::GetInstance() {
+  static base::NoDestructor<TraceLog> instance;
+  return instance.get();
+}
+
+TraceLog::TraceLog() {}
+
+TraceLog::~TraceLog() {}
+
+void TraceLog::Start(size_t capacity) {
+  base::AutoLock auto_lock(lock_);
+  events_.clear();
+  events_.reserve(std::min<size_t>(capacity, 4096));
+  capacity_ = std::max<size_t>(capacity, 1);
+  next_ = 0;
+  frame_stats_ = FrameStats();
+  enabled_.store(true, std::memory_order_relaxed);
+}
+
+std::string TraceLog::Stop() {
+  std::vector<Event> events;
+  size_t next;
+  {
+    base::AutoLock auto_lock(lock_);
+    enabled_.store(false, std::memory_order_relaxed);
+    events.swap(events_);
+    next = next_;
+    next_ = 0;
+  }
+
+  base::Value::List list;
+  base::ProcessId pid = base::GetCurrentProcId();
+  // Events are stored in a ring, the oldest one is at |next|.
+  for (size_t i = 0; i < events.size(); ++i) {
+    const Event& event = events[(next + i) % events.size()];
+    base::Value::Dict dict;
+    dict.Set("name", event.name);
+    dict.Set("cat", event.category);
+    dict.Set("ph", "X");
+    dict.Set("ts", static_cast<double>(
+        (event.start - base::TimeTicks()).InMicroseconds()));
+    dict.Set("dur", static_cast<double>(event.duration.InMicroseconds()));
+    dict.Set("pid", static_cast<int>(pid));
+    dict.Set("tid", static_cast<int>(event.thread_id));
+    list.Append(std::move(dict));
+  }
+  base::Value::Dict trace;
+  trace.Set("traceEvents", std::move(list));
+  trace.Set("displayTimeUnit", "ms");
+  base::Value::Dict metadata;
+  metadata.Set("frame-events",
+               "Events in the frame category are durations of painting "
+               "windows, not intervals between frames.");
+  trace.Set("metadata", std::move(metadata));
+  std::string json;
+  base::JSONWriter::Write(trace, &json);
+  return json;
+}
+
+void TraceLog::AddCompleteEvent(const char* category,
+                                const char* name,
+                                base::TimeTicks start,
+                                base::TimeDelta duration) {
+  Event event = {category, name, start, duration,
+                 base::PlatformThread::CurrentId()};
+  base::AutoLock auto_lock(lock_);
+  // Tracing might have been stopped when the scope began.
+  if (!IsEnabled())
+    return;
+  if (events_.size() < capacity_) {
+    events_.push_back(event);
+  } else {
+    events_[next_] = event;
+    next_ = (next_ + 1) % capacity_;
+  }
+}
+
+void TraceLog::AddFrame(base::TimeDelta duration) {
+  int ms = static_cast<int>(duration.InMilliseconds());
+  size_t bucket = 0;
+  while (bucket < kFrameBucketCount - 1 && ms >= kFrameBuckets[bucket])
+    ++bucket;
+  base::AutoLock auto_lock(lock_);
+  if (!IsEnabled())
+    return;
+  frame_stats_.count++;
+  frame_stats_.total += duration;
+  frame_stats_.max = std::max(frame_stats_.max, duration);
+  frame_stats_.histogram[bucket]++;
+}
+
+TraceLog::FrameStats TraceLog::GetFrameStats() {
+  base::AutoLock auto_lock(lock_);
+  return frame_stats_;
+}
+
+ScopedFrameEvent::ScopedFrameEvent(const char* name) {
+  if (!TraceLog::IsEnabled())
+    return;
+  name_ = name;
+  is_outermost_ = g_frame_depth++ == 0;
+  start_ = base::TimeTicks::Now();
+}
+
+ScopedFrameEvent::~ScopedFrameEvent() {
+  if (!name_)
+    return;
+  g_frame_depth--;
+  base::TimeDelta duration = base::TimeTicks::Now() - start_;
+  TraceLog* trace_log = TraceLog::GetInstance();
+  trace_log->AddCompleteEvent(is_outermost_ ? "frame" : "paint",
+                              name_, start_, duration);
+  if (is_outermost_)
+    trace_log->AddFrame(duration);
+}
+
+}  // namespace nu
@@ -0,0 +1,142 @@
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_UTIL_TRACE_EVENT_H_
+#define NATIVEUI_UTIL_TRACE_EVENT_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "base/synchronization/lock.h"
+#include "base/threading/platform_thread.h"
+#include "base/time/time.h"
+#include "nativeui/nativeui_export.h"
+
+// Record the time spent in current scope, the |category| and |name| must be
+// string literals.
+//
+// When tracing is not started the only cost is a relaxed atomic load.
+#define NU_TRACE_EVENT(category, name) \
+  nu::ScopedTraceEvent NU_TRACE_UID(nu_trace_event_)(category, name)
+
+// Record the time spent on painting a window, which is counted as a frame if
+// this is the outermost painting on current thread. Note that the duration is
+// how long the painting takes, not the interval between frames.
+#define NU_TRACE_FRAME(name) \
+  nu::ScopedFrameEvent NU_TRACE_UID(nu_trace_frame_)(name)
+
+#define NU_TRACE_UID(prefix) NU_TRACE_UID2(prefix, __LINE__)
+#define NU_TRACE_UID2(prefix, line) NU_TRACE_UID3(prefix, line)
+#define NU_TRACE_UID3(prefix, line) prefix##line
+
+namespace nu {
+
+// Stores trace events in a ring buffer, which can be exported in the Trace
+// Event Format used by chrome://tracing and Perfetto.
+class NATIVEUI_EXPORT TraceLog {
+ public:
+  // Upper bounds of frame paint duration histogram buckets in milliseconds,
+  // the last bucket holds all longer frames.
+  static constexpr int kFrameBuckets[] = {4, 8, 12, 16, 24, 33, 50, 100};
+  static constexpr size_t kFrameBucketCount = std::size(kFrameBuckets) + 1;
+
+  struct FrameStats {
+    int count = 0;
+    base::TimeDelta total;
+    base::TimeDelta max;
+    int histogram[kFrameBucketCount] = {0};
+  };
+
+  static TraceLog* GetInstance();
+
+  static bool IsEnabled() {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  TraceLog& operator=(const TraceLog&) = delete;
+  TraceLog(const TraceLog&) = delete;
+
+  // Clear recorded data and start recording, when more than |capacity|
+  // events are recorded the oldest ones are dropped.
+  void Start(size_t capacity = 100000);
+
+  // Stop recording and return the events in JSON.
+  std::string Stop();
+
+  void AddCompleteEvent(const char* category,
+                        const char* name,
+                        base::TimeTicks start,
+                        base::TimeDelta duration);
+  void AddFrame(base::TimeDelta duration);
+
+  FrameStats GetFrameStats();
+
+ private:
+  struct Event {
+    const char* category;
+    const char* name;
+    base::TimeTicks start;
+    base::TimeDelta duration;
+    base::PlatformThreadId thread_id;
+  };
+
+  TraceLog();
+  ~TraceLog();
+
+  static std::atomic<bool> enabled_;
+
+  base::Lock lock_;
+  std::vector<Event> events_;
+  size_t capacity_ = 0;
+  // Index of the oldest event once the buffer is full.
+  size_t next_ = 0;
+  FrameStats frame_stats_;
+};
+
+class ScopedTraceEvent {
+ public:
+  ScopedTraceEvent(const char* category, const char* name) {
+    if (TraceLog::IsEnabled()) {
+      category_ = category;
+      name_ = name;
+      start_ = base::TimeTicks::Now();
+    }
+  }
+
+  ~ScopedTraceEvent() {
+    if (category_)
+      TraceLog::GetInstance()->AddCompleteEvent(
+          category_, name_, start_, base::TimeTicks::Now() - start_);
+  }
+
+  ScopedTraceEvent& operator=(const ScopedTraceEvent&) = delete;
+  ScopedTraceEvent(const ScopedTraceEvent&) = delete;
+
+ private:
+  const char* category_ = nullptr;
+  const char* name_ = nullptr;
+  base::TimeTicks start_;
+};
+
+class NATIVEUI_EXPORT ScopedFrameEvent {
+ public:
+  explicit ScopedFrameEvent(const char* name);
+  ~ScopedFrameEvent();
+
+  ScopedFrameEvent& operator=(const ScopedFrameEvent&) = delete;
+  ScopedFrameEvent(const ScopedFrameEvent&) = delete;
+
+ private:
+  const char* name_ = nullptr;
+  bool is_outermost_ = false;
+  base::TimeTicks start_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_UTIL_TRACE_EVENT_H_
@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
 #include "nativeui/container.h"
 #include "nativeui/cursor.h"
 #include "nativeui/gfx/font.h"
@@ -24,6 +25,24 @@ namespace nu {
 
 namespace {
 
+void AppendPerfCounters(const View* view, int indent, std::string* result) {
+  View::PerfCounters counters = view->GetPerfCounters();
+  RectF bounds = view->GetBounds();
+  base::StringAppendF(result,
+                      "%*s%s (%g, %g, %g, %g) layouts=%d measures=%d "
+                      "bounds=%d paints=%d paint_time=%.2fms\n",
+                      indent * 2, "", view->GetClassName(),
+                      bounds.x(), bounds.y(), bounds.width(), bounds.height(),
+                      counters.layout_count, counters.measure_count,
+                      counters.set_bounds_count, counters.paint_count,
+                      counters.paint_time);
+  if (!view->IsContainer())
+    return;
+  auto* container = static_cast<const Container*>(view);
+  for (int i = 0; i < container->ChildCount(); ++i)
+    AppendPerfCounters(container->ChildAt(i), indent + 1, result);
+}
+
 // Convert case to lower and remove non-ASCII characters.
 std::string ParseName(const std::string& name) {
   std::string parsed;
@@ -162,6 +181,36 @@ std::string View::GetComputedLayout() const {
   return result;
 }
 
+// static
+bool View::perf_counters_enabled_ = false;
+
+// static
+void View::SetPerfCountersEnabled(bool enabled) {
+  perf_counters_enabled_ = enabled;
+}
+
+View::PerfCounters View::GetPerfCounters() const {
+  return perf_counters_ ? *perf_counters_ : PerfCounters();
+}
+
+void View::ResetPerfCounters() {
+  perf_counters_.reset();
+}
+
+std::string View::DumpPerfCounters() const {
+  std::string result;
+  AppendPerfCounters(this, 0, &result);
+  return result;
+}
+
+void View::RecordPaint(base::TimeTicks start) {
+  PerfCounters* counters = perf_counters();
+  if (!counters || start.is_null())
+    return;
+  counters->paint_count++;
+  counters->paint_time += (base::TimeTicks::Now() - start).InMillisecondsF();
+}
+
 SizeF View::GetMinimumSize() const {
   return SizeF();
 }
@@ -6,10 +6,12 @@
 #define NATIVEUI_VIEW_H_
 
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
+#include "base/time/time.h"
 #include "nativeui/clipboard.h"
 #include "nativeui/dragging_info.h"
 #include "nativeui/gfx/color.h"
@@ -129,6 +131,36 @@ class NATIVEUI_EXPORT View : public Responder {
   // Return the string representation of yoga style.
   std::string GetComputedLayout() const;
 
+  // Counters of expensive operations, only collected when enabled.
+  struct PerfCounters {
+    int layout_count = 0;
+    int measure_count = 0;
+    int set_bounds_count = 0;
+    int paint_count = 0;
+    // In milliseconds.
+    float paint_time = 0;
+  };
+  static void SetPerfCountersEnabled(bool enabled);
+  static bool IsPerfCountersEnabled() { return perf_counters_enabled_; }
+  PerfCounters GetPerfCounters() const;
+  void ResetPerfCounters();
+
+  // Return the counters of the view and its children as a tree.
+  std::string DumpPerfCounters() const;
+
+  // Internal: Return the counters to update, or nullptr when disabled.
+  PerfCounters* perf_counters() {
+    if (!perf_counters_enabled_)
+      return nullptr;
+    if (!perf_counters_)
+      perf_counters_ = std::make_unique<PerfCounters>();
+    return perf_counters_.get();
+  }
+
+  // Internal: Record a custom paint that started at |start|, should only be
+  // called when on_draw is emitted.
+  void RecordPaint(base::TimeTicks start);
+
   // Return the minimum size of view.
   virtual SizeF GetMinimumSize() const;
 
@@ -244,6 +276,10 @@ class NATIVEUI_EXPORT View : public Responder {
 
   // The node recording CSS styles.
   YGNodeRef node_;
+
+  // Allocated when counters are updated for the first time.
+  static bool perf_counters_enabled_;
+  std::unique_ptr<PerfCounters> perf_counters_;
 };
 
 }  // namespace nu
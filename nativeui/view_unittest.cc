@@ -3,8 +3,21 @@
 // LICENSE file.
 
 #include "nativeui/nativeui.h"
+#include "nativeui/test/event_util.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
+namespace {
+
+// Run the message loop until the end of current frame.
+void WaitForFrameEnd() {
+  nu::MessageLoop::PostDelayedTask(100, []() {
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+}
+
+}  // namespace
+
 class ViewTest : public testing::Test {
  protected:
   void SetUp() override {
@@ -90,3 +103,106 @@ TEST_F(ViewTest, OnSizeChanged) {
   window->SetContentSize(nu::SizeF(100, 100));
   EXPECT_TRUE(changed);
 }
+
+TEST_F(ViewTest, PerfCounters) {
+  view_->SetBounds(nu::RectF(0, 0, 100, 100));
+  EXPECT_EQ(view_->GetPerfCounters().set_bounds_count, 0);
+
+  nu::View::SetPerfCountersEnabled(true);
+  scoped_refptr<nu::Window> window(new nu::Window(nu::Window::Options()));
+  scoped_refptr<nu::Container> container(new nu::Container);
+  window->SetContentView(container.get());
+  window->SetContentSize(nu::SizeF(200, 200));
+  container->AddChildView(view_.get());
+  EXPECT_GT(container->GetPerfCounters().layout_count, 0);
+  EXPECT_GT(view_->GetPerfCounters().set_bounds_count, 0);
+  EXPECT_GT(view_->GetPerfCounters().measure_count, 0);
+
+  std::string dump = container->DumpPerfCounters();
+  EXPECT_EQ(dump.find("Container"), 0u);
+  EXPECT_NE(dump.find("\n  Label"), std::string::npos);
+
+  view_->ResetPerfCounters();
+  EXPECT_EQ(view_->GetPerfCounters().set_bounds_count, 0);
+  nu::View::SetPerfCountersEnabled(false);
+}
+
+TEST_F(ViewTest, PerfCountersPaint) {
+  nu::View::SetPerfCountersEnabled(true);
+  scoped_refptr<nu::Window> window(new nu::Window(nu::Window::Options()));
+  scoped_refptr<nu::Container> container(new nu::Container);
+  bool painted = false;
+  container->on_draw.Connect([&painted](nu::Container*, nu::Painter*,
+                                        const nu::RectF&) {
+    painted = true;
+  });
+  scoped_refptr<nu::Container> child(new nu::Container);
+  child->SetStyle("flex", 1);
+  container->AddChildView(child.get());
+  window->SetContentView(container.get());
+  window->SetContentSize(nu::SizeF(200, 200));
+  window->SetVisible(true);
+  WaitForFrameEnd();
+  ASSERT_TRUE(painted);
+  EXPECT_GT(container->GetPerfCounters().paint_count, 0);
+  EXPECT_GE(container->GetPerfCounters().paint_time, 0);
+  // Views without on_draw handlers are not custom painted.
+  EXPECT_EQ(child->GetPerfCounters().paint_count, 0);
+  nu::View::SetPerfCountersEnabled(false);
+}
+
+TEST_F(ViewTest, CoalesceMouseMoveEvents) {
+  std::vector<float> moves;
+  view_->on_mouse_move.Connect([&moves](nu::Responder*,
+                                        const nu::MouseEvent& event) {
+    moves.push_back(event.position_in_view.x());
+  });
+  view_->SetEventCoalescing(nu::Responder::EventCoalescing::Frame);
+  // The first event is delivered immediately, and the rest are merged into
+  // the latest one at the end of frame.
+  for (int i = 1; i <= 5; ++i)
+    nu::DispatchMouseMove(view_.get(), nu::PointF(i, 1));
+  ASSERT_EQ(moves.size(), 1u);
+  EXPECT_EQ(moves[0], 1);
+  WaitForFrameEnd();
+  ASSERT_EQ(moves.size(), 2u);
+  EXPECT_EQ(moves[1], 5);
+}
+
+TEST_F(ViewTest, GetCoalescedEvents) {
+  std::vector<std::vector<float>> merged;
+  view_->on_mouse_move.Connect([&merged](nu::Responder* responder,
+                                         const nu::MouseEvent&) {
+    std::vector<float> moves;
+    for (const nu::MouseEvent& event : responder->GetCoalescedEvents())
+      moves.push_back(event.position_in_view.x());
+    merged.push_back(std::move(moves));
+  });
+  view_->SetEventCoalescing(nu::Responder::EventCoalescing::Frame);
+  view_->SetKeepCoalescedEvents(true);
+  for (int i = 1; i <= 4; ++i)
+    nu::DispatchMouseMove(view_.get(), nu::PointF(i, 1));
+  WaitForFrameEnd();
+  ASSERT_EQ(merged.size(), 2u);
+  EXPECT_EQ(merged[0], std::vector<float>({1}));
+  EXPECT_EQ(merged[1], std::vector<float>({2, 3, 4}));
+  // The events are only kept during the handler.
+  EXPECT_TRUE(view_->GetCoalescedEvents().empty());
+}
+
+TEST_F(ViewTest, DisableEventCoalescingFlushesPendingEvent) {
+  std::vector<float> moves;
+  view_->on_mouse_move.Connect([&moves](nu::Responder*,
+                                        const nu::MouseEvent& event) {
+    moves.push_back(event.position_in_view.x());
+  });
+  view_->SetEventCoalescing(nu::Responder::EventCoalescing::Frame);
+  for (int i = 1; i <= 3; ++i)
+    nu::DispatchMouseMove(view_.get(), nu::PointF(i, 1));
+  view_->SetEventCoalescing(nu::Responder::EventCoalescing::None);
+  ASSERT_EQ(moves.size(), 2u);
+  EXPECT_EQ(moves[1], 3);
+  // Nothing is delivered at the end of frame.
+  WaitForFrameEnd();
+  EXPECT_EQ(moves.size(), 2u);
+}
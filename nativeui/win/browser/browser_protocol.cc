@@ -103,7 +103,8 @@ IFACEMETHODIMP BrowserProtocol::Read(void *pv, ULONG cb, ULONG *pcbRead) {
   size_t nread = protocol_job_->Read(pv, cb);
   *pcbRead = static_cast<ULONG>(nread);
   if (nread == 0) {
-    sink_->ReportResult(S_OK, 0, NULL);
+    sink_->ReportResult(
+        protocol_job_->IsFailed() ? INET_E_DOWNLOAD_FAILURE : S_OK, 0, NULL);
     return S_FALSE;
   }
   return S_OK;
@@ -290,13 +290,17 @@ void Browser::PlatformUpdateBindings() {
 }
 
 // static
-bool Browser::RegisterProtocol(const std::string& scheme,
-                               ProtocolHandler handler) {
+bool Browser::PlatformRegisterProtocol(const std::string& scheme,
+                                       ProtocolHandler handler,
+                                       bool thread_safe) {
+  // The IE protocol must be started synchronously on the GUI thread, so the
+  // |thread_safe| only takes effect for WebView2.
 #if defined(WEBVIEW2_SUPPORT)
   std::wstring wscheme = base::UTF8ToWide(scheme);
   return BrowserImplIE::RegisterProtocol(wscheme, handler) &
          BrowserImplWebview2::RegisterProtocol(std::move(wscheme),
-                                               std::move(handler));
+                                               std::move(handler),
+                                               thread_safe);
 #else
   return BrowserImplIE::RegisterProtocol(base::UTF8ToWide(scheme),
                                          std::move(handler));
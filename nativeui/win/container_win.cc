@@ -7,6 +7,7 @@
 #include "base/stl_util.h"
 #include "nativeui/events/win/event_win.h"
 #include "nativeui/gfx/win/painter_win.h"
+#include "nativeui/util/trace_event.h"
 
 namespace nu {
 
@@ -244,12 +245,17 @@ class ContainerAdapter : public ContainerImpl,
   void OnDraw(PainterWin* painter, const Rect& dirty) override {
     if (container_->on_draw.IsEmpty())
       return;
+    base::TimeTicks paint_start;
+    if (View::IsPerfCountersEnabled())
+      paint_start = base::TimeTicks::Now();
     painter->Save();
     painter->ClipRectPixel(Rect(size_allocation().size()));
     float scale_factor = container_->GetNative()->scale_factor();
+    NU_TRACE_EVENT("paint", "on_draw");
     container_->on_draw.Emit(container_, static_cast<Painter*>(painter),
                              ScaleRect(RectF(dirty), 1.0f / scale_factor));
     painter->Restore();
+    container_->RecordPaint(paint_start);
   }
 
  private:
@@ -27,7 +27,12 @@ void MessageLoop::Quit() {
 
 // static
 void MessageLoop::PostTask(Task task) {
-  PostDelayedTask(USER_TIMER_MINIMUM, std::move(task));
+  PostTaskWithPriority(Priority::Input, std::move(task));
+}
+
+// static
+void MessageLoop::PostTaskWithPriority(Priority priority, Task task) {
+  State::GetMain()->GetTimerHost()->PostTask(priority, std::move(task));
 }
 
 // static
@@ -40,11 +45,25 @@ void MessageLoop::SetTimer(int ms, RepeatedTask task) {
   State::GetMain()->GetTimerHost()->SetInterval(ms, std::move(task));
 }
 
+// static
+void MessageLoop::SetTimerWithTolerance(int ms, int tolerance,
+                                        RepeatedTask task) {
+  State::GetMain()->GetTimerHost()->SetInterval(ms, std::move(task),
+                                                tolerance);
+}
+
 // static
 UINT_PTR MessageLoop::SetTimeout(int ms, Task task) {
   return State::GetMain()->GetTimerHost()->SetTimeout(ms, std::move(task));
 }
 
+// static
+UINT_PTR MessageLoop::SetTimeoutWithTolerance(int ms, int tolerance,
+                                              Task task) {
+  return State::GetMain()->GetTimerHost()->SetTimeout(ms, std::move(task),
+                                                      tolerance);
+}
+
 // static
 void MessageLoop::ClearTimeout(TimerId id) {
   State::GetMain()->GetTimerHost()->ClearTimeout(id);
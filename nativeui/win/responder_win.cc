@@ -22,7 +22,7 @@ void ResponderImpl::EmitMouseMoveEvent(NativeEvent event) {
   if (!delegate() || delegate()->on_mouse_move.IsEmpty())
     return;
   event->w_param = 0;
-  delegate()->on_mouse_move.Emit(delegate(), MouseEvent(event, this));
+  delegate()->DispatchMouseMove(MouseEvent(event, this));
 }
 
 void ResponderImpl::EmitMouseEnterEvent(NativeEvent event) {
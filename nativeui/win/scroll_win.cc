@@ -165,7 +165,7 @@ bool ScrollImpl::UpdateOrigin(Vector2d new_origin) {
   if (new_origin == origin_)
     return false;
   origin_ = new_origin;
-  delegate_->on_scroll.Emit(delegate_);
+  delegate_->DispatchScroll();
   return true;
 }
 
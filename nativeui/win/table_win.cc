@@ -486,16 +486,40 @@ std::set<int> Table::GetSelectedRows() const {
   return rows;
 }
 
-void Table::NotifyRowInsertion(uint32_t row) {
+void Table::NotifyRowsInsertion(uint32_t start, uint32_t count) {
   auto* table = static_cast<TableImpl*>(GetNative());
+  // The virtual list view keeps selection by index, shift the selected rows
+  // after the inserted ones.
+  std::set<int> selection;
+  for (int row : GetSelectedRows())
+    selection.insert(row < static_cast<int>(start) ? row : row + count);
   ListView_SetItemCountEx(table->hwnd(), GetModel()->GetRowCount(),
                           LVSICF_NOINVALIDATEALL | LVSICF_NOSCROLL);
+  if (!selection.empty())
+    SelectRows(std::move(selection));
 }
 
-void Table::NotifyRowDeletion(uint32_t row) {
+void Table::NotifyRowsDeletion(uint32_t start, uint32_t count) {
   auto* table = static_cast<TableImpl*>(GetNative());
+  // Remove the deleted rows from selection and shift the rows after them.
+  std::set<int> selection;
+  bool changed = false;
+  for (int row : GetSelectedRows()) {
+    if (row < static_cast<int>(start))
+      selection.insert(row);
+    else if (row >= static_cast<int>(start + count))
+      selection.insert(row - count);
+    changed = changed || row >= static_cast<int>(start);
+  }
   ListView_SetItemCountEx(table->hwnd(), GetModel()->GetRowCount(),
                           LVSICF_NOINVALIDATEALL | LVSICF_NOSCROLL);
+  if (changed)
+    SelectRows(std::move(selection));
+}
+
+void Table::NotifyRowsChange(uint32_t start, uint32_t count) {
+  auto* table = static_cast<TableImpl*>(GetNative());
+  ListView_RedrawItems(table->hwnd(), start, start + count - 1);
 }
 
 void Table::NotifyValueChange(uint32_t column, uint32_t row) {
@@ -503,4 +527,10 @@ void Table::NotifyValueChange(uint32_t column, uint32_t row) {
   ListView_Update(table->hwnd(), row);
 }
 
+void Table::NotifyReset() {
+  auto* table = static_cast<TableImpl*>(GetNative());
+  ListView_SetItemState(table->hwnd(), -1, 0, LVIS_SELECTED);
+  ListView_SetItemCountEx(table->hwnd(), GetModel()->GetRowCount(), 0);
+}
+
 }  // namespace nu
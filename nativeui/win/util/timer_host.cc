@@ -6,16 +6,31 @@
 
 #include <utility>
 
+#include "base/auto_reset.h"
+
 namespace nu {
 
-TimerHost::TimerHost() {}
+namespace {
+
+// Leave time for input events and painting when there are lots of tasks.
+constexpr base::TimeDelta kTaskBudget = base::Milliseconds(8);
+
+// Timer used for resuming tasks that have run out of budget, which does not
+// conflict with the IDs returned by NextTimerId.
+const UINT_PTR kRunTasksTimerId = static_cast<UINT_PTR>(-1);
+
+}  // namespace
+
+TimerHost::TimerHost()
+    : thread_id_(::GetCurrentThreadId()),
+      task_queue_([this](MessageLoop::Priority) { ScheduleRunTasks(); }) {}
 
 TimerHost::~TimerHost() {}
 
-TimerHost::TimerId TimerHost::SetTimeout(int ms, Task task) {
+TimerHost::TimerId TimerHost::SetTimeout(int ms, Task task, int tolerance) {
   base::AutoLock auto_lock(lock_);
   TimerId id = NextTimerId();
-  if (::SetTimer(hwnd(), id, ms, nullptr))
+  if (StartTimer(id, ms, tolerance))
     timeouts_[id] = std::move(task);
   return id;
 }
@@ -26,10 +41,11 @@ void TimerHost::ClearTimeout(TimerId id) {
     ::KillTimer(hwnd(), id);
 }
 
-TimerHost::TimerId TimerHost::SetInterval(int ms, RepeatedTask task) {
+TimerHost::TimerId TimerHost::SetInterval(int ms, RepeatedTask task,
+                                          int tolerance) {
   base::AutoLock auto_lock(lock_);
   TimerId id = NextTimerId();
-  if (::SetTimer(hwnd(), id, ms, nullptr))
+  if (StartTimer(id, ms, tolerance))
     intervals_[id] = std::move(task);
   return id;
 }
@@ -40,7 +56,16 @@ void TimerHost::ClearInterval(TimerId id) {
     ::KillTimer(hwnd(), id);
 }
 
+void TimerHost::PostTask(MessageLoop::Priority priority, Task task) {
+  task_queue_.Push(priority, std::move(task));
+}
+
 void TimerHost::OnTimer(UINT_PTR id) {
+  if (id == kRunTasksTimerId) {
+    ::KillTimer(hwnd(), id);
+    RunTasks();
+    return;
+  }
   // First search for timeouts.
   Task task;
   {
@@ -71,8 +96,34 @@ void TimerHost::OnTimer(UINT_PTR id) {
   }
 }
 
+LRESULT TimerHost::OnRunTasks(UINT message, WPARAM w_param, LPARAM l_param) {
+  RunTasks();
+  return 0;
+}
+
 UINT_PTR TimerHost::NextTimerId() {
   return static_cast<UINT_PTR>(++next_timer_id_);
 }
 
+bool TimerHost::StartTimer(TimerId id, int ms, int tolerance) {
+  if (tolerance > 0)
+    return ::SetCoalescableTimer(hwnd(), id, ms, nullptr, tolerance) != 0;
+  return ::SetTimer(hwnd(), id, ms, nullptr) != 0;
+}
+
+void TimerHost::ScheduleRunTasks() {
+  if (::GetCurrentThreadId() == thread_id_ && is_running_tasks_) {
+    // Tasks left after running out of budget, posted messages are retrieved
+    // before input messages so resume with a low priority timer instead.
+    ::SetTimer(hwnd(), kRunTasksTimerId, USER_TIMER_MINIMUM, nullptr);
+  } else {
+    ::PostMessage(hwnd(), kRunTasksMessage, 0, 0);
+  }
+}
+
+void TimerHost::RunTasks() {
+  base::AutoReset<bool> auto_reset(&is_running_tasks_, true);
+  task_queue_.RunTasks(MessageLoop::Priority::Idle, kTaskBudget);
+}
+
 }  // namespace nu
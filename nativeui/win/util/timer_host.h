@@ -9,6 +9,7 @@
 #include <map>
 
 #include "base/synchronization/lock.h"
+#include "nativeui/util/task_queue.h"
 #include "nativeui/win/util/win32_window.h"
 
 namespace nu {
@@ -19,23 +20,39 @@ class TimerHost : public Win32Window {
   using RepeatedTask = std::function<bool()>;
   using TimerId = UINT_PTR;
 
+  // Posted to the host to run tasks in the queue.
+  static const UINT kRunTasksMessage = WM_APP + 1;
+
   TimerHost();
   ~TimerHost() override;
 
-  TimerId SetTimeout(int ms, Task task);
+  // A positive |tolerance| creates coalescable timers.
+  TimerId SetTimeout(int ms, Task task, int tolerance = 0);
   void ClearTimeout(TimerId id);
-  TimerId SetInterval(int ms, RepeatedTask task);
+  TimerId SetInterval(int ms, RepeatedTask task, int tolerance = 0);
   void ClearInterval(TimerId id);
 
+  // Thread-safe.
+  void PostTask(MessageLoop::Priority priority, Task task);
+
  protected:
   CR_BEGIN_MSG_MAP_EX(TimerHost, Win32Window)
     CR_MSG_WM_TIMER(OnTimer)
+    CR_MESSAGE_HANDLER_EX(kRunTasksMessage, OnRunTasks)
   CR_END_MSG_MAP()
 
   void OnTimer(UINT_PTR id);
+  LRESULT OnRunTasks(UINT message, WPARAM w_param, LPARAM l_param);
 
  private:
   UINT_PTR NextTimerId();
+  bool StartTimer(TimerId id, int ms, int tolerance);
+  void ScheduleRunTasks();
+  void RunTasks();
+
+  const DWORD thread_id_;
+  bool is_running_tasks_ = false;
+  TaskQueue task_queue_;
 
   // The unique timer ID we will assign to the next timer.
   UINT next_timer_id_ = 0;
@@ -412,6 +412,8 @@ RectF View::GetBoundsInScreen() const {
 }
 
 void View::SetPixelBounds(const Rect& bounds) {
+  if (PerfCounters* counters = perf_counters())
+    counters->set_bounds_count++;
   Rect size_allocation(bounds);
   if (GetParent()) {
     size_allocation +=
@@ -32,8 +32,13 @@ namespace nu {
 
 namespace {
 
+struct ProtocolEntry {
+  Browser::ProtocolHandler handler;
+  bool thread_safe = false;
+};
+
 // Stores the protocol factories.
-using ProtocolHandlerMap = std::map<std::wstring, Browser::ProtocolHandler>;
+using ProtocolHandlerMap = std::map<std::wstring, ProtocolEntry>;
 ProtocolHandlerMap& GetProtocolHandlers() {
   static base::NoDestructor<ProtocolHandlerMap> handlers;
   return *handlers;
@@ -74,8 +79,10 @@ Microsoft::WRL::ComPtr<CoreWebView2EnvironmentOptions> GetWebView2Options() {
 
 // static
 bool BrowserImplWebview2::RegisterProtocol(std::wstring scheme,
-                                           Browser::ProtocolHandler handler) {
-  GetProtocolHandlers().emplace(std::move(scheme), std::move(handler));
+                                           Browser::ProtocolHandler handler,
+                                           bool thread_safe) {
+  GetProtocolHandlers().emplace(std::move(scheme),
+                                ProtocolEntry{std::move(handler), thread_safe});
   return true;
 }
 
@@ -620,37 +627,39 @@ HRESULT BrowserImplWebview2::OnWebResourceRequested(
     // Get handler.
     auto it = GetProtocolHandlers().find(scheme);
     if (it != GetProtocolHandlers().end()) {
-      // Invoke handler.
-      scoped_refptr<ProtocolJob> job = it->second(base::WideToUTF8(url));
-      if (job) {
-        // Sending response is async.
-        Microsoft::WRL::ComPtr<ICoreWebView2Deferral> deferral;
-        args->GetDeferral(&deferral);
-        // Start protocol job.
-        // Note that job is passed as raw ptr, passing scoped_refptr would
-        // cause a circular reference.
-        job->Plug([this, args, deferral, job = job.get()](int size) {
-          // Create header.
-          std::string mime_type;
-          job->GetMimeType(&mime_type);
-          std::string header = base::StringPrintf(
-              "Content-Type: %s\nContent-Length:%d\n",
-              mime_type.c_str(), size);
-          // Create stream and pass it as response.
-          Microsoft::WRL::ComPtr<BrowserProtocolStream> protocol_stream(
-              new BrowserProtocolStream(job));
-          Microsoft::WRL::ComPtr<ICoreWebView2WebResourceResponse> response;
-          env_->CreateWebResourceResponse(
-              protocol_stream.Get(), 200, L"OK",
-              base::UTF8ToWide(header).c_str(), &response);
-          args->put_Response(response.Get());
-          deferral->Complete();
-        });
-        if (job->Start())
-          return S_OK;
-        // Failed to start, fallback to error.
-        deferral->Complete();
-      }
+      // Sending response is async, the job may be created and started in
+      // the thread pool.
+      Microsoft::WRL::ComPtr<ICoreWebView2Deferral> deferral;
+      args->GetDeferral(&deferral);
+      Microsoft::WRL::ComPtr<ICoreWebView2WebResourceRequestedEventArgs>
+          args_ref(args);
+      Microsoft::WRL::ComPtr<ICoreWebView2Environment> env = env_;
+      StartProtocolJob(
+          it->second.handler, it->second.thread_safe, base::WideToUTF8(url),
+          [args_ref, deferral, env](scoped_refptr<ProtocolJob> job,
+                                    int size) {
+            Microsoft::WRL::ComPtr<ICoreWebView2WebResourceResponse> response;
+            if (job) {
+              // Create header.
+              std::string mime_type;
+              job->GetMimeType(&mime_type);
+              std::string header = base::StringPrintf(
+                  "Content-Type: %s\nContent-Length:%d\n",
+                  mime_type.c_str(), size);
+              // Create stream and pass it as response.
+              Microsoft::WRL::ComPtr<BrowserProtocolStream> protocol_stream(
+                  new BrowserProtocolStream(job));
+              env->CreateWebResourceResponse(
+                  protocol_stream.Get(), 200, L"OK",
+                  base::UTF8ToWide(header).c_str(), &response);
+            } else {
+              env->CreateWebResourceResponse(nullptr, 500, L"Bad Request",
+                                             L"", &response);
+            }
+            args_ref->put_Response(response.Get());
+            deferral->Complete();
+          });
+      return S_OK;
     }
   }
   // Return error.
@@ -20,7 +20,8 @@ namespace nu {
 class BrowserImplWebview2 : public BrowserImpl {
  public:
   static bool RegisterProtocol(std::wstring scheme,
-                               Browser::ProtocolHandler handler);
+                               Browser::ProtocolHandler handler,
+                               bool thread_safe);
   static void UnregisterProtocol(const std::wstring& scheme);
 
   BrowserImplWebview2(Browser::Options options, BrowserHolder* holder);
@@ -41,6 +41,8 @@ STDMETHODIMP_(ULONG) BrowserProtocolStream::Release() {
 
 IFACEMETHODIMP BrowserProtocolStream::Read(void* pv, ULONG cb, ULONG* pcbRead) {
   *pcbRead = protocol_job_->Read(pv, cb);
+  if (*pcbRead == 0 && protocol_job_->IsFailed())
+    return STG_E_READFAULT;
   return S_OK;
 }
 
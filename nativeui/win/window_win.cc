@@ -31,6 +31,7 @@
 #include "nativeui/menu_bar.h"
 #include "nativeui/screen.h"
 #include "nativeui/state.h"
+#include "nativeui/util/trace_event.h"
 #include "nativeui/win/drag_drop/clipboard_util.h"
 #include "nativeui/win/drag_drop/data_object.h"
 #include "nativeui/win/menu_base_win.h"
@@ -494,6 +495,7 @@ void WindowImpl::OnChar(UINT ch, UINT repeat, UINT flags) {
 }
 
 void WindowImpl::OnPaint(HDC) {
+  NU_TRACE_FRAME("WindowImpl::OnPaint");
   PAINTSTRUCT ps;
   BeginPaint(hwnd(), &ps);
 
@@ -0,0 +1,32 @@
+#!/usr/bin/env node
+
+// Copyright 2026 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+// Build and run benchmarks, results are written to out/Release/*.json.
+
+const {argv, targetOs, execSync} = require('./common')
+
+const path = require('path')
+
+const outDir = argv.find((arg) => arg.startsWith('out')) || 'out/Release'
+const benchmarks = ['nativeui_benchmarks', 'lua_yue_benchmarks']
+
+execSync(`node ./scripts/build.js ${outDir} ${benchmarks.join(' ')}`)
+
+// GTK needs a display.
+const prefix = targetOs == 'linux' && !process.env.DISPLAY ? 'xvfb-run -a ' : ''
+for (const benchmark of benchmarks) {
+  const result = path.join(outDir, `${benchmark}.json`)
+  execSync(`${prefix}${path.join(outDir, benchmark)} --benchmark_out=${result}`)
+}
+
+// Node bindings are only measured when the module has been built.
+try {
+  require.resolve(path.resolve(outDir, 'gui.node'))
+} catch (error) {
+  process.exit(0)
+}
+const result = path.join(outDir, 'napi_yue_benchmarks.json')
+execSync(`${prefix}node napi_yue/test/benchmarks.js ${outDir} ${result}`)